@@ -0,0 +1,147 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include "bench_common.h"
+
+using bench::Mesh;
+
+static void BM_Insert(benchmark::State &state) {
+  const int n = state.range(0);
+  const auto faces = bench::grid_faces(n);
+  for (auto _ : state) {
+    std::unique_ptr<Mesh> F(new Mesh);
+    for (std::size_t i = 0; i < faces.size(); i += 3) {
+      F->insert({faces[i], faces[i + 1], faces[i + 2]});
+    }
+    state.PauseTiming();
+    F.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * faces.size() / 3);
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_Insert)->Apply(bench::grid_sizes)->Unit(benchmark::kMillisecond);
+
+static void BM_BulkInsert(benchmark::State &state) {
+  const int n = state.range(0);
+  const auto faces = bench::grid_faces(n);
+  for (auto _ : state) {
+    std::unique_ptr<Mesh> F(new Mesh);
+    F->bulk_insert<3>(faces.data(), faces.size() / 3);
+    state.PauseTiming();
+    F.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * faces.size() / 3);
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_BulkInsert)
+    ->Apply(bench::grid_sizes)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_RemoveVertices(benchmark::State &state) {
+  const int n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<Mesh> F(new Mesh);
+    bench::build_grid(*F, n);
+    state.ResumeTiming();
+    for (int key = 0; key < n * n; ++key) {
+      F->remove({key});
+    }
+    state.PauseTiming();
+    F.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_RemoveVertices)
+    ->Apply(bench::grid_sizes)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_GetSimplexUp(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  std::vector<std::array<int, 2>> names;
+  for (auto e : bench::sample<2>(F, bench::max_queries)) {
+    names.push_back(F.get_name(e));
+  }
+  for (auto _ : state) {
+    for (const auto &name : names) {
+      benchmark::DoNotOptimize(F.get_simplex_up(name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_GetSimplexUp)->Apply(bench::grid_sizes);
+
+static void BM_GetSimplexDown(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  const auto faces = bench::sample<3>(F, bench::max_queries);
+  for (auto _ : state) {
+    for (auto f : faces) {
+      for (auto key : F.get_name(f)) {
+        benchmark::DoNotOptimize(F.get_simplex_down(f, key));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * faces.size() * 3);
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_GetSimplexDown)->Apply(bench::grid_sizes);
+
+static void BM_Up(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  const auto vertices = bench::sample<1>(F, bench::max_queries);
+  std::vector<Mesh::SimplexID<2>> edges;
+  for (auto _ : state) {
+    for (auto v : vertices) {
+      edges.clear();
+      F.up(v, std::back_inserter(edges));
+      benchmark::DoNotOptimize(edges.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * vertices.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_Up)->Apply(bench::grid_sizes);
+
+static void BM_Down(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  const auto faces = bench::sample<3>(F, bench::max_queries);
+  std::vector<Mesh::SimplexID<2>> edges;
+  for (auto _ : state) {
+    for (auto f : faces) {
+      edges.clear();
+      F.down(f, std::back_inserter(edges));
+      benchmark::DoNotOptimize(edges.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * faces.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_Down)->Apply(bench::grid_sizes);
@@ -0,0 +1,106 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include "bench_common.h"
+
+using bench::Mesh;
+
+/// Places the new vertex at the first merged vertex.
+template <typename Complex> struct KeepFirst {
+  using SimplexSet = typename casc::SimplexSet<Complex>;
+  using KeyType = typename Complex::KeyType;
+
+  template <std::size_t k>
+  typename Complex::template NodeData<k>
+  operator()(Complex &, const std::array<KeyType, k> &,
+             const SimplexSet &merged) {
+    return *(*casc::get<k>(merged).begin());
+  }
+
+  bench::Point operator()(Complex &, const std::array<KeyType, 1> &,
+                          const SimplexSet &merged) {
+    return *(*casc::get<1>(merged).begin());
+  }
+};
+
+/// Squared length of an edge.
+static double edge_length(Mesh &F, Mesh::SimplexID<2> e) {
+  auto name = F.get_name(e);
+  const bench::Point &a = *F.get_simplex_up({name[0]});
+  const bench::Point &b = *F.get_simplex_up({name[1]});
+  double d = 0;
+  for (std::size_t i = 0; i < 3; ++i) {
+    d += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return d;
+}
+
+static void BM_DecimateByCost(benchmark::State &state) {
+  const int n = state.range(0);
+  std::size_t collapsed = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<Mesh> F(new Mesh);
+    bench::build_grid(*F, n);
+    state.ResumeTiming();
+    collapsed += casc::decimate_by_cost(*F, F->size<3>() / 2, edge_length,
+                                        KeepFirst<Mesh>());
+    state.PauseTiming();
+    F.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(collapsed);
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_DecimateByCost)
+    ->Apply(bench::small_grid_sizes)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_DecimateLoop(benchmark::State &state) {
+  const int n = state.range(0);
+  std::size_t collapsed = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<Mesh> F(new Mesh);
+    bench::build_grid(*F, n);
+    // Every third interior row edge, which never share a vertex
+    std::vector<std::array<int, 2>> names;
+    for (int i = 1; i + 1 < n; ++i) {
+      for (int j = 1; j + 2 < n; j += 3) {
+        names.push_back({{i * n + j, i * n + j + 1}});
+      }
+    }
+    state.ResumeTiming();
+    casc::decimation_context<Mesh> ctx;
+    for (const auto &name : names) {
+      auto s = F->get_simplex_up(name);
+      if (s != nullptr) {
+        casc::decimate(*F, s, KeepFirst<Mesh>(), ctx);
+        ++collapsed;
+      }
+    }
+    state.PauseTiming();
+    F.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(collapsed);
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_DecimateLoop)
+    ->Apply(bench::small_grid_sizes)
+    ->Unit(benchmark::kMillisecond);
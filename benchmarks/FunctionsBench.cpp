@@ -0,0 +1,72 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include "bench_common.h"
+
+using bench::Mesh;
+
+static void BM_GetStar(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  auto vertices = bench::sample<1>(F, bench::max_queries);
+  for (auto _ : state) {
+    for (auto &v : vertices) {
+      casc::SimplexSet<Mesh> star;
+      casc::getStar(F, v, star);
+      benchmark::DoNotOptimize(star.size<3>());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * vertices.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_GetStar)->Apply(bench::grid_sizes);
+
+static void BM_GetClosure(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  auto faces = bench::sample<3>(F, bench::max_queries);
+  for (auto _ : state) {
+    for (auto &f : faces) {
+      casc::SimplexSet<Mesh> closure;
+      casc::getClosure(F, f, closure);
+      benchmark::DoNotOptimize(closure.size<1>());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * faces.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_GetClosure)->Apply(bench::grid_sizes);
+
+static void BM_GetLink(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  auto vertices = bench::sample<1>(F, bench::max_queries);
+  for (auto _ : state) {
+    for (auto &v : vertices) {
+      casc::SimplexSet<Mesh> link;
+      casc::getLink(F, v, link);
+      benchmark::DoNotOptimize(link.size<1>());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * vertices.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_GetLink)->Apply(bench::grid_sizes);
@@ -0,0 +1,97 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "bench_common.h"
+
+using bench::Mesh;
+
+/// Load one of the sample meshes of the surfacemesh example.
+static void BM_LoadOFFFile(benchmark::State &state, const char *name) {
+  const std::string path = std::string(CASC_BENCH_DATA_DIR) + "/" + name;
+  std::ifstream fin(path, std::ios::binary);
+  if (!fin) {
+    state.SkipWithError(("Could not open " + path).c_str());
+    return;
+  }
+  const std::string text((std::istreambuf_iterator<char>(fin)),
+                         std::istreambuf_iterator<char>());
+  std::size_t simplices = 0;
+  for (auto _ : state) {
+    std::istringstream in(text);
+    auto F = bench::read_off(in);
+    if (F == nullptr) {
+      state.SkipWithError(("Could not parse " + path).c_str());
+      return;
+    }
+    simplices = F->size<1>() + F->size<2>() + F->size<3>();
+    state.PauseTiming();
+    F.reset();
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.counters["simplices"] = simplices;
+}
+BENCHMARK_CAPTURE(BM_LoadOFFFile, socket, "socket.off")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadOFFFile, mctet, "mctet.off")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadOFFFile, face_based_decimated,
+                  "face_based_decimated.off")
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LoadOFF(benchmark::State &state) {
+  const int n = state.range(0);
+  std::string text;
+  {
+    Mesh F;
+    bench::build_grid(F, n);
+    std::ostringstream out;
+    bench::write_off(out, F);
+    text = out.str();
+  }
+  for (auto _ : state) {
+    std::istringstream in(text);
+    auto F = bench::read_off(in);
+    benchmark::DoNotOptimize(F.get());
+    state.PauseTiming();
+    F.reset();
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_LoadOFF)->Apply(bench::grid_sizes)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveOFF(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    std::ostringstream out;
+    bench::write_off(out, F);
+    bytes += out.tellp();
+  }
+  state.SetBytesProcessed(bytes);
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_SaveOFF)->Apply(bench::grid_sizes)->Unit(benchmark::kMillisecond);
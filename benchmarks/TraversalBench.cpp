@@ -0,0 +1,99 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include "bench_common.h"
+
+using bench::Mesh;
+
+/// Visitor which counts the simplices visited.
+struct CountVisitor {
+  std::size_t count = 0;
+
+  template <std::size_t k> bool visit(Mesh &, Mesh::SimplexID<k>) {
+    ++count;
+    return true;
+  }
+};
+
+static void BM_VisitBFSUp(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  const auto vertices = bench::sample<1>(F, bench::max_queries);
+  for (auto _ : state) {
+    CountVisitor v;
+    for (auto s : vertices) {
+      casc::visit_BFS_up(v, F, s);
+    }
+    benchmark::DoNotOptimize(v.count);
+  }
+  state.SetItemsProcessed(state.iterations() * vertices.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_VisitBFSUp)->Apply(bench::grid_sizes);
+
+static void BM_VisitBFSDown(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  const auto faces = bench::sample<3>(F, bench::max_queries);
+  for (auto _ : state) {
+    CountVisitor v;
+    for (auto s : faces) {
+      casc::visit_BFS_down(v, F, s);
+    }
+    benchmark::DoNotOptimize(v.count);
+  }
+  state.SetItemsProcessed(state.iterations() * faces.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_VisitBFSDown)->Apply(bench::grid_sizes);
+
+static void BM_KNeighbors(benchmark::State &state) {
+  const int n = state.range(0);
+  const std::size_t ring = state.range(1);
+  Mesh F;
+  bench::build_grid(F, n);
+  const auto vertices = bench::sample<1>(F, bench::max_queries);
+  std::vector<Mesh::SimplexID<1>> nbors;
+  for (auto _ : state) {
+    for (auto s : vertices) {
+      casc::kneighbors_up(F, s, ring, nbors);
+      benchmark::DoNotOptimize(nbors.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * vertices.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_KNeighbors)
+    ->ArgsProduct({benchmark::CreateRange(16, 1024, 4), {1, 2, 4}});
+
+static void BM_KNeighborsBatch(benchmark::State &state) {
+  const int n = state.range(0);
+  Mesh F;
+  bench::build_grid(F, n);
+  const auto vertices = bench::sample<1>(F, bench::max_queries);
+  casc::neighbor_lists<Mesh::SimplexID<1>> out;
+  for (auto _ : state) {
+    casc::kneighbors_up_batch(F, vertices, 2, out);
+    benchmark::DoNotOptimize(out.size());
+  }
+  state.SetItemsProcessed(state.iterations() * vertices.size());
+  state.counters["simplices"] = bench::grid_simplices(n);
+}
+BENCHMARK(BM_KNeighborsBatch)->Apply(bench::grid_sizes);
@@ -0,0 +1,190 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  bench_common.h
+ * @brief Meshes and helpers shared by the benchmarks.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <casc/casc>
+
+namespace bench {
+/// Vertex coordinates
+using Point = std::array<double, 3>;
+
+/// Triangle surface mesh with coordinates on the vertices.
+using Mesh = casc::AbstractSimplicialComplex<int,   // KeyType
+                                             int,   // Root data
+                                             Point, // Vertex data
+                                             int,   // Edge data
+                                             int    // Face data
+                                             >;
+
+/**
+ * @brief      Keys of the triangles of an n by n grid of vertices.
+ *
+ * The grid has n^2 vertices, 3(n-1)^2 + 2(n-1) edges and 2(n-1)^2 faces.
+ *
+ * @param[in]  n     Number of vertices along a side.
+ *
+ * @return     Three keys per triangle.
+ */
+inline std::vector<int> grid_faces(int n) {
+  std::vector<int> faces;
+  faces.reserve(6 * (n - 1) * (n - 1));
+  for (int i = 0; i + 1 < n; ++i) {
+    for (int j = 0; j + 1 < n; ++j) {
+      const int a = i * n + j;
+      faces.insert(faces.end(), {a, a + 1, a + n + 1, a, a + n, a + n + 1});
+    }
+  }
+  return faces;
+}
+
+/// Fill a mesh with an n by n grid of unit spaced vertices.
+inline void build_grid(Mesh &F, int n) {
+  std::vector<int> keys(n * n);
+  std::vector<Point> points(n * n);
+  for (int i = 0; i < n * n; ++i) {
+    keys[i] = i;
+    points[i] = Point{{double(i / n), double(i % n), 0.0}};
+  }
+  F.bulk_insert<1>(keys.data(), keys.size(), points.data());
+  auto faces = grid_faces(n);
+  F.bulk_insert<3>(faces.data(), faces.size() / 3);
+}
+
+/// Grid sizes from about 10^3 to 10^7 simplices.
+inline void grid_sizes(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(4)->Range(16, 1024);
+}
+
+/// Grid sizes up to about 10^6 simplices for the slower operations.
+inline void small_grid_sizes(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(4)->Range(16, 256);
+}
+
+/// Largest number of simplices queried per iteration.
+constexpr std::size_t max_queries = 1 << 14;
+
+/// Number of simplices, excluding the root, of an n by n grid.
+inline std::size_t grid_simplices(int n) {
+  const std::size_t m = n - 1;
+  return std::size_t(n) * n + 3 * m * m + 2 * m + 2 * m * m;
+}
+
+/// Take at most `count` evenly spaced elements of a level.
+template <std::size_t k>
+std::vector<Mesh::SimplexID<k>> sample(Mesh &F, std::size_t count) {
+  std::vector<Mesh::SimplexID<k>> all;
+  for (auto s : F.get_level_id<k>()) {
+    all.push_back(s);
+  }
+  if (all.size() <= count) {
+    return all;
+  }
+  std::vector<Mesh::SimplexID<k>> rval;
+  const std::size_t stride = all.size() / count;
+  for (std::size_t i = 0; i < all.size() && rval.size() < count;
+       i += stride) {
+    rval.push_back(all[i]);
+  }
+  return rval;
+}
+
+/**
+ * @brief      Read a triangle mesh in the OFF format.
+ *
+ * Only plain OFF headers are supported. Face colors are ignored.
+ *
+ * @param      in    Stream to read from.
+ *
+ * @return     The mesh or nullptr if the stream could not be parsed.
+ */
+inline std::unique_ptr<Mesh> read_off(std::istream &in) {
+  std::unique_ptr<Mesh> F(new Mesh);
+  casc::textio::buffered_reader reader(in);
+  char header[32];
+  const std::size_t len = reader.read_word(header, sizeof(header));
+  int nv, nf;
+  if (len != 3 || std::strcmp(header, "OFF") != 0 ||
+      !reader.read_integer(nv) || !reader.read_integer(nf)) {
+    return nullptr;
+  }
+  reader.skip_line();
+
+  std::vector<int> keys(nv);
+  std::vector<Point> points(nv);
+  for (int i = 0; i < nv; ++i) {
+    for (auto &x : points[i]) {
+      if (!reader.read_real(x)) {
+        return nullptr;
+      }
+    }
+    reader.skip_line();
+    keys[i] = i;
+  }
+  F->bulk_insert<1>(keys.data(), keys.size(), points.data());
+
+  keys.resize(3 * nf);
+  for (int i = 0; i < nf; ++i) {
+    int n;
+    if (!reader.read_integer(n) || n != 3 ||
+        !reader.read_integer(keys[3 * i]) ||
+        !reader.read_integer(keys[3 * i + 1]) ||
+        !reader.read_integer(keys[3 * i + 2])) {
+      return nullptr;
+    }
+    reader.skip_line();
+  }
+  F->bulk_insert<3>(keys.data(), nf);
+  return F;
+}
+
+/// Write a triangle mesh in the OFF format.
+inline void write_off(std::ostream &out, const Mesh &F) {
+  out << "OFF\n"
+      << F.size<1>() << " " << F.size<3>() << " " << F.size<2>() << "\n";
+  std::vector<int> index(F.slots<1>());
+  int i = 0;
+  for (auto v : F.get_level_id<1>()) {
+    index[v.index()] = i++;
+    const Point &p = *v;
+    out << p[0] << " " << p[1] << " " << p[2] << "\n";
+  }
+  for (auto f : F.get_level_id<3>()) {
+    out << 3;
+    for (auto key : F.get_name(f)) {
+      out << " " << index[F.get_simplex_up({key}).index()];
+    }
+    out << "\n";
+  }
+}
+} // end namespace bench
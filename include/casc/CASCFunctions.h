@@ -27,8 +27,12 @@
 #include "SimplexSet.h"
 #include "SimplicialComplex.h"
 #include "stringutil.h"
+#include "textio.h"
+#include <array>
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <type_traits>
 
 namespace casc {
 /// @cond detail
@@ -65,14 +69,8 @@ template <typename Complex> struct SimplexAggregator {
    */
   template <std::size_t k>
   bool visit(Complex &, typename Complex::template SimplexID<k> s) {
-    // If the simplex isn't there, insert it.
-    if (pLevels->find(s) == pLevels->template end<k>()) {
-      pLevels->insert(s);
-      return true;
-    } else {
-      // Everything after has been found already
-      return false;
-    }
+    // If the simplex was already there everything after has been found
+    return pLevels->insert(s);
   }
 
 private:
@@ -129,21 +127,77 @@ template <typename Complex> struct ClosureHelper {
   }
 };
 
+/// Write an integral key.
+template <typename Writer, typename T>
+void write_key(Writer &w, const T &key, std::true_type) {
+  w.write_integer(key);
+}
+
+/// Write any other key with std::to_string.
+template <typename Writer, typename T>
+void write_key(Writer &w, const T &key, std::false_type) {
+  w.write(std::to_string(key));
+}
+
+/**
+ * @brief      Write the name of a simplex like to_string(), e.g. "{1,2}".
+ *
+ * @param      w       Writer to print to.
+ * @param[in]  A       Name of the simplex.
+ *
+ * @tparam     Writer  Typename of the textio writer.
+ * @tparam     T       Typename KeyType.
+ * @tparam     k       Dimension of the simplex.
+ */
+template <typename Writer, typename T, std::size_t k>
+void write_name(Writer &w, const std::array<T, k> &A) {
+  if (k == 0) {
+    w.write("{root}", 6);
+    return;
+  }
+  w.put('{');
+  for (std::size_t i = 0; i < k; ++i) {
+    if (i > 0) {
+      w.put(',');
+    }
+    write_key(w, A[i], std::is_integral<T>());
+  }
+  w.put('}');
+}
+
+/**
+ * @brief      Write a quoted DOT node id.
+ *
+ * @param      w       Writer to print to.
+ * @param[in]  prefix  Text to put before the name.
+ * @param[in]  A       Name of the simplex.
+ *
+ * @tparam     Writer  Typename of the textio writer.
+ * @tparam     T       Typename KeyType.
+ * @tparam     k       Dimension of the simplex.
+ */
+template <typename Writer, typename T, std::size_t k>
+void write_node_id(Writer &w, const char *prefix, const std::array<T, k> &A) {
+  w.put('"').write(prefix);
+  write_name(w, A);
+  w.put('"');
+}
+
 /**
  * @brief      Visitor for printing connectivity of the simplicial complex.
  *
  * @tparam     Complex  Typename of the simplicial complex.
  */
 template <typename Complex> struct GraphVisitor {
-  /// ostream to write out to.
-  std::ostream &fout;
+  /// Writer to print to.
+  textio::buffered_writer &fout;
 
   /**
    * @brief      Constructor
    *
-   * @param      os    Ostream to print to.
+   * @param      w     Writer to print to.
    */
-  GraphVisitor(std::ostream &os) : fout(os) {}
+  GraphVisitor(textio::buffered_writer &w) : fout(w) {}
 
   /**
    * @brief      Generic visitor prints the simplices and edge connectivity.
@@ -157,16 +211,13 @@ template <typename Complex> struct GraphVisitor {
    */
   template <std::size_t level>
   bool visit(const Complex &F, typename Complex::template SimplexID<level> s) {
-    auto name = to_string(F.get_name(s));
-
-    auto covers = F.get_cover(s);
-    for (auto cover : covers) {
+    const auto name = F.get_name(s);
+    for (auto cover : F.cover_view(s)) {
       auto edge = F.get_edge_up(s, cover);
-      auto nextName = to_string(F.get_name(edge.up()));
       if ((*edge).orientation == 1) {
-        fout << "   \"" << name << "\" -> \"" << nextName << "\"" << std::endl;
+        write_arrow(name, "", F.get_name(edge.up()), "");
       } else {
-        fout << "   \"" << nextName << "\" -> \"" << name << "\"" << std::endl;
+        write_arrow(F.get_name(edge.up()), "", name, "");
       }
     }
     return true;
@@ -183,22 +234,14 @@ template <typename Complex> struct GraphVisitor {
    */
   bool visit(const Complex &F,
              typename Complex::template SimplexID<Complex::topLevel - 1> s) {
-
-    auto name = to_string(F.get_name(s));
-    auto covers = F.get_cover(s);
-    for (auto cover : covers) {
+    const auto name = F.get_name(s);
+    for (auto cover : F.cover_view(s)) {
       auto edge = F.get_edge_up(s, cover);
-      auto nextName = to_string(F.get_name(edge.up()));
-      auto orient = (*edge.up()).orientation;
-      if (orient == 1) {
-        nextName = "+ " + nextName;
-      } else {
-        nextName = "- " + nextName;
-      }
+      const char *sign = (*edge.up()).orientation == 1 ? "+ " : "- ";
       if ((*edge).orientation == 1) {
-        fout << "   \"" << name << "\" -> \"" << nextName << "\"" << std::endl;
+        write_arrow(name, "", F.get_name(edge.up()), sign);
       } else {
-        fout << "   \"" << nextName << "\" -> \"" << name << "\"" << std::endl;
+        write_arrow(F.get_name(edge.up()), sign, name, "");
       }
     }
     return true;
@@ -213,6 +256,18 @@ template <typename Complex> struct GraphVisitor {
    */
   void visit(const Complex &,
              typename Complex::template SimplexID<Complex::topLevel>) {}
+
+private:
+  /// Print one line `"from" -> "to"`.
+  template <typename From, typename To>
+  void write_arrow(const From &from, const char *from_prefix, const To &to,
+                   const char *to_prefix) {
+    fout.write("   ", 3);
+    write_node_id(fout, from_prefix, from);
+    fout.write(" -> ", 4);
+    write_node_id(fout, to_prefix, to);
+    fout.put('\n');
+  }
 };
 
 /**
@@ -234,17 +289,18 @@ struct DotHelper<Complex, std::integral_constant<std::size_t, k>> {
   /**
    * @brief      Print out a list of simplices in a simplex dimension.
    *
-   * @param      fout  Stream to print to.
+   * @param      fout  Writer to print to.
    * @param[in]  F     Complex of interest.
    */
-  static void printlevel(std::ofstream &fout, const Complex &F) {
+  static void printlevel(textio::buffered_writer &fout, const Complex &F) {
     auto nodes = F.template get_level_id<k>();
-    fout << "subgraph cluster_" << k << " {\n"
-         << "label=\"Level " << k << "\"\n";
+    fout.write("subgraph cluster_").write_integer(k).write(" {\n");
+    fout.write("label=\"Level ").write_integer(k).write("\"\n");
     for (auto node : nodes) {
-      fout << "\"" << to_string(F.get_name(node)) << "\";";
+      write_node_id(fout, "", F.get_name(node));
+      fout.put(';');
     }
-    fout << "\n}\n";
+    fout.write("\n}\n", 3);
     DotHelper<Complex, std::integral_constant<std::size_t, k + 1>>::printlevel(
         fout, F);
   }
@@ -261,23 +317,23 @@ struct DotHelper<Complex,
   /**
    * @brief      Print out a list of facets of the complex.
    *
-   * @param      fout  Stream to print to.
+   * @param      fout  Writer to print to.
    * @param[in]  F     Complex of interest.
    */
-  static void printlevel(std::ofstream &fout, const Complex &F) {
+  static void printlevel(textio::buffered_writer &fout, const Complex &F) {
     auto nodes = F.template get_level_id<Complex::topLevel>();
-    fout << "subgraph cluster_" << Complex::topLevel << " {\n"
-         << "label=\"Level " << Complex::topLevel << "\"\n";
+    fout.write("subgraph cluster_")
+        .write_integer(Complex::topLevel)
+        .write(" {\n");
+    fout.write("label=\"Level ")
+        .write_integer(Complex::topLevel)
+        .write("\"\n");
     for (auto node : nodes) {
-      auto orient = (*node).orientation;
-      if (orient == 1) {
-        fout << "\"+ ";
-      } else {
-        fout << "\"- ";
-      }
-      fout << to_string(F.get_name(node)) << "\";";
+      write_node_id(fout, (*node).orientation == 1 ? "+ " : "- ",
+                    F.get_name(node));
+      fout.put(';');
     }
-    fout << "\n}\n";
+    fout.write("\n}\n", 3);
   }
 };
 } // end namespace func_detail
@@ -422,25 +478,26 @@ void getLink(Complex &F, Simplex &s, casc::SimplexSet<Complex> &dest) {
 template <typename Complex>
 void writeDOT(const std::string &filename, Complex &F) {
   // TODO: Put back the const F (0)
-  std::ofstream fout(filename);
-  if (!fout.is_open()) {
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
     std::cerr << "File '" << filename << "' could not be writen to."
               << std::endl;
-    fout.close();
+    file.close();
     exit(1);
   }
+  textio::buffered_writer fout(file);
 
-  fout << "digraph {\n"
-       << "node [shape = record,height = .1]"
-       << "splines=line;\n"
-       << "dpi=300;\n";
+  fout.write("digraph {\n"
+             "node [shape = record,height = .1]"
+             "splines=line;\n"
+             "dpi=300;\n");
   auto v = func_detail::GraphVisitor<Complex>(fout);
   visit_BFS_up(v, F, F.get_simplex_up());
 
   // List the simplices
   func_detail::DotHelper<
       Complex, std::integral_constant<std::size_t, 0>>::printlevel(fout, F);
-  fout << "}\n";
-  fout.close();
+  fout.write("}\n", 2);
+  fout.flush();
 }
 } // end namespace casc
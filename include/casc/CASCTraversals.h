@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <casc/casc>
 #include <iostream>
 #include <set>
@@ -32,6 +33,10 @@
 #include <utility>
 #include <vector>
 
+#include "parallel.h"
+#include "stats.h"
+#include "visited_set.h"
+
 namespace casc {
 /// @cond detail
 /// Visitor design pattern helper templates
@@ -98,6 +103,7 @@ struct BFS_Up_Node<Visitor, Traits, Complex,
       }
     }
 
+    CASC_STATS_RECORD(bfs_up, next.size());
     BFS_Up_Node_Next::apply(std::forward<Visitor>(v), F, next.begin(),
                             next.end());
   }
@@ -197,6 +203,7 @@ struct BFS_Down_Node<Visitor, Traits, Complex,
       }
     }
 
+    CASC_STATS_RECORD(bfs_down, next.size());
     BFS_Down_Node_Next::apply(std::forward<Visitor>(v), F, next.begin(),
                               next.end());
   }
@@ -357,10 +364,105 @@ struct BFS_Repeat_Node_traits {
 
 /// No repeat traits for BFS simplex visitor.
 struct BFS_NoRepeat_Node_Traits {
-  /// Use a NodeSet to avoid duplicates
-  template <typename T> using Container = NodeSet<T>;
+  /// Use a stamped visited_list to avoid duplicates
+  template <typename T> using Container = visited_list<T>;
 };
 
+/**
+ * @brief      Grow rings of neighbors using the tail of `nbors` as the BFS
+ *             queue.
+ *
+ * @param[in]  nid     Simplex at the center.
+ * @param[in]  ring    Number of rings.
+ * @param      nbors   Receives the neighbors ring by ring.
+ * @param      expand  Appends the unseen neighbors of a simplex to nbors.
+ */
+template <typename SimplexID, typename Vector, typename Expand>
+void expand_rings(SimplexID nid, int ring, Vector &nbors,
+                  Expand &&expand) {
+  if (ring <= 0) {
+    return;
+  }
+  std::size_t first = nbors.size();
+  expand(nid);
+  for (int r = 1; r < ring; ++r) {
+    const std::size_t last = nbors.size();
+    for (std::size_t i = first; i < last; ++i) {
+      expand(nbors[i]);
+    }
+    first = last;
+  }
+}
+
+/**
+ * @brief      Append the k-ring coface neighbors of a simplex.
+ *
+ * @param[in]  F      The simplicial complex
+ * @param[in]  nid    Simplex of interest.
+ * @param[in]  ring   The number of rings.
+ * @param      seen   Scratch visited set, cleared first.
+ * @param      nbors  Vector to append the neighbors to.
+ */
+template <class Complex, class SimplexID, class Vector>
+void append_kring_up(Complex &F, SimplexID nid, int ring,
+                     visited_set<SimplexID> &seen, Vector &nbors) {
+  seen.clear();
+  seen.insert(nid);
+  auto expand = [&](SimplexID curr) {
+    for (auto a : F.cover_view(curr)) {
+      auto id = F.get_simplex_up(curr, a);
+      for (auto b : F.get_name(id)) {
+        auto nbor = F.get_simplex_down(id, b);
+        if (seen.insert(nbor)) {
+          nbors.push_back(nbor);
+        }
+      }
+    }
+  };
+  expand_rings(nid, ring, nbors, expand);
+}
+
+/**
+ * @brief      Append the k-ring face neighbors of a simplex.
+ *
+ * @param[in]  F      The simplicial complex
+ * @param[in]  nid    Simplex of interest.
+ * @param[in]  ring   The number of rings.
+ * @param      seen   Scratch visited set, cleared first.
+ * @param      nbors  Vector to append the neighbors to.
+ */
+template <class Complex, class SimplexID, class Vector>
+void append_kring_down(Complex &F, SimplexID nid, int ring,
+                       visited_set<SimplexID> &seen, Vector &nbors) {
+  seen.clear();
+  seen.insert(nid);
+  auto expand = [&](SimplexID curr) {
+    if (curr != nid) {
+      // Outer rings follow the cofaces like kneighbors()
+      for (auto a : F.cover_view(curr)) {
+        auto id = F.get_simplex_up(curr, a);
+        for (auto b : F.get_name(id)) {
+          auto nbor = F.get_simplex_down(id, b);
+          if (seen.insert(nbor)) {
+            nbors.push_back(nbor);
+          }
+        }
+      }
+      return;
+    }
+    for (auto a : F.get_name(curr)) {
+      auto id = F.get_simplex_down(curr, a);
+      for (auto b : F.cover_view(id)) {
+        auto nbor = F.get_simplex_up(id, b);
+        if (seen.insert(nbor)) {
+          nbors.push_back(nbor);
+        }
+      }
+    }
+  };
+  expand_rings(nid, ring, nbors, expand);
+}
+
 /// No repeat traits for BFS edge visitor.
 struct BFS_NoRepeat_Edge_Traits {
   /// Use a NodeSet to avoid duplicates.
@@ -368,6 +470,204 @@ struct BFS_NoRepeat_Edge_Traits {
   // template <typename Complex, typename SimplexID> auto node_next(Complex F,
   // SimplexID s);
 };
+/**
+ * @brief      Level synchronous parallel BFS up helper.
+ *
+ * @tparam     Visitor  Type of visitor functor.
+ * @tparam     Complex  Typename of the simplicial_complex.
+ * @tparam     K        Current simplex dimension to traverse.
+ */
+template <typename Visitor, typename Complex, typename K>
+struct Parallel_BFS_Up_Node {};
+
+/**
+ * @brief      Partial specialization for non facet dimensions.
+ *
+ * @tparam     Visitor  Type of visitor functor.
+ * @tparam     Complex  Typename of the simplicial_complex.
+ * @tparam     k        Current simplex dimension to traverse.
+ */
+template <typename Visitor, typename Complex, std::size_t k>
+struct Parallel_BFS_Up_Node<Visitor, Complex,
+                            std::integral_constant<std::size_t, k>> {
+  /// Typename of the current simplex
+  using CurrSimplexID = typename Complex::template SimplexID<k>;
+  /// Typename of coboundary simplices
+  using NextSimplexID = typename Complex::template SimplexID<k + 1>;
+  /// Alias for the recursive call
+  using Next = Parallel_BFS_Up_Node<Visitor, Complex,
+                                    std::integral_constant<std::size_t, k + 1>>;
+
+  /**
+   * @brief      Visit a frontier in parallel and continue with the cofaces.
+   *
+   * @param[in]  v         Visitor functor.
+   * @param[in]  F         The simplicial_complex to traverse.
+   * @param[in]  frontier  Simplices of dimension k to visit.
+   * @param[in]  grain     Number of simplices per block.
+   */
+  static void apply(Visitor &v, Complex &F,
+                    const std::vector<CurrSimplexID> &frontier,
+                    std::size_t grain) {
+    // Cofaces found by each block, merged in block order for determinism
+    std::vector<std::vector<NextSimplexID>> found(
+        (frontier.size() + grain - 1) / grain);
+    parallel::for_blocks(
+        frontier.size(), grain, [&](std::size_t, std::size_t b, std::size_t e) {
+          auto &out = found[b / grain];
+          for (std::size_t i = b; i < e; ++i) {
+            const CurrSimplexID curr = frontier[i];
+            if (v.visit(F, curr)) {
+              for (auto a : F.cover_view(curr)) {
+                out.push_back(F.get_simplex_up(curr, a));
+              }
+            }
+          }
+        });
+    std::vector<NextSimplexID> next;
+    visited_set<NextSimplexID> seen;
+    for (const auto &out : found) {
+      for (auto s : out) {
+        if (seen.insert(s)) {
+          next.push_back(s);
+        }
+      }
+    }
+    Next::apply(v, F, next, grain);
+  }
+};
+
+/**
+ * @brief      Partial specialization for facets.
+ *
+ * @tparam     Visitor  Type of visitor functor.
+ * @tparam     Complex  Typename of the simplicial_complex.
+ */
+template <typename Visitor, typename Complex>
+struct Parallel_BFS_Up_Node<
+    Visitor, Complex, std::integral_constant<std::size_t, Complex::topLevel>> {
+  /// Typename of the current simplex
+  using CurrSimplexID = typename Complex::template SimplexID<Complex::topLevel>;
+
+  /**
+   * @brief      Visit a frontier of facets in parallel.
+   *
+   * @param[in]  v         Visitor functor.
+   * @param[in]  F         The simplicial_complex to traverse.
+   * @param[in]  frontier  Facets to visit.
+   * @param[in]  grain     Number of simplices per block.
+   */
+  static void apply(Visitor &v, Complex &F,
+                    const std::vector<CurrSimplexID> &frontier,
+                    std::size_t grain) {
+    parallel::for_blocks(frontier.size(), grain,
+                         [&](std::size_t, std::size_t b, std::size_t e) {
+                           for (std::size_t i = b; i < e; ++i) {
+                             v.visit(F, frontier[i]);
+                           }
+                         });
+  }
+};
+
+/**
+ * @brief      Level synchronous parallel BFS down helper.
+ *
+ * @tparam     Visitor  Type of visitor functor.
+ * @tparam     Complex  Typename of the simplicial_complex.
+ * @tparam     K        Current simplex dimension to traverse.
+ */
+template <typename Visitor, typename Complex, typename K>
+struct Parallel_BFS_Down_Node {};
+
+/**
+ * @brief      Partial specialization for dimensions above vertices.
+ *
+ * @tparam     Visitor  Type of visitor functor.
+ * @tparam     Complex  Typename of the simplicial_complex.
+ * @tparam     k        Current simplex dimension to traverse.
+ */
+template <typename Visitor, typename Complex, std::size_t k>
+struct Parallel_BFS_Down_Node<Visitor, Complex,
+                              std::integral_constant<std::size_t, k>> {
+  /// Typename of the current simplex
+  using CurrSimplexID = typename Complex::template SimplexID<k>;
+  /// Typename of boundary simplices
+  using NextSimplexID = typename Complex::template SimplexID<k - 1>;
+  /// Alias for the recursive call
+  using Next =
+      Parallel_BFS_Down_Node<Visitor, Complex,
+                             std::integral_constant<std::size_t, k - 1>>;
+
+  /**
+   * @brief      Visit a frontier in parallel and continue with the faces.
+   *
+   * @param[in]  v         Visitor functor.
+   * @param[in]  F         The simplicial_complex to traverse.
+   * @param[in]  frontier  Simplices of dimension k to visit.
+   * @param[in]  grain     Number of simplices per block.
+   */
+  static void apply(Visitor &v, Complex &F,
+                    const std::vector<CurrSimplexID> &frontier,
+                    std::size_t grain) {
+    // Faces found by each block, merged in block order for determinism
+    std::vector<std::vector<NextSimplexID>> found(
+        (frontier.size() + grain - 1) / grain);
+    parallel::for_blocks(
+        frontier.size(), grain, [&](std::size_t, std::size_t b, std::size_t e) {
+          auto &out = found[b / grain];
+          for (std::size_t i = b; i < e; ++i) {
+            const CurrSimplexID curr = frontier[i];
+            if (v.visit(F, curr)) {
+              F.get_name(curr, [&](typename Complex::KeyType a) {
+                out.push_back(F.get_simplex_down(curr, a));
+              });
+            }
+          }
+        });
+    std::vector<NextSimplexID> next;
+    visited_set<NextSimplexID> seen;
+    for (const auto &out : found) {
+      for (auto s : out) {
+        if (seen.insert(s)) {
+          next.push_back(s);
+        }
+      }
+    }
+    Next::apply(v, F, next, grain);
+  }
+};
+
+/**
+ * @brief      Partial specialization for vertices.
+ *
+ * @tparam     Visitor  Type of visitor functor.
+ * @tparam     Complex  Typename of the simplicial_complex.
+ */
+template <typename Visitor, typename Complex>
+struct Parallel_BFS_Down_Node<Visitor, Complex,
+                              std::integral_constant<std::size_t, 1>> {
+  /// Typename of the current simplex
+  using CurrSimplexID = typename Complex::template SimplexID<1>;
+
+  /**
+   * @brief      Visit a frontier of vertices in parallel.
+   *
+   * @param[in]  v         Visitor functor.
+   * @param[in]  F         The simplicial_complex to traverse.
+   * @param[in]  frontier  Vertices to visit.
+   * @param[in]  grain     Number of simplices per block.
+   */
+  static void apply(Visitor &v, Complex &F,
+                    const std::vector<CurrSimplexID> &frontier,
+                    std::size_t grain) {
+    parallel::for_blocks(frontier.size(), grain,
+                         [&](std::size_t, std::size_t b, std::size_t e) {
+                           for (std::size_t i = b; i < e; ++i) {
+                             v.visit(F, frontier[i]);
+                           }
+                         });
+  }
+};
 } // End namespace visitor_detail
 /// @endcond
 
@@ -375,6 +675,10 @@ struct BFS_NoRepeat_Edge_Traits {
  * @brief      Traverse BFS up the complex and apply a visitor function to each
  *             simplex visited.
  *
+ * Visited simplices are tracked by SimplexID::index(). The visitor must not
+ * insert or remove simplices, since a registry compaction renumbers the
+ * indices and simplices could be skipped or visited twice.
+ *
  * @param[in]  v          Visitor functor to apply.
  * @param      F          The simplicial_complex to traverse.
  * @param[in]  s          The simplex to start at.
@@ -396,6 +700,9 @@ void visit_BFS_up(Visitor &&v, typename SimplexID::complex &F, SimplexID s) {
  * each
  *             simplex visited.
  *
+ * The visitor must not modify the topology of the complex, see
+ * visit_BFS_up().
+ *
  * @param[in]  v          Visitor functor to apply.
  * @param      F          The simplicial_complex to traverse.
  * @param[in]  s          The simplex to start at.
@@ -412,6 +719,99 @@ void visit_BFS_down(Visitor &&v, typename SimplexID::complex &F, SimplexID s) {
       apply(std::forward<Visitor>(v), F, &s, &s + 1);
 }
 
+/**
+ * @brief      Traverse BFS up the complex visiting each dimension in
+ *             parallel.
+ *
+ * The simplices of one dimension are visited concurrently before the next
+ * dimension is expanded, so every simplex is visited once just like
+ * visit_BFS_up(). Within a dimension the visit order is unspecified. The
+ * visitor must therefore be safe to call from several threads at once;
+ * reading the complex and writing the data of the visited simplex is.
+ *
+ * @param[in]  v          Visitor functor to apply.
+ * @param      F          The simplicial_complex to traverse.
+ * @param[in]  s          The simplex to start at.
+ * @param[in]  grain      Number of simplices handed to a thread at once.
+ *
+ * @tparam     Visitor    Typename of the functor.
+ * @tparam     SimplexID  Typename of the simplex.
+ */
+template <typename Visitor, typename SimplexID>
+void parallel_visit_BFS_up(Visitor &&v, typename SimplexID::complex &F,
+                           SimplexID s, std::size_t grain = 256) {
+  grain = std::max<std::size_t>(grain, 1);
+  namespace cvd = visitor_detail;
+  cvd::Parallel_BFS_Up_Node<
+      typename std::remove_reference<Visitor>::type,
+      typename SimplexID::complex,
+      std::integral_constant<std::size_t, SimplexID::level>>::apply(v, F, {s},
+                                                                    grain);
+}
+
+/**
+ * @brief      Traverse BFS down the complex visiting each dimension in
+ *             parallel.
+ *
+ * @param[in]  v          Visitor functor to apply.
+ * @param      F          The simplicial_complex to traverse.
+ * @param[in]  s          The simplex to start at.
+ * @param[in]  grain      Number of simplices handed to a thread at once.
+ *
+ * @tparam     Visitor    Typename of the functor.
+ * @tparam     SimplexID  Typename of the simplex.
+ *
+ * @see        parallel_visit_BFS_up()
+ */
+template <typename Visitor, typename SimplexID>
+void parallel_visit_BFS_down(Visitor &&v, typename SimplexID::complex &F,
+                             SimplexID s, std::size_t grain = 256) {
+  grain = std::max<std::size_t>(grain, 1);
+  namespace cvd = visitor_detail;
+  cvd::Parallel_BFS_Down_Node<
+      typename std::remove_reference<Visitor>::type,
+      typename SimplexID::complex,
+      std::integral_constant<std::size_t, SimplexID::level>>::apply(v, F, {s},
+                                                                    grain);
+}
+
+/**
+ * @brief      Apply a function to every k-simplex using all threads.
+ *
+ * The registry of the level is split into blocks of `grain` slots which
+ * the threads claim dynamically, so uneven per-simplex costs are balanced.
+ * Any read-only access to the complex and writes to the data of the
+ * simplex passed in are safe from within `fn`. Inserting or removing
+ * simplices is not.
+ *
+ * Example -- compute per-vertex values concurrently:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::parallel_for_each<1>(mesh, [&](Mesh::SimplexID<1> v) {
+ *   *v = some_function(mesh, v);
+ * });
+ * ~~~~~~~~~~~~~~~
+ *
+ * @param      F        The simplicial complex.
+ * @param[in]  fn       Functor called as fn(SimplexID<k>).
+ * @param[in]  grain    Number of slots handed to a thread at once.
+ *
+ * @tparam     k        Dimension of the simplices to visit.
+ * @tparam     Complex  Typename of the complex.
+ * @tparam     Fn       Typename of the functor.
+ */
+template <std::size_t k, typename Complex, typename Fn>
+void parallel_for_each(Complex &F, Fn &&fn, std::size_t grain = 1024) {
+  parallel::for_blocks(F.template slots<k>(), grain,
+                       [&](std::size_t, std::size_t b, std::size_t e) {
+                         for (std::size_t i = b; i < e; ++i) {
+                           auto s = F.template get_simplex_at<k>(i);
+                           if (s != nullptr) {
+                             fn(s);
+                           }
+                         }
+                       });
+}
+
 /**
  * @brief      Traverse across edges BFS.
  *
@@ -454,7 +854,7 @@ void neighbors(Complex &F, typename Complex::template SimplexID<level> nid,
                InsertIter iter) {
   for (auto a : F.get_name(nid)) {
     auto id = F.get_simplex_down(nid, a);
-    for (auto b : F.get_cover(id)) {
+    for (auto b : F.cover_view(id)) {
       auto nbor = F.get_simplex_up(id, b);
       if (nbor != nid) {
         *iter++ = nbor;
@@ -494,7 +894,7 @@ void neighbors(Complex &F, SimplexID nid, InsertIter iter) {
 template <class Complex, std::size_t level, class InsertIter>
 void neighbors_up(Complex &F, typename Complex::template SimplexID<level> nid,
                   InsertIter iter) {
-  for (auto a : F.get_cover(nid)) {
+  for (auto a : F.cover_view(nid)) {
     auto id = F.get_simplex_up(nid, a);
     for (auto b : F.get_name(id)) {
       auto nbor = F.get_simplex_down(id, b);
@@ -542,14 +942,15 @@ void kneighbors_up(Complex &F, int ring,
   if (ring == 0) {
     return;
   }
-  std::set<typename Complex::template SimplexID<level>> next;
+  // Simplices enter next only once, when first inserted into nbors
+  std::vector<typename Complex::template SimplexID<level>> next;
   for (auto nid = begin; nid != end; ++nid) {
-    for (auto a : F.get_cover(*nid)) {
+    for (auto a : F.cover_view(*nid)) {
       auto id = F.get_simplex_up(*nid, a);
       for (auto b : F.get_name(id)) {
         auto nbor = F.get_simplex_down(id, b);
         if (nbors.insert(nbor).second) {
-          next.insert(nbor);
+          next.push_back(nbor);
         }
       }
     }
@@ -574,15 +975,41 @@ template <class Complex, class SimplexID>
 void kneighbors_up(Complex &F, SimplexID nid, int ring,
                    std::set<SimplexID> &nbors) {
   nbors.insert(nid);
-  std::set<SimplexID> next{nid};
-  kneighbors_up<Complex, SimplexID::level>(F, ring, nbors, next.begin(),
-                                           next.end());
+  kneighbors_up<Complex, SimplexID::level>(F, ring, nbors, &nid, &nid + 1);
   nbors.erase(nid);
 }
 
+/**
+ * @brief      Collect the k-ring coface neighbors into a vector.
+ *
+ * Same neighbors as kneighbors_up(Complex&, SimplexID, int,
+ * std::set<SimplexID>&) but ordered by ring and then by discovery. Visited
+ * simplices are tracked in a visited_set, so repeated queries reusing
+ * `nbors` do not allocate once warmed up.
+ *
+ * @param[in]  F           The simplicial complex
+ * @param[in]  nid         Simplex of interest to get the neighbors of.
+ * @param[in]  ring        The number of rings to include as a neighbor.
+ * @param[out] nbors       Vector of neighbors, cleared first.
+ *
+ * @tparam     Complex     Typename of the complex.
+ * @tparam     SimplexID   Typename of the SimplexID.
+ */
+template <class Complex, class SimplexID>
+void kneighbors_up(Complex &F, SimplexID nid, int ring,
+                   std::vector<SimplexID> &nbors) {
+  nbors.clear();
+  visited_set<SimplexID> seen;
+  visitor_detail::append_kring_up(F, nid, ring, seen, nbors);
+}
+
 /**
  * @brief      Code for returning a set of k-ring neighbors.
  *
+ * The first ring holds the simplices sharing a face. Later rings follow
+ * the cofaces like kneighbors_up(), so top dimensional simplices are not
+ * supported.
+ *
  * @param[in]  F         The simplicial_complex to traverse.
  * @param[in]  ring      The number of rings of neighbors to collect.
  * @param[out] nbors     Set of previously seen simplices.
@@ -600,14 +1027,15 @@ void kneighbors(Complex &F, int ring,
   if (ring == 0) {
     return;
   }
-  std::set<typename Complex::template SimplexID<level>> next;
+  // Simplices enter next only once, when first inserted into nbors
+  std::vector<typename Complex::template SimplexID<level>> next;
   for (auto nid = begin; nid != end; ++nid) {
     for (auto a : F.get_name(*nid)) {
       auto id = F.get_simplex_down(*nid, a);
-      for (auto b : F.get_cover(id)) {
+      for (auto b : F.cover_view(id)) {
         auto nbor = F.get_simplex_up(id, b);
         if (nbors.insert(nbor).second) {
-          next.insert(nbor);
+          next.push_back(nbor);
         }
       }
     }
@@ -632,12 +1060,166 @@ template <class Complex, class SimplexID>
 void kneighbors(Complex &F, SimplexID nid, int ring,
                 std::set<SimplexID> &nbors) {
   nbors.insert(nid);
-  std::set<SimplexID> next{nid};
-  kneighbors<Complex, SimplexID::level>(F, ring, nbors, next.begin(),
-                                        next.end());
+  kneighbors<Complex, SimplexID::level>(F, ring, nbors, &nid, &nid + 1);
   nbors.erase(nid);
 }
 
+/**
+ * @brief      Collect the k-ring face neighbors into a vector.
+ *
+ * Same neighbors as kneighbors(Complex&, SimplexID, int,
+ * std::set<SimplexID>&) but ordered by ring and then by discovery. Visited
+ * simplices are tracked in a visited_set, so repeated queries reusing
+ * `nbors` do not allocate once warmed up.
+ *
+ * @param[in]  F           The simplicial complex
+ * @param[in]  nid         Simplex of interest to get the neighbors of.
+ * @param[in]  ring        The number of rings to include as a neighbor.
+ * @param[out] nbors       Vector of neighbors, cleared first.
+ *
+ * @tparam     Complex     Typename of the complex.
+ * @tparam     SimplexID   Typename of the SimplexID.
+ */
+template <class Complex, class SimplexID>
+void kneighbors(Complex &F, SimplexID nid, int ring,
+                std::vector<SimplexID> &nbors) {
+  nbors.clear();
+  visited_set<SimplexID> seen;
+  visitor_detail::append_kring_down(F, nid, ring, seen, nbors);
+}
+
+/**
+ * @brief      Neighbor lists of many simplices in compressed sparse row
+ *             form.
+ *
+ * The neighbors of seed `i` are `ids[offsets[i]]` up to but excluding
+ * `ids[offsets[i + 1]]`.
+ *
+ * @tparam     SimplexID  Typename of the simplices.
+ */
+template <typename SimplexID> struct neighbor_lists {
+  /// Start of the list of each seed, plus the total at the end
+  std::vector<std::size_t> offsets;
+  /// Concatenated neighbor lists
+  std::vector<SimplexID> ids;
+
+  /// Number of seeds.
+  std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+  /**
+   * @brief      Get the neighbors of a seed.
+   *
+   * @param[in]  i     Index of the seed.
+   *
+   * @return     Range over the neighbors.
+   */
+  util::range<const SimplexID *> operator[](std::size_t i) const {
+    return util::range<const SimplexID *>(ids.data() + offsets[i],
+                                          ids.data() + offsets[i + 1]);
+  }
+};
+
+/// @cond detail
+namespace visitor_detail {
+/**
+ * @brief      Compute the rings of all seeds in parallel chunks.
+ *
+ * @param[in]  seeds   Seeds to compute the rings of.
+ * @param[out] out     Neighbor lists of the seeds.
+ * @param      append  Functor appending the ring of a seed to a vector
+ *                     using a visited_set.
+ */
+template <typename SimplexID, typename Append>
+void batch_rings(const std::vector<SimplexID> &seeds,
+                 neighbor_lists<SimplexID> &out, Append &&append) {
+  const std::size_t n = seeds.size();
+  const std::size_t chunks = parallel::chunk_count(n, 64);
+  // Neighbors and list lengths of each chunk
+  std::vector<std::vector<SimplexID>> ids(chunks);
+  out.offsets.assign(n + 1, 0);
+  parallel::for_chunks(n, 64, [&](std::size_t c, std::size_t b, std::size_t e) {
+    visited_set<SimplexID> seen;
+    auto &local = c == 0 ? out.ids : ids[c];
+    local.clear();
+    for (std::size_t i = b; i < e; ++i) {
+      const std::size_t before = local.size();
+      append(seeds[i], seen, local);
+      out.offsets[i + 1] = local.size() - before;
+    }
+  });
+  for (std::size_t i = 0; i < n; ++i) {
+    out.offsets[i + 1] += out.offsets[i];
+  }
+  // The first chunk was written in place, append the others
+  for (std::size_t c = 1; c < chunks; ++c) {
+    out.ids.insert(out.ids.end(), ids[c].begin(), ids[c].end());
+  }
+}
+} // End namespace visitor_detail
+/// @endcond
+
+/**
+ * @brief      Compute the k-ring coface neighbors of many simplices.
+ *
+ * Gives the same neighbors as kneighbors_up(Complex&, SimplexID, int,
+ * std::vector<SimplexID>&) for every seed. Scratch state is shared
+ * between the seeds of a thread, and the seeds are split across the
+ * threads of the parallel helpers.
+ *
+ * Example -- 2-ring of every vertex:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * std::vector<Mesh::SimplexID<1>> verts;
+ * for (auto v : mesh.get_level_id<1>())
+ *   verts.push_back(v);
+ * casc::neighbor_lists<Mesh::SimplexID<1>> rings;
+ * casc::kneighbors_up_batch(mesh, verts, 2, rings);
+ * for (auto nbor : rings[0])
+ *   ...
+ * ~~~~~~~~~~~~~~~
+ *
+ * @param[in]  F          The simplicial complex
+ * @param[in]  seeds      Simplices to get the neighbors of.
+ * @param[in]  ring       The number of rings to include as a neighbor.
+ * @param[out] out        Neighbor lists in the order of `seeds`.
+ *
+ * @tparam     Complex    Typename of the complex.
+ * @tparam     SimplexID  Typename of the SimplexID.
+ */
+template <class Complex, class SimplexID>
+void kneighbors_up_batch(Complex &F, const std::vector<SimplexID> &seeds,
+                         int ring, neighbor_lists<SimplexID> &out) {
+  visitor_detail::batch_rings(
+      seeds, out,
+      [&](SimplexID s, visited_set<SimplexID> &seen,
+          std::vector<SimplexID> &nbors) {
+        visitor_detail::append_kring_up(F, s, ring, seen, nbors);
+      });
+}
+
+/**
+ * @brief      Compute the k-ring face neighbors of many simplices.
+ *
+ * @param[in]  F          The simplicial complex
+ * @param[in]  seeds      Simplices to get the neighbors of.
+ * @param[in]  ring       The number of rings to include as a neighbor.
+ * @param[out] out        Neighbor lists in the order of `seeds`.
+ *
+ * @tparam     Complex    Typename of the complex.
+ * @tparam     SimplexID  Typename of the SimplexID.
+ *
+ * @see        kneighbors_up_batch()
+ */
+template <class Complex, class SimplexID>
+void kneighbors_batch(Complex &F, const std::vector<SimplexID> &seeds,
+                      int ring, neighbor_lists<SimplexID> &out) {
+  visitor_detail::batch_rings(
+      seeds, out,
+      [&](SimplexID s, visited_set<SimplexID> &seen,
+          std::vector<SimplexID> &nbors) {
+        visitor_detail::append_kring_down(F, s, ring, seen, nbors);
+      });
+}
+
 } // End namespace casc
 
 // namespace visitor_detail
@@ -0,0 +1,1717 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  FrozenComplex.h
+ * @brief Compact read-only snapshot of a simplicial_complex and its binary
+ *        file format.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "SimplicialComplex.h"
+#include "util.h"
+
+namespace casc {
+/// @cond detail
+namespace frozen_detail {
+/**
+ * @brief      Kind of the elements of a serialized array.
+ *
+ * Stored next to the element size so that types of equal size, such as
+ * float and int, are not confused. Class types are only distinguished by
+ * their size.
+ *
+ * @tparam     T     Typename of the elements.
+ */
+template <typename T> struct binary_type_tag {
+  /// 1 for signed, 2 for unsigned integers, 3 for floating point, else 4
+  static constexpr std::uint32_t value =
+      std::is_floating_point<T>::value
+          ? 3
+          : std::is_integral<T>::value ? (std::is_signed<T>::value ? 1 : 2)
+                                       : 4;
+};
+
+/// Nothing is serialized without data.
+template <> struct binary_type_tag<void> {
+  /// No type
+  static constexpr std::uint32_t value = 0;
+};
+
+/**
+ * @brief      Read-only array which either owns its elements or views memory
+ *             owned elsewhere, such as a memory mapped file.
+ *
+ * @tparam     T     Typename of the elements.
+ */
+template <typename T> class frozen_array {
+public:
+  /// Construct an empty owning array.
+  frozen_array() : _ptr(nullptr), _n(0), _view(false) {}
+
+  /// Copy the elements, or the view, of another array.
+  frozen_array(const frozen_array &rhs)
+      : _own(rhs._own), _ptr(rhs._ptr), _n(rhs._n), _view(rhs._view) {
+    sync();
+  }
+
+  /// Steal the elements, or the view, of another array.
+  frozen_array(frozen_array &&rhs)
+      : _own(std::move(rhs._own)), _ptr(rhs._ptr), _n(rhs._n),
+        _view(rhs._view) {
+    sync();
+  }
+
+  /// Copy assignment
+  frozen_array &operator=(const frozen_array &rhs) {
+    _own = rhs._own;
+    _ptr = rhs._ptr;
+    _n = rhs._n;
+    _view = rhs._view;
+    sync();
+    return *this;
+  }
+
+  /// Move assignment
+  frozen_array &operator=(frozen_array &&rhs) {
+    _own = std::move(rhs._own);
+    _ptr = rhs._ptr;
+    _n = rhs._n;
+    _view = rhs._view;
+    sync();
+    return *this;
+  }
+
+  /**
+   * @brief      Make this array a view of external memory.
+   *
+   * @param[in]  p     Pointer to the first element.
+   * @param[in]  n     Number of elements.
+   */
+  void view(const T *p, std::size_t n) {
+    _own.clear();
+    _own.shrink_to_fit();
+    _ptr = p;
+    _n = n;
+    _view = true;
+  }
+
+  /// Reserve memory in an owning array.
+  void reserve(std::size_t n) {
+    _own.reserve(n);
+    sync();
+  }
+  /// Append an element to an owning array.
+  void push_back(const T &value) {
+    _own.push_back(value);
+    sync();
+  }
+  /// Resize an owning array.
+  void resize(std::size_t n) {
+    _own.resize(n);
+    sync();
+  }
+  /// Release unused capacity of an owning array.
+  void shrink_to_fit() {
+    _own.shrink_to_fit();
+    sync();
+  }
+
+  /// Number of elements.
+  std::size_t size() const { return _n; }
+  /// Pointer to the elements.
+  const T *data() const { return _ptr; }
+  /// Mutable pointer to the elements of an owning array.
+  T *mutable_data() { return _own.data(); }
+  /// Element access
+  const T &operator[](std::size_t i) const { return _ptr[i]; }
+  /// Iterator to the first element.
+  const T *begin() const { return _ptr; }
+  /// Iterator past the last element.
+  const T *end() const { return _ptr + _n; }
+  /// Iterator to the first element.
+  const T *cbegin() const { return _ptr; }
+  /// Iterator past the last element.
+  const T *cend() const { return _ptr + _n; }
+  /// Bytes owned by the array; views do not count.
+  std::size_t bytes() const { return _own.capacity() * sizeof(T); }
+
+  /// Size of an element when serialized.
+  static constexpr std::size_t element_size = sizeof(T);
+  /// Kind of an element when serialized.
+  static constexpr std::uint32_t type_tag = binary_type_tag<T>::value;
+
+  /**
+   * @brief      Fill the array from serialized memory.
+   *
+   * @param[in]  p        Pointer to the serialized elements.
+   * @param[in]  n        Number of elements.
+   * @param[in]  as_view  Reference the memory instead of copying it.
+   */
+  void load(const char *p, std::size_t n, bool as_view) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable types can be serialized");
+    if (as_view) {
+      view(reinterpret_cast<const T *>(p), n);
+    } else {
+      _view = false;
+      _own.resize(n);
+      if (n > 0) {
+        std::memcpy(static_cast<void *>(_own.data()), p, n * sizeof(T));
+      }
+      sync();
+    }
+  }
+
+private:
+  /// Point to the owned elements unless this is a view.
+  void sync() {
+    if (!_view) {
+      _ptr = _own.data();
+      _n = _own.size();
+    }
+  }
+
+  std::vector<T> _own; ///< Owned elements
+  const T *_ptr;       ///< Pointer to the elements
+  std::size_t _n;      ///< Number of elements
+  bool _view;          ///< Whether the elements are owned elsewhere
+};
+
+/// Placeholder array for levels and edges without data.
+template <> class frozen_array<void> {
+public:
+  /// Always empty.
+  std::size_t size() const { return 0; }
+  /// No elements.
+  const void *data() const { return nullptr; }
+  /// No memory used.
+  std::size_t bytes() const { return 0; }
+  /// Nothing is serialized.
+  static constexpr std::size_t element_size = 0;
+  /// No type to record.
+  static constexpr std::uint32_t type_tag = 0;
+  /// Nothing to load.
+  void load(const char *, std::size_t, bool) {}
+};
+
+/**
+ * @brief      Contiguous array of the data stored on the simplices of a level.
+ *
+ * @tparam     DataType  Typename of the data.
+ */
+template <typename DataType> struct frozen_data {
+  /// Data of each simplex in level order.
+  frozen_array<DataType> values;
+
+  /**
+   * @brief      Append the data of a node.
+   *
+   * @param[in]  node  The node to copy from.
+   *
+   * @tparam     Node  Typename of the node.
+   */
+  template <typename Node> void push_node(const Node &node) {
+    values.push_back(node.data());
+  }
+
+  /// Bytes reserved by the array.
+  std::size_t bytes() const { return values.bytes(); }
+};
+
+/// Explicit specialization for levels without data.
+template <> struct frozen_data<void> {
+  /// Empty placeholder
+  frozen_array<void> values;
+  /// Nothing to store
+  template <typename Node> void push_node(const Node &) {}
+  /// No memory used.
+  std::size_t bytes() const { return 0; }
+};
+
+/**
+ * @brief      Contiguous array of the data stored on the down edges of a
+ *             level, parallel to the names.
+ *
+ * @tparam     KeyType   Typename of the keys.
+ * @tparam     DataType  Typename of the edge data.
+ */
+template <typename KeyType, typename DataType> struct frozen_edge_data {
+  /// Data of each edge in name order.
+  frozen_array<DataType> values;
+
+  /**
+   * @brief      Append the data of an edge of a node.
+   *
+   * @param[in]  node  The node to copy from.
+   * @param[in]  key   Key of the edge.
+   *
+   * @tparam     Node  Typename of the node.
+   */
+  template <typename Node> void push_node(const Node &node, KeyType key) {
+    values.push_back(node.edge_data(key));
+  }
+
+  /// Bytes reserved by the array.
+  std::size_t bytes() const { return values.bytes(); }
+};
+
+/// Explicit specialization for edges without data.
+template <typename KeyType> struct frozen_edge_data<KeyType, void> {
+  /// Empty placeholder
+  frozen_array<void> values;
+  /// Nothing to store
+  template <typename Node> void push_node(const Node &, KeyType) {}
+  /// No memory used.
+  std::size_t bytes() const { return 0; }
+};
+
+/**
+ * @brief      Storage of one simplex dimension of a frozen_complex.
+ *
+ * Simplices are numbered contiguously. The name and faces of simplex `i`
+ * are stored in `names[i*k, (i+1)*k)` and `down[i*k, (i+1)*k)`. Cofaces
+ * are stored in compressed sparse row form in `up_keys` and `up` over the
+ * range `[up_offsets[i], up_offsets[i+1])`, sorted by key.
+ *
+ * @tparam     KeyType   Typename of the keys.
+ * @tparam     Index     Integral type of the simplex indices.
+ * @tparam     NodeData  Typename of the data stored on the simplices.
+ * @tparam     EdgeData  Typename of the data stored on the down edges.
+ */
+template <typename KeyType, typename Index, typename NodeData,
+          typename EdgeData>
+struct frozen_level {
+  std::size_t count = 0;             ///< Number of simplices
+  frozen_array<KeyType> names;       ///< Sorted names
+  frozen_array<Index> down;          ///< Faces parallel to names
+  frozen_array<Index> up_offsets;    ///< Offsets into up_keys and up
+  frozen_array<KeyType> up_keys;     ///< Keys of the cofaces
+  frozen_array<Index> up;            ///< Cofaces parallel to up_keys
+  frozen_data<NodeData> data;        ///< Simplex data
+  frozen_edge_data<KeyType, EdgeData> edge_data; ///< Down edge data
+
+  /// Bytes owned by the level.
+  std::size_t bytes() const {
+    return names.bytes() + down.bytes() + up_offsets.bytes() +
+           up_keys.bytes() + up.bytes() + data.bytes() + edge_data.bytes();
+  }
+};
+/// Magic number at the start of a binary complex file.
+constexpr char binary_magic[8] = {'C', 'A', 'S', 'C', 'B', 'I', 'N', '\0'};
+/// Version of the binary layout written by this library.
+constexpr std::uint32_t binary_version = 2;
+/// Written in native byte order to detect foreign files.
+constexpr std::uint32_t binary_byte_order = 0x01020304;
+/// Alignment of every array in a binary complex file.
+constexpr std::size_t binary_alignment = 64;
+/// Number of arrays stored per level.
+constexpr std::size_t binary_arrays = 7;
+
+/// Fixed size header of a binary complex file.
+struct binary_header {
+  char magic[8];            ///< binary_magic
+  std::uint32_t version;    ///< binary_version
+  std::uint32_t byte_order; ///< binary_byte_order
+  std::uint32_t num_levels; ///< Number of levels of the complex
+  std::uint32_t key_size;   ///< sizeof(KeyType)
+  std::uint32_t index_size; ///< sizeof(Index)
+  std::uint32_t reserved;   ///< Zero
+};
+
+/// Location of one array within a binary complex file.
+struct binary_section {
+  std::uint64_t offset; ///< Byte offset from the start of the file
+  std::uint64_t count;  ///< Number of elements
+};
+
+/// Description of one level of a binary complex file.
+struct binary_level {
+  std::uint64_t count;          ///< Number of simplices
+  std::uint64_t data_size;      ///< sizeof(NodeData) or 0 if void
+  std::uint64_t edge_data_size; ///< sizeof(EdgeData) or 0 if void
+  std::uint32_t data_type;      ///< binary_type_tag of NodeData
+  std::uint32_t edge_data_type; ///< binary_type_tag of EdgeData
+  /// names, down, up_offsets, up_keys, up, data and edge data
+  binary_section sections[binary_arrays];
+};
+
+/// Round up to the alignment of the binary arrays.
+inline std::uint64_t binary_align(std::uint64_t n) {
+  return (n + binary_alignment - 1) / binary_alignment * binary_alignment;
+}
+} // end namespace frozen_detail
+/// @endcond
+
+/**
+ * @brief      A compact read-only snapshot of a simplicial_complex.
+ *
+ * The pointer based nodes of the complex are flattened into per level
+ * arrays of names, face indices, compressed sparse row coface tables and
+ * contiguous data. Simplices are identified by their integer position within
+ * their level, which follows the iteration order of the source complex.
+ *
+ * The read only interface mirrors simplicial_complex closely enough for
+ * generic algorithms such as visit_BFS_up(), visit_BFS_down(), getStar(),
+ * getClosure(), getLink(), neighbors() and SimplexSet to operate on a frozen
+ * complex directly.
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * auto frozen = casc::freeze(mesh);
+ * casc::SimplexSet<decltype(frozen)> star;
+ * auto v = frozen.get_simplex_up({1});
+ * casc::getStar(frozen, v, star);
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     Complex  Typename of the source simplicial_complex.
+ * @tparam     Index    Integral type used to store simplex indices.
+ */
+template <typename Complex, typename Index = std::uint32_t>
+class frozen_complex {
+public:
+  /// Typename of simplex keys.
+  using KeyType = typename Complex::KeyType;
+  /// Integral type of the simplex indices.
+  using IndexType = Index;
+  /// Type of this
+  using type_this = frozen_complex<Complex, Index>;
+  /// Total number of levels in the complex.
+  static constexpr std::size_t numLevels = Complex::numLevels;
+  /// Dimension of the simplicial complex.
+  static constexpr std::size_t topLevel = Complex::topLevel;
+  /// Dimension of boundaries.
+  static constexpr std::size_t bdryLevel = Complex::bdryLevel;
+  /// Index of all simplex dimensions in the complex.
+  using LevelIndex = typename Complex::LevelIndex;
+  /// Convenience alias for the user specified NodeData<k> typename
+  template <std::size_t k>
+  using NodeData = typename Complex::template NodeData<k>;
+  /// Convenience alias for the user specified EdgeData<k> typename
+  template <std::size_t k>
+  using EdgeData = typename Complex::template EdgeData<k>;
+
+  /// Container used by SimplexSet, the same as for the source complex.
+  template <typename T>
+  using SimplexSetContainer =
+      typename Complex::template SimplexSetContainer<T>;
+
+  /// Index of an invalid simplex.
+  static constexpr Index npos = std::numeric_limits<Index>::max();
+
+private:
+  /// Typename of the data stored on the down edges of level k.
+  template <std::size_t k, std::size_t foo = 0> struct down_edge_data {
+    /// Edges into k-simplices carry EdgeData<k-1>
+    using type = EdgeData<k - 1>;
+  };
+  /// The root has no down edges.
+  template <std::size_t foo> struct down_edge_data<0, foo> {
+    /// No storage
+    using type = void;
+  };
+
+  /// Storage for level k.
+  template <std::size_t k>
+  using Level =
+      frozen_detail::frozen_level<KeyType, Index, NodeData<k>,
+                                  typename down_edge_data<k>::type>;
+  /// Typename of a tuple of Level<k> for all k.
+  using LevelTuple =
+      typename util::int_type_map<std::size_t, std::tuple, LevelIndex,
+                                  Level>::type;
+
+public:
+  /**
+   * @brief      A handle for a simplex in a frozen_complex.
+   *
+   * @tparam     k     The simplex dimension.
+   */
+  template <std::size_t k> struct SimplexID {
+    /// Typename of the complex
+    using complex = frozen_complex<Complex, Index>;
+    /// SimplexID is a friend of the complex
+    friend complex;
+    /// The dimension of the simplex.
+    static constexpr std::size_t level = k;
+
+    /// Default constructor creates an invalid handle.
+    SimplexID() : F(nullptr), idx(npos) {}
+    /// An invalid handle, for comparisons against nullptr.
+    SimplexID(std::nullptr_t) : F(nullptr), idx(npos) {}
+
+    /// Equality of indices
+    friend bool operator==(SimplexID lhs, SimplexID rhs) {
+      return lhs.idx == rhs.idx;
+    }
+    /// Inequality of indices
+    friend bool operator!=(SimplexID lhs, SimplexID rhs) {
+      return lhs.idx != rhs.idx;
+    }
+    /// Compare indices
+    friend bool operator<=(SimplexID lhs, SimplexID rhs) {
+      return lhs.idx <= rhs.idx;
+    }
+    /// Compare indices
+    friend bool operator>=(SimplexID lhs, SimplexID rhs) {
+      return lhs.idx >= rhs.idx;
+    }
+    /// Compare indices
+    friend bool operator<(SimplexID lhs, SimplexID rhs) {
+      return lhs.idx < rhs.idx;
+    }
+    /// Compare indices
+    friend bool operator>(SimplexID lhs, SimplexID rhs) {
+      return lhs.idx > rhs.idx;
+    }
+
+    /// Support casting to uintptr_t for hashing.
+    explicit operator std::uintptr_t() const {
+      return static_cast<std::uintptr_t>(idx);
+    }
+
+    /// Position of the simplex within its level.
+    Index index() const { return idx; }
+
+    /// Dereferencing a SimplexID returns the data stored.
+    NodeData<k> const &operator*() const { return data(); }
+    /// Get a handle to the stored data.
+    NodeData<k> const &data() const {
+      return std::get<k>(F->_levels).data.values[idx];
+    }
+
+    /// Gets the name of the simplex as an std::array.
+    std::array<KeyType, k> indices() const { return F->get_name(*this); }
+
+    /**
+     * @brief      Print the simplex as its name.
+     *
+     * @param      out   Handle to the stream
+     * @param[in]  nid   SimplexID of interest
+     *
+     * @return     Handle to the stream
+     */
+    friend std::ostream &operator<<(std::ostream &out, const SimplexID &nid) {
+      out << "s{";
+      if (k == 0) {
+        out << "root";
+      }
+      for (std::size_t i = 0; i < k; ++i) {
+        out << (i == 0 ? "" : ",") << nid.name_begin()[i];
+      }
+      out << "}";
+      return out;
+    }
+
+  private:
+    /// Wrap an index into a level of F.
+    SimplexID(const complex *f, Index i) : F(f), idx(i) {}
+
+    /// Pointer to the first key of the name.
+    const KeyType *name_begin() const {
+      return std::get<k>(F->_levels).names.data() + std::size_t(idx) * k;
+    }
+
+    /// The owning complex
+    const complex *F;
+    /// Position within the level
+    Index idx;
+  };
+
+  /**
+   * @brief      Handle for an edge between a simplex and one of its faces.
+   *
+   * @tparam     k     The edge connects a simplex of size k-1 to a simplex
+   *                   of size k.
+   */
+  template <std::size_t k> struct EdgeID {
+    /// Typename of the complex
+    using complex = frozen_complex<Complex, Index>;
+    /// EdgeID is a friend of the complex
+    friend complex;
+    /// The dimension of the simplex which the edge points to.
+    static constexpr std::size_t level = k;
+
+    /// Default constructor creates an invalid handle.
+    EdgeID() : F(nullptr), idx(npos), pos(0) {}
+
+    /// Equality of simplices and edges
+    friend bool operator==(EdgeID lhs, EdgeID rhs) {
+      return lhs.idx == rhs.idx && lhs.pos == rhs.pos;
+    }
+    /// Inequality of simplices and edges
+    friend bool operator!=(EdgeID lhs, EdgeID rhs) { return !(lhs == rhs); }
+    /// Ordering of simplices and then edge keys.
+    friend bool operator<(EdgeID lhs, EdgeID rhs) {
+      return (lhs.idx < rhs.idx) || (lhs.idx == rhs.idx && lhs.pos < rhs.pos);
+    }
+    /// Greater than comparison
+    friend bool operator>(EdgeID lhs, EdgeID rhs) { return rhs < lhs; }
+
+    /// Dereferencing an EdgeID gets the data on the edge.
+    auto const &operator*() const { return data(); }
+    /// Return the data stored on the edge.
+    auto const &data() const {
+      return std::get<k>(F->_levels).edge_data.values[offset()];
+    }
+    /// Get the key of the edge.
+    KeyType key() const { return std::get<k>(F->_levels).names[offset()]; }
+    /// Get the coboundary simplex.
+    SimplexID<k> up() const { return F->template get_simplex_at<k>(idx); }
+    /// Get the simplex below.
+    SimplexID<k - 1> down() const {
+      return F->template get_simplex_at<k - 1>(
+          std::get<k>(F->_levels).down[offset()]);
+    }
+
+  private:
+    /// Wrap the edge of simplex i with the key at position p of its name.
+    EdgeID(const complex *f, Index i, std::size_t p) : F(f), idx(i), pos(p) {}
+    /// Offset of the edge in the level arrays.
+    std::size_t offset() const { return std::size_t(idx) * k + pos; }
+
+    /// The owning complex
+    const complex *F;
+    /// Index of the simplex up
+    Index idx;
+    /// Position of the key within the name
+    std::size_t pos;
+  };
+
+  /// Iterator over the SimplexIDs of a level.
+  template <std::size_t k>
+  struct id_iterator
+      : public std::iterator<std::random_access_iterator_tag, SimplexID<k>> {
+    /// Empty constructor
+    id_iterator() : F(nullptr), i(0) {}
+    /// Point to simplex j of F
+    id_iterator(const frozen_complex *f, Index j) : F(f), i(j) {}
+    /// Increment the iterator
+    id_iterator &operator++() {
+      ++i;
+      return *this;
+    }
+    /// Increment the iterator
+    id_iterator operator++(int) {
+      auto tmp = *this;
+      ++i;
+      return tmp;
+    }
+    /// Decrement the iterator
+    id_iterator &operator--() {
+      --i;
+      return *this;
+    }
+    /// Decrement the iterator
+    id_iterator operator--(int) {
+      auto tmp = *this;
+      --i;
+      return tmp;
+    }
+    /// Iterator equality comparison
+    bool operator==(id_iterator j) const { return i == j.i; }
+    /// Iterator inequality comparison
+    bool operator!=(id_iterator j) const { return i != j.i; }
+    /// Distance between iterators
+    std::ptrdiff_t operator-(id_iterator j) const {
+      return std::ptrdiff_t(i) - std::ptrdiff_t(j.i);
+    }
+    /// Dereferencing the iterator produces a SimplexID.
+    SimplexID<k> operator*() const {
+      return F->template get_simplex_at<k>(i);
+    }
+
+  private:
+    const frozen_complex *F; ///< The owning complex
+    Index i;                 ///< Current position
+  };
+
+  /// Construct an empty frozen complex.
+  frozen_complex() {}
+
+  /**
+   * @brief      Flatten a simplicial_complex.
+   *
+   * @param[in]  F     The complex to snapshot.
+   */
+  explicit frozen_complex(const Complex &F) {
+    std::array<std::vector<Index>, numLevels> slots;
+    util::int_for_each<std::size_t, LevelIndex>(NumberLevel(), F, slots);
+    util::int_for_each<std::size_t, LevelIndex>(FillLevel(), this, F, slots);
+  }
+
+  frozen_complex(const frozen_complex &) = default;
+  frozen_complex(frozen_complex &&) = default;
+  frozen_complex &operator=(const frozen_complex &) = default;
+  frozen_complex &operator=(frozen_complex &&) = default;
+
+  /**
+   * @brief      Get the number of simplices of dimension 'k'.
+   *
+   * @tparam     k     The dimension of interest.
+   *
+   * @return     Integer number of k-simplices in the complex.
+   */
+  template <std::size_t k> std::size_t size() const {
+    return std::get<k>(_levels).count;
+  }
+
+  /**
+   * @brief      Get the number of bytes used to store the complex.
+   *
+   * @return     Total capacity of all arrays in bytes.
+   */
+  std::size_t bytes() const {
+    std::size_t rval = sizeof(*this);
+    util::int_for_each<std::size_t, LevelIndex>(LevelBytes(), this, rval);
+    return rval;
+  }
+
+  /**
+   * @brief      Get the simplex at a position within its level.
+   *
+   * @param[in]  i     Index of the simplex.
+   *
+   * @tparam     k     The dimension of the simplex.
+   *
+   * @return     SimplexID of the i-th k-simplex.
+   */
+  template <std::size_t k> SimplexID<k> get_simplex_at(Index i) const {
+    assert(i < size<k>());
+    return SimplexID<k>(this, i);
+  }
+
+  /**
+   * @brief      Get the number of slots of dimension 'k'.
+   *
+   * Frozen levels have no holes, so this equals size<k>(). It exists for
+   * algorithms written against simplicial_complex::slots().
+   *
+   * @tparam     k     The dimension of interest.
+   *
+   * @return     Number of slots.
+   */
+  template <std::size_t k> std::size_t slots() const { return size<k>(); }
+
+  /**
+   * @brief      Create a range over the SimplexIDs of a dimension.
+   *
+   * @tparam     k     The simplex dimension to traverse.
+   *
+   * @return     A range across all k-simplices of the complex.
+   */
+  template <std::size_t k> auto get_level_id() const {
+    return util::make_range(id_iterator<k>(this, 0),
+                            id_iterator<k>(this, Index(size<k>())));
+  }
+
+  /**
+   * @brief      Create a range over the simplex data of a dimension.
+   *
+   * @tparam     k     The simplex dimension to traverse.
+   *
+   * @return     A range across the data of all k-simplices.
+   */
+  template <std::size_t k> auto get_level() const {
+    const auto &values = std::get<k>(_levels).data.values;
+    return util::make_range(values.cbegin(), values.cend());
+  }
+
+  /**
+   * @brief      Get the root simplex.
+   *
+   * @return     The root simplex.
+   */
+  SimplexID<0> get_simplex_up() const { return SimplexID<0>(this, 0); }
+
+  /// Get the root simplex.
+  SimplexID<0> get_simplex_down() const { return SimplexID<0>(this, 0); }
+
+  /**
+   * @brief      Gets the simplex with name 's'.
+   *
+   * @param[in]  s     Name of the simplex to find.
+   *
+   * @tparam     n     Dimension of simplex s.
+   *
+   * @return     SimplexID of the simplex or nullptr if not present.
+   */
+  template <std::size_t n>
+  SimplexID<n> get_simplex_up(const KeyType (&s)[n]) const {
+    return find_up<0, n>::apply(this, s, 0);
+  }
+
+  /// @copydoc get_simplex_up(const KeyType (&)[n]) const
+  template <std::size_t n>
+  SimplexID<n> get_simplex_up(const std::array<KeyType, n> &arr) const {
+    return find_up<0, n>::apply(this, arr.data(), 0);
+  }
+
+  /**
+   * @brief      Get the simplex \f$id\cup s\f$.
+   *
+   * @param[in]  id    The identifier of a simplex.
+   * @param[in]  s     The relative name of the desired simplex.
+   *
+   * @tparam     i     The size of simplex 'id'.
+   * @tparam     j     The length of the name 's'.
+   *
+   * @return     SimplexID of the coface or nullptr if not present.
+   */
+  template <std::size_t i, std::size_t j>
+  SimplexID<i + j> get_simplex_up(const SimplexID<i> id,
+                                  const KeyType (&s)[j]) const {
+    return find_up<i, j>::apply(this, s, id.idx);
+  }
+
+  /**
+   * @brief      Convenience version of get_simplex_up when the name 's'
+   *             consists of a single key.
+   *
+   * @param[in]  id    The identifier of a simplex.
+   * @param[in]  s     The key to add.
+   *
+   * @tparam     i     The size of simplex 'id'.
+   *
+   * @return     SimplexID of the coface or nullptr if not present.
+   */
+  template <std::size_t i>
+  SimplexID<i + 1> get_simplex_up(const SimplexID<i> id,
+                                  const KeyType s) const {
+    return find_up<i, 1>::apply(this, &s, id.idx);
+  }
+
+  /**
+   * @brief      Get the face of 'id' which does not have 's' in the name.
+   *
+   * @param[in]  id    The identifier of a simplex.
+   * @param[in]  s     The key to remove.
+   *
+   * @tparam     i     The size of simplex 'id'.
+   *
+   * @return     The face or nullptr if 's' is not in the name of 'id'.
+   */
+  template <std::size_t i>
+  SimplexID<i - 1> get_simplex_down(const SimplexID<i> id,
+                                    const KeyType s) const {
+    const auto &lvl = std::get<i>(_levels);
+    std::size_t p = key_position<i>(id.idx, s);
+    if (p == i) {
+      return SimplexID<i - 1>();
+    }
+    return SimplexID<i - 1>(this, lvl.down[std::size_t(id.idx) * i + p]);
+  }
+
+  /**
+   * @brief      Get the face of 'id' which does not have the keys 's'.
+   *
+   * @param[in]  id    The identifier of a simplex.
+   * @param[in]  s     The keys to remove.
+   *
+   * @tparam     i     The size of simplex 'id'.
+   * @tparam     j     The number of keys to remove.
+   *
+   * @return     The face or nullptr if not present.
+   */
+  template <std::size_t i, std::size_t j>
+  SimplexID<i - j> get_simplex_down(const SimplexID<i> id,
+                                    const KeyType (&s)[j]) const {
+    return find_down<i, j>::apply(this, s, id);
+  }
+
+  /**
+   * @brief      Apply a lambda function the name of a simplex.
+   *
+   * @param[in]  id      SimplexID of the simplex of interest.
+   * @param[in]  fn      Lambda function to apply to each key of the name.
+   *
+   * @tparam     n       Dimension of simplex 'id'.
+   * @tparam     Lambda  Functor which supports operator(KeyType).
+   */
+  template <std::size_t n, typename Lambda>
+  void get_name(SimplexID<n> id, Lambda fn) const {
+    const KeyType *name = id.name_begin();
+    for (std::size_t i = 0; i < n; ++i) {
+      fn(name[i]);
+    }
+  }
+
+  /**
+   * @brief      Gets the name of a simplex as an std::array.
+   *
+   * @param[in]  id    SimplexID of the simplex of interest.
+   *
+   * @tparam     n     Size of the simplex referenced by 'id'.
+   *
+   * @return     Array containing the name of 'id'.
+   */
+  template <std::size_t n>
+  std::array<KeyType, n> get_name(SimplexID<n> id) const {
+    std::array<KeyType, n> s;
+    std::copy(id.name_begin(), id.name_begin() + n, s.begin());
+    return s;
+  }
+
+  /**
+   * @brief      Apply a lambda function to the coboundary keys.
+   *
+   * @param[in]  id      The identifier of a simplex.
+   * @param[in]  fn      The function
+   *
+   * @tparam     k       The dimension of the simplex.
+   * @tparam     Lambda  Functor which supports operator(KeyType).
+   */
+  template <std::size_t k, class Lambda>
+  void get_cover(const SimplexID<k> id, Lambda fn) const {
+    const auto &lvl = std::get<k>(_levels);
+    for (Index i = lvl.up_offsets[id.idx]; i < lvl.up_offsets[id.idx + 1];
+         ++i) {
+      fn(lvl.up_keys[i]);
+    }
+  }
+
+  /**
+   * @brief      Insert the coboundary keys of a simplex into an inserter.
+   *
+   * @param[in]  id        The identifier of a simplex.
+   * @param[in]  pos       Iterator inserter
+   *
+   * @tparam     k         The dimension of the simplex.
+   * @tparam     Inserter  Typename of the inserter.
+   */
+  template <std::size_t k, class Inserter>
+  void get_cover_insert(const SimplexID<k> id, Inserter pos) const {
+    get_cover(id, [&pos](KeyType a) { *pos++ = a; });
+  }
+
+  /**
+   * @brief      Get the coboundary keys of a simplex.
+   *
+   * @param[in]  id    The identifier of a simplex.
+   *
+   * @tparam     k     The dimension of the simplex.
+   *
+   * @return     A vector of coboundary keys.
+   */
+  template <std::size_t k>
+  std::vector<KeyType> get_cover(const SimplexID<k> id) const {
+    std::vector<KeyType> rval;
+    get_cover_insert(id, std::back_inserter(rval));
+    return rval;
+  }
+
+  /**
+   * @brief      Iterate over the coboundary keys of a simplex in place.
+   *
+   * @param[in]  id    The identifier of a simplex.
+   *
+   * @tparam     k     The dimension of the simplex.
+   *
+   * @return     A range over the coboundary keys.
+   */
+  template <std::size_t k>
+  util::range<const KeyType *> cover_view(const SimplexID<k> id) const {
+    const auto &lvl = std::get<k>(_levels);
+    const KeyType *keys = lvl.up_keys.data();
+    return util::range<const KeyType *>(keys + lvl.up_offsets[id.idx],
+                                        keys + lvl.up_offsets[id.idx + 1]);
+  }
+
+  /**
+   * @brief      Gets the edge up from a simplex.
+   *
+   * @param[in]  simplex  The simplex of interest.
+   * @param[in]  a        Key of the edge to get.
+   *
+   * @tparam     k        The level of the simplex of interest
+   *
+   * @return     The edge up.
+   */
+  template <std::size_t k>
+  EdgeID<k + 1> get_edge_up(SimplexID<k> simplex, KeyType a) const {
+    auto up = get_simplex_up(simplex, a);
+    if (up == nullptr) {
+      throw std::out_of_range("Could not find coface in frozen_complex.");
+    }
+    return EdgeID<k + 1>(this, up.idx, key_position<k + 1>(up.idx, a));
+  }
+
+  /**
+   * @brief      Gets the edge down from a simplex.
+   *
+   * @param[in]  simplex  The simplex of interest.
+   * @param[in]  a        Key of the edge to get.
+   *
+   * @tparam     k        The level of the simplex of interest
+   *
+   * @return     The edge down.
+   */
+  template <std::size_t k>
+  EdgeID<k> get_edge_down(SimplexID<k> simplex, KeyType a) const {
+    return EdgeID<k>(this, simplex.idx, key_position<k>(simplex.idx, a));
+  }
+
+  /**
+   * @brief      Check whether a simplex with some name exists.
+   *
+   * @param[in]  s     C-style array of the name
+   *
+   * @tparam     k     The dimension of the simplex.
+   *
+   * @return     True if the simplex is in the complex.
+   */
+  template <std::size_t k> bool exists(const KeyType (&s)[k]) const {
+    return get_simplex_up(s) != nullptr;
+  }
+
+  /**
+   * @brief      Rebuild a mutable simplicial_complex from the snapshot.
+   *
+   * @return     A complex with the same simplices and data.
+   */
+  Complex thaw() const {
+    Complex F;
+    util::int_for_each<std::size_t, LevelIndex>(ThawLevel(), this, F);
+    return F;
+  }
+
+  /**
+   * @brief      Write the snapshot in the binary complex format.
+   *
+   * The file starts with a fixed header and a table describing every
+   * level, followed by the raw arrays of each level, each aligned to 64
+   * bytes so that the file can be memory mapped and used in place. Data
+   * types must be trivially copyable. The format stores native byte order
+   * and sizes, which are checked when reading.
+   *
+   * @param      out   Binary stream to write to.
+   */
+  void write(std::ostream &out) const {
+    static_assert(std::is_trivially_copyable<KeyType>::value,
+                  "Only trivially copyable keys can be serialized");
+    frozen_detail::binary_header header = make_header();
+    BinaryTable table;
+    std::uint64_t offset =
+        frozen_detail::binary_align(sizeof(header) + sizeof(table));
+    util::int_for_each<std::size_t, LevelIndex>(DescribeLevel(), this, table,
+                                                offset);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(table.data()), sizeof(table));
+    std::uint64_t pos = sizeof(header) + sizeof(table);
+    util::int_for_each<std::size_t, LevelIndex>(WriteLevel(), this, table,
+                                                out, pos);
+    if (!out) {
+      throw std::runtime_error("Failed to write binary complex.");
+    }
+  }
+
+  /**
+   * @brief      Read a snapshot in the binary complex format.
+   *
+   * The arrays are copied into memory owned by the snapshot.
+   *
+   * @param      in    Binary stream to read from.
+   *
+   * @return     The snapshot.
+   */
+  static frozen_complex read(std::istream &in) {
+    std::string buffer((std::istreambuf_iterator<char>(in)),
+                       std::istreambuf_iterator<char>());
+    return parse(buffer.data(), buffer.size(), false);
+  }
+
+  /**
+   * @brief      Memory map a file in the binary complex format.
+   *
+   * The arrays of the snapshot reference the mapped pages directly so
+   * opening is O(levels) regardless of the size of the complex. The mapping
+   * is shared by all copies of the snapshot and released with the last one.
+   * On platforms without mmap the file is read instead.
+   *
+   * @param[in]  filename  The file to map.
+   *
+   * @return     The snapshot.
+   */
+  static frozen_complex map(const std::string &filename) {
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Could not open binary complex " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      throw std::runtime_error("Could not map binary complex " + filename);
+    }
+    const std::size_t size = st.st_size;
+    void *p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      throw std::runtime_error("Could not map binary complex " + filename);
+    }
+    std::shared_ptr<const void> storage(
+        p, [size](const void *q) { ::munmap(const_cast<void *>(q), size); });
+    frozen_complex rval = parse(static_cast<const char *>(p), size, true);
+    rval._storage = std::move(storage);
+    return rval;
+#else
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+      throw std::runtime_error("Could not open binary complex " + filename);
+    }
+    return read(in);
+#endif
+  }
+
+private:
+  /**
+   * @brief      Find the position of a key within the name of a simplex.
+   *
+   * @param[in]  i     Index of the simplex.
+   * @param[in]  key   The key to find.
+   *
+   * @tparam     k     Dimension of the simplex.
+   *
+   * @return     The position or k if the key is not in the name.
+   */
+  template <std::size_t k>
+  std::size_t key_position(Index i, KeyType key) const {
+    const KeyType *name =
+        std::get<k>(_levels).names.data() + std::size_t(i) * k;
+    return std::find(name, name + k, key) - name;
+  }
+
+  /**
+   * @brief      Find a coface via the sorted CSR coface table.
+   *
+   * @param[in]  i     Index of the simplex.
+   * @param[in]  key   The key to add.
+   *
+   * @tparam     k     Dimension of the simplex.
+   *
+   * @return     Index of the coface or npos.
+   */
+  template <std::size_t k> Index coface(Index i, KeyType key) const {
+    const auto &lvl = std::get<k>(_levels);
+    auto b = lvl.up_keys.begin() + lvl.up_offsets[i];
+    auto e = lvl.up_keys.begin() + lvl.up_offsets[i + 1];
+    auto it = std::lower_bound(b, e, key);
+    return (it != e && *it == key) ? lvl.up[it - lvl.up_keys.begin()] : npos;
+  }
+
+  /**
+   * @brief      Recursively follow coface tables.
+   *
+   * @tparam     level  Dimension of the current simplex.
+   * @tparam     n      Number of keys left to follow.
+   */
+  template <std::size_t level, std::size_t n> struct find_up {
+    /**
+     * @brief      Follow the next key.
+     *
+     * @param[in]  that  The frozen complex.
+     * @param[in]  s     Keys to follow.
+     * @param[in]  i     Index of the current simplex.
+     *
+     * @return     The simplex found or nullptr.
+     */
+    static SimplexID<level + n> apply(const type_this *that, const KeyType *s,
+                                      Index i) {
+      Index next = that->template coface<level>(i, *s);
+      if (next == npos) {
+        return SimplexID<level + n>();
+      }
+      return find_up<level + 1, n - 1>::apply(that, s + 1, next);
+    }
+  };
+
+  /**
+   * @brief      Terminal case of find_up.
+   *
+   * @tparam     level  Dimension of the simplex found.
+   */
+  template <std::size_t level> struct find_up<level, 0> {
+    /**
+     * @brief      Wrap the simplex found.
+     *
+     * @param[in]  that  The frozen complex.
+     * @param[in]  i     Index of the simplex.
+     *
+     * @return     The SimplexID.
+     */
+    static SimplexID<level> apply(const type_this *that, const KeyType *,
+                                  Index i) {
+      return SimplexID<level>(that, i);
+    }
+  };
+
+  /**
+   * @brief      Recursively follow faces.
+   *
+   * @tparam     level  Dimension of the current simplex.
+   * @tparam     n      Number of keys left to remove.
+   */
+  template <std::size_t level, std::size_t n> struct find_down {
+    /**
+     * @brief      Remove the next key.
+     *
+     * @param[in]  that  The frozen complex.
+     * @param[in]  s     Keys to remove.
+     * @param[in]  id    The current simplex.
+     *
+     * @return     The simplex found or nullptr.
+     */
+    static SimplexID<level - n> apply(const type_this *that, const KeyType *s,
+                                      SimplexID<level> id) {
+      auto next = that->get_simplex_down(id, *s);
+      if (next == nullptr) {
+        return SimplexID<level - n>();
+      }
+      return find_down<level - 1, n - 1>::apply(that, s + 1, next);
+    }
+  };
+
+  /**
+   * @brief      Terminal case of find_down.
+   *
+   * @tparam     level  Dimension of the simplex found.
+   */
+  template <std::size_t level> struct find_down<level, 0> {
+    /// Return the simplex found.
+    static SimplexID<level> apply(const type_this *, const KeyType *,
+                                  SimplexID<level> id) {
+      return id;
+    }
+  };
+
+  /// Assign a contiguous index to each node of the source complex.
+  struct NumberLevel {
+    /**
+     * @brief      Map the registry slots of level k to indices.
+     *
+     * @param[in]  F      The source complex.
+     * @param      slots  Per level maps from registry slot to index.
+     *
+     * @tparam     k      The level to number.
+     */
+    template <std::size_t k>
+    static void apply(const Complex &F,
+                      std::array<std::vector<Index>, numLevels> &slots) {
+      const auto &reg = std::get<k>(F.levels);
+      if (reg.size() >= std::size_t(npos)) {
+        throw std::overflow_error(
+            "Too many simplices for the frozen_complex index type.");
+      }
+      slots[k].assign(reg.slots(), npos);
+      Index i = 0;
+      for (auto node : reg) {
+        slots[k][node->_slot] = i++;
+      }
+    }
+  };
+
+  /// Copy the names and faces of level k.
+  template <std::size_t k, std::size_t foo> struct fill_down {
+    /**
+     * @brief      Append the name, faces and edge data of a node.
+     *
+     * @param      lvl    The level to fill.
+     * @param[in]  node   The source node.
+     * @param[in]  slots  Per level maps from registry slot to index.
+     *
+     * @tparam     Node   Typename of the node.
+     */
+    template <typename Node>
+    static void apply(Level<k> &lvl, const Node &node,
+                      const std::array<std::vector<Index>, numLevels> &slots) {
+      for (auto curr : node._down) {
+        lvl.names.push_back(curr.first);
+        lvl.down.push_back(slots[k - 1][curr.second->_slot]);
+        lvl.edge_data.push_node(node, curr.first);
+      }
+    }
+  };
+
+  /// The root has no faces.
+  template <std::size_t foo> struct fill_down<0, foo> {
+    /// Nothing to fill.
+    template <typename Node>
+    static void apply(Level<0> &, const Node &,
+                      const std::array<std::vector<Index>, numLevels> &) {}
+  };
+
+  /// Copy the cofaces of level k.
+  template <std::size_t k, std::size_t foo> struct fill_up {
+    /**
+     * @brief      Append the cofaces of a node.
+     *
+     * @param      lvl    The level to fill.
+     * @param[in]  node   The source node.
+     * @param[in]  slots  Per level maps from registry slot to index.
+     *
+     * @tparam     Node   Typename of the node.
+     */
+    template <typename Node>
+    static void apply(Level<k> &lvl, const Node &node,
+                      const std::array<std::vector<Index>, numLevels> &slots) {
+      for (auto curr : node._up) {
+        lvl.up_keys.push_back(curr.first);
+        lvl.up.push_back(slots[k + 1][curr.second->_slot]);
+      }
+      lvl.up_offsets.push_back(Index(lvl.up.size()));
+    }
+  };
+
+  /// Facets have no cofaces.
+  template <std::size_t foo> struct fill_up<topLevel, foo> {
+    /// Only record an empty range.
+    template <typename Node>
+    static void apply(Level<topLevel> &lvl, const Node &,
+                      const std::array<std::vector<Index>, numLevels> &) {
+      lvl.up_offsets.push_back(0);
+    }
+  };
+
+  /// Copy all nodes of a level of the source complex.
+  struct FillLevel {
+    /**
+     * @brief      Flatten level k.
+     *
+     * @param      that   The frozen complex to fill.
+     * @param[in]  F      The source complex.
+     * @param[in]  slots  Per level maps from registry slot to index.
+     *
+     * @tparam     k      The level to flatten.
+     */
+    template <std::size_t k>
+    static void apply(type_this *that, const Complex &F,
+                      const std::array<std::vector<Index>, numLevels> &slots) {
+      const auto &reg = std::get<k>(F.levels);
+      auto &lvl = std::get<k>(that->_levels);
+      lvl.count = reg.size();
+      lvl.names.reserve(lvl.count * k);
+      lvl.down.reserve(lvl.count * k);
+      lvl.up_offsets.reserve(lvl.count + 1);
+      lvl.up_offsets.push_back(0);
+      for (auto node : reg) {
+        fill_down<k, 0>::apply(lvl, *node, slots);
+        fill_up<k, 0>::apply(lvl, *node, slots);
+        lvl.data.push_node(*node);
+      }
+      lvl.up_keys.shrink_to_fit();
+      lvl.up.shrink_to_fit();
+    }
+  };
+
+  /// Accumulate the bytes used per level.
+  struct LevelBytes {
+    /// Add the bytes of level k to rval.
+    template <std::size_t k>
+    static void apply(const type_this *that, std::size_t &rval) {
+      rval += std::get<k>(that->_levels).bytes();
+    }
+  };
+
+  /// Table of level descriptions in a binary file.
+  using BinaryTable = std::array<frozen_detail::binary_level, numLevels>;
+
+  /**
+   * @brief      Apply a function to each serialized array of a level.
+   *
+   * @param      lvl   The level.
+   * @param[in]  fn    Functor called as fn(position, array).
+   *
+   * @tparam     L     Typename of the (const) level.
+   * @tparam     Fn    Typename of the functor.
+   */
+  template <typename L, typename Fn> static void for_each_array(L &lvl, Fn fn) {
+    fn(0, lvl.names);
+    fn(1, lvl.down);
+    fn(2, lvl.up_offsets);
+    fn(3, lvl.up_keys);
+    fn(4, lvl.up);
+    fn(5, lvl.data.values);
+    fn(6, lvl.edge_data.values);
+  }
+
+  /// Header describing this type of complex.
+  static frozen_detail::binary_header make_header() {
+    frozen_detail::binary_header header;
+    std::memcpy(header.magic, frozen_detail::binary_magic,
+                sizeof(header.magic));
+    header.version = frozen_detail::binary_version;
+    header.byte_order = frozen_detail::binary_byte_order;
+    header.num_levels = numLevels;
+    header.key_size = sizeof(KeyType);
+    header.index_size = sizeof(Index);
+    header.reserved = 0;
+    return header;
+  }
+
+  /**
+   * @brief      Build a snapshot from a binary complex in memory.
+   *
+   * @param[in]  base     Start of the binary complex.
+   * @param[in]  size     Size of the binary complex in bytes.
+   * @param[in]  as_view  Reference the memory instead of copying it.
+   *
+   * @return     The snapshot.
+   */
+  static frozen_complex parse(const char *base, std::size_t size,
+                              bool as_view) {
+    frozen_detail::binary_header header;
+    BinaryTable table;
+    if (size < sizeof(header) + sizeof(table)) {
+      throw std::runtime_error("Truncated binary complex.");
+    }
+    std::memcpy(&header, base, sizeof(header));
+    const auto expected = make_header();
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0) {
+      throw std::runtime_error("Not a binary complex.");
+    }
+    if (header.version != expected.version) {
+      throw std::runtime_error("Unsupported binary complex version.");
+    }
+    if (header.byte_order != expected.byte_order ||
+        header.num_levels != expected.num_levels ||
+        header.key_size != expected.key_size ||
+        header.index_size != expected.index_size) {
+      throw std::runtime_error(
+          "Binary complex does not match the type of the complex.");
+    }
+    std::memcpy(table.data(), base + sizeof(header), sizeof(table));
+    frozen_complex rval;
+    util::int_for_each<std::size_t, LevelIndex>(LoadLevel(), &rval, table,
+                                                base, size, as_view);
+    return rval;
+  }
+
+  /// Compute the location of the arrays of each level.
+  struct DescribeLevel {
+    /**
+     * @brief      Describe level k.
+     *
+     * @param[in]  that    The frozen complex.
+     * @param      table   The table to fill.
+     * @param      offset  Offset of the next array in the file.
+     *
+     * @tparam     k       The level to describe.
+     */
+    template <std::size_t k>
+    static void apply(const type_this *that, BinaryTable &table,
+                      std::uint64_t &offset) {
+      const auto &lvl = std::get<k>(that->_levels);
+      auto &entry = table[k];
+      entry.count = lvl.count;
+      entry.data_size = lvl.data.values.element_size;
+      entry.edge_data_size = lvl.edge_data.values.element_size;
+      entry.data_type = lvl.data.values.type_tag;
+      entry.edge_data_type = lvl.edge_data.values.type_tag;
+      for_each_array(lvl, [&](std::size_t i, const auto &arr) {
+        entry.sections[i].offset = offset;
+        entry.sections[i].count = arr.size();
+        offset = frozen_detail::binary_align(offset +
+                                             arr.size() * arr.element_size);
+      });
+    }
+  };
+
+  /// Write the arrays of each level.
+  struct WriteLevel {
+    /**
+     * @brief      Write level k.
+     *
+     * @param[in]  that   The frozen complex.
+     * @param[in]  table  The table of array locations.
+     * @param      out    The stream to write to.
+     * @param      pos    Current position in the stream.
+     *
+     * @tparam     k      The level to write.
+     */
+    template <std::size_t k>
+    static void apply(const type_this *that, const BinaryTable &table,
+                      std::ostream &out, std::uint64_t &pos) {
+      const auto &lvl = std::get<k>(that->_levels);
+      for_each_array(lvl, [&](std::size_t i, const auto &arr) {
+        const auto &section = table[k].sections[i];
+        for (; pos < section.offset; ++pos) {
+          out.put('\0');
+        }
+        const std::size_t bytes = arr.size() * arr.element_size;
+        if (bytes > 0) {
+          out.write(static_cast<const char *>(
+                        static_cast<const void *>(arr.data())),
+                    bytes);
+          pos += bytes;
+        }
+      });
+    }
+  };
+
+  /// Read the arrays of each level.
+  struct LoadLevel {
+    /**
+     * @brief      Load level k.
+     *
+     * @param      that     The frozen complex to fill.
+     * @param[in]  table    The table of array locations.
+     * @param[in]  base     Start of the binary complex.
+     * @param[in]  size     Size of the binary complex.
+     * @param[in]  as_view  Reference the memory instead of copying it.
+     *
+     * @tparam     k        The level to load.
+     */
+    template <std::size_t k>
+    static void apply(type_this *that, const BinaryTable &table,
+                      const char *base, std::size_t size, bool as_view) {
+      auto &lvl = std::get<k>(that->_levels);
+      const auto &entry = table[k];
+      if (entry.data_size != lvl.data.values.element_size ||
+          entry.edge_data_size != lvl.edge_data.values.element_size ||
+          entry.data_type != lvl.data.values.type_tag ||
+          entry.edge_data_type != lvl.edge_data.values.type_tag) {
+        throw std::runtime_error(
+            "Binary complex does not match the data types of the complex.");
+      }
+      lvl.count = entry.count;
+      for_each_array(lvl, [&](std::size_t i, auto &arr) {
+        const auto &section = entry.sections[i];
+        const std::uint64_t bytes = section.count * arr.element_size;
+        if (section.offset % frozen_detail::binary_alignment != 0 ||
+            section.offset > size || bytes > size - section.offset) {
+          throw std::runtime_error("Corrupt binary complex.");
+        }
+        arr.load(base + section.offset, section.count, as_view);
+      });
+      const std::size_t n = lvl.count;
+      if (lvl.names.size() != n * k || lvl.down.size() != n * k ||
+          lvl.up_offsets.size() != n + 1 ||
+          lvl.up_keys.size() != lvl.up.size() ||
+          lvl.up_offsets[n] != lvl.up.size() ||
+          lvl.data.values.size() != (entry.data_size ? n : 0) ||
+          lvl.edge_data.values.size() != (entry.edge_data_size ? n * k : 0)) {
+        throw std::runtime_error("Corrupt binary complex.");
+      }
+      // Indices must refer to simplices of the adjacent levels
+      const std::uint64_t down_count = k > 0 ? table[k - 1].count : 0;
+      const std::uint64_t up_count = k + 1 < numLevels ? table[k + 1].count : 0;
+      const auto below = [](std::uint64_t bound) {
+        return [bound](Index i) { return std::uint64_t(i) < bound; };
+      };
+      if (lvl.up_offsets[0] != 0 ||
+          !std::is_sorted(lvl.up_offsets.begin(), lvl.up_offsets.end()) ||
+          !std::all_of(lvl.down.begin(), lvl.down.end(), below(down_count)) ||
+          !std::all_of(lvl.up.begin(), lvl.up.end(), below(up_count))) {
+        throw std::runtime_error("Corrupt binary complex.");
+      }
+    }
+  };
+
+  /// Rebuild the simplices of each level in a mutable complex.
+  struct ThawLevel {
+    /**
+     * @brief      Insert the simplices of level k with their data.
+     *
+     * @param[in]  that  The frozen complex.
+     * @param      F     The complex to fill.
+     *
+     * @tparam     k     The level to insert.
+     */
+    template <std::size_t k>
+    static void apply(const type_this *that, Complex &F) {
+      thaw_level<k, 0>::apply(that, F);
+    }
+  };
+
+  /// Insert the simplices of level k.
+  template <std::size_t k, std::size_t foo> struct thaw_level {
+    /**
+     * @brief      Insert the simplices of level k.
+     *
+     * @param[in]  that  The frozen complex.
+     * @param      F     The complex to fill.
+     */
+    static void apply(const type_this *that, Complex &F) {
+      const auto &lvl = std::get<k>(that->_levels);
+      F.template bulk_insert<k>(lvl.names.data(), lvl.count,
+                                lvl.data.values.data());
+      thaw_edges(that, F, std::is_void<typename down_edge_data<k>::type>());
+    }
+
+    /// Assign the data of the down edges.
+    static void thaw_edges(const type_this *that, Complex &F,
+                           std::false_type) {
+      const auto &lvl = std::get<k>(that->_levels);
+      for (std::size_t i = 0; i < lvl.count; ++i) {
+        std::array<KeyType, k> name;
+        std::copy(lvl.names.data() + i * k, lvl.names.data() + (i + 1) * k,
+                  name.begin());
+        auto id = F.get_simplex_up(name);
+        for (std::size_t m = 0; m < k; ++m) {
+          *F.get_edge_down(id, name[m]) = lvl.edge_data.values[i * k + m];
+        }
+      }
+    }
+
+    /// Nothing to assign for edges without data.
+    static void thaw_edges(const type_this *, Complex &, std::true_type) {}
+  };
+
+  /// Copy the data of the root.
+  template <std::size_t foo> struct thaw_level<0, foo> {
+    /**
+     * @brief      Copy the data of the root.
+     *
+     * @param[in]  that  The frozen complex.
+     * @param      F     The complex to fill.
+     */
+    static void apply(const type_this *that, Complex &F) {
+      thaw_root(that, F, std::is_void<NodeData<0>>());
+    }
+
+    /// Copy the data of the root.
+    static void thaw_root(const type_this *that, Complex &F, std::false_type) {
+      const auto &lvl = std::get<0>(that->_levels);
+      if (lvl.count > 0) {
+        *F.get_simplex_up() = lvl.data.values[0];
+      }
+    }
+
+    /// Nothing to copy for a root without data.
+    static void thaw_root(const type_this *, Complex &, std::true_type) {}
+  };
+
+  /// Per level storage.
+  LevelTuple _levels;
+  /// Keeps memory referenced by the levels, such as a file mapping, alive.
+  std::shared_ptr<const void> _storage;
+};
+
+/// Out of class definition of the invalid index.
+template <typename Complex, typename Index>
+constexpr Index frozen_complex<Complex, Index>::npos;
+
+/**
+ * @brief      Create a compact read-only snapshot of a complex.
+ *
+ * @param[in]  F        The complex to freeze.
+ *
+ * @tparam     Complex  Typename of the simplicial_complex.
+ * @tparam     Index    Integral type used to store simplex indices.
+ *
+ * @return     The frozen complex.
+ */
+template <typename Complex, typename Index = std::uint32_t>
+frozen_complex<Complex, Index> freeze(const Complex &F) {
+  return frozen_complex<Complex, Index>(F);
+}
+
+/**
+ * @brief      Write a frozen complex to a file in the binary complex format.
+ *
+ * @param[in]  filename  The file to write.
+ * @param[in]  F         The frozen complex.
+ *
+ * @tparam     Complex   Typename of the source simplicial_complex.
+ * @tparam     Index     Integral type used to store simplex indices.
+ */
+template <typename Complex, typename Index>
+void writeBinary(const std::string &filename,
+                 const frozen_complex<Complex, Index> &F) {
+  std::ofstream out(filename, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Could not open " + filename);
+  }
+  F.write(out);
+}
+
+/**
+ * @brief      Write a simplicial_complex to a file in the binary complex
+ *             format.
+ *
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::writeBinary("mesh.casc", mesh);
+ * auto restored = casc::readBinary<SurfaceMesh>("mesh.casc");
+ * auto mapped = casc::mapBinary<SurfaceMesh>("mesh.casc");
+ * ~~~~~~~~~~~~~~~
+ *
+ * @param[in]  filename  The file to write.
+ * @param[in]  F         The complex.
+ *
+ * @tparam     Complex   Typename of the simplicial_complex.
+ */
+template <typename Complex>
+void writeBinary(const std::string &filename, const Complex &F) {
+  writeBinary(filename, freeze(F));
+}
+
+/**
+ * @brief      Read a simplicial_complex from a file in the binary complex
+ *             format.
+ *
+ * @param[in]  filename  The file to read.
+ *
+ * @tparam     Complex   Typename of the simplicial_complex.
+ *
+ * @return     The restored complex.
+ */
+template <typename Complex> Complex readBinary(const std::string &filename) {
+  return frozen_complex<Complex>::map(filename).thaw();
+}
+
+/**
+ * @brief      Memory map a file in the binary complex format as a
+ *             frozen_complex without copying.
+ *
+ * @param[in]  filename  The file to map.
+ *
+ * @tparam     Complex   Typename of the simplicial_complex.
+ * @tparam     Index     Integral type used to store simplex indices.
+ *
+ * @return     The frozen complex.
+ */
+template <typename Complex, typename Index = std::uint32_t>
+frozen_complex<Complex, Index> mapBinary(const std::string &filename) {
+  return frozen_complex<Complex, Index>::map(filename);
+}
+} // end namespace casc
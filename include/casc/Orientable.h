@@ -23,9 +23,14 @@
 
 #pragma once
 
+#include <deque>
 #include <iostream>
 #include <queue>
 #include <set>
+#include <tuple>
+
+#include "SimplexSet.h"
+#include "visited_set.h"
 
 namespace casc {
 /**
@@ -47,7 +52,7 @@ struct init_orientation_helper<Complex,
                                std::integral_constant<std::size_t, k>> {
   static void f(Complex &F) {
     for (auto curr : F.template get_level_id<k>()) {
-      for (auto a : F.get_cover(curr)) {
+      for (auto a : F.cover_view(curr)) {
         int orient = 1;
         for (auto b : F.get_name(curr)) {
           // Count the number of indices > name
@@ -76,6 +81,25 @@ struct init_orientation_helper<
     Complex, std::integral_constant<std::size_t, Complex::topLevel>> {
   static void f(Complex &) {}
 };
+
+/**
+ * @brief      Initialize the orientation of the edges down from the
+ *             simplices of a region. See also init_orientation.
+ *
+ * @tparam     Complex  Typename of the simplicial complex
+ */
+template <typename Complex> struct init_region_helper {
+  template <std::size_t k>
+  static void apply(Complex &F, const SimplexSet<Complex> &region) {
+    for (auto curr : casc::get<k>(region)) {
+      auto name = F.get_name(curr);
+      // The edge from the face missing name[i] is ordered by i
+      for (std::size_t i = 0; i < k; ++i) {
+        (*F.get_edge_down(curr, name[i])).orientation = (i % 2) ? -1 : 1;
+      }
+    }
+  }
+};
 } // end namespace orientation_detail
 /// @endcond
 
@@ -141,26 +165,33 @@ std::tuple<int, bool, bool> check_orientation(Complex &F) {
   constexpr std::size_t k = Complex::topLevel - 1;
 
   std::deque<typename Complex::template SimplexID<k>> frontier;
-  std::set<typename Complex::template SimplexID<k>> visited;
+  visited_set<typename Complex::template SimplexID<k>> visited;
   int connected_components = 0;
   bool orientable = true;
   bool psuedo_manifold = true;
   for (auto outer : F.template get_level_id<k>()) {
-    if (visited.find(outer) == visited.end()) {
+    if (visited.count(outer) == 0) {
       ++connected_components;
       frontier.push_back(outer);
 
       while (!frontier.empty()) {
         typename Complex::template SimplexID<k> curr = frontier.front();
-        if (visited.find(curr) == visited.end()) {
-          visited.insert(curr);
+        if (visited.insert(curr)) {
 
-          auto w = F.get_cover(curr);
+          // Keys of the first two cofaces and the number of cofaces
+          typename Complex::KeyType w[2];
+          std::size_t nw = 0;
+          for (auto a : F.cover_view(curr)) {
+            if (nw < 2) {
+              w[nw] = a;
+            }
+            ++nw;
+          }
 
-          if (w.size() == 1) {
+          if (nw == 1) {
             // w is a boundary
             // std::cout << curr << ":" << w[0] << " ~ Boundary" << std::endl;
-          } else if (w.size() == 2) {
+          } else if (nw == 2) {
             auto &edge0 = *F.get_edge_up(curr, w[0]);
             auto &edge1 = *F.get_edge_up(curr, w[1]);
 
@@ -219,4 +250,124 @@ std::tuple<int, bool, bool> check_orientation(Complex &F) {
   }
   return std::make_tuple(connected_components, orientable, psuedo_manifold);
 }
+
+/**
+ * @brief      Restore the orientation of a region of the complex after a
+ *             local edit.
+ *
+ * The edges of the simplices in `region` are initialized as by
+ * init_orientation() and the facets of the region are cleared. Orientation
+ * is then propagated into the region across its boundary with the oriented
+ * facets around it. Only the faces of the region are visited so the cost
+ * depends on the size of the region rather than of the complex. Components
+ * of the region which touch no oriented facet are seeded as in
+ * check_orientation().
+ *
+ * Example -- keep a mesh oriented while decimating:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * auto np = decimateFirstHalf(F, s, ctx);
+ * run_user_callback(F, ctx.simplexMap, Callback<Mesh>(), ctx.rv);
+ * decimateBackHalf(F, ctx);
+ * SimplexSet<Mesh> region;
+ * auto v = F.get_simplex_up({np});
+ * getStar(F, v, region);
+ * reorient_region(F, region);
+ * ~~~~~~~~~~~~~~~
+ *
+ * @param      F        Simplicial_complex
+ * @param[in]  region   The modified simplices, typically the star of the new
+ *                      vertex of a decimation.
+ *
+ * @tparam     Complex  Typename of the simplicial_complex.
+ *
+ * @return     A tuple of whether the region is consistently oriented with
+ *             its surroundings, and if it is psuedo manifold.
+ */
+template <typename Complex>
+std::tuple<bool, bool> reorient_region(Complex &F,
+                                       const SimplexSet<Complex> &region) {
+  constexpr std::size_t k = Complex::topLevel - 1;
+  using Face = typename Complex::template SimplexID<k>;
+
+  util::int_for_each<std::size_t,
+                     typename SimplexSet<Complex>::cLevelIndex>(
+      orientation_detail::init_region_helper<Complex>(), F, region);
+  for (auto facet : casc::get<Complex::topLevel>(region)) {
+    (*facet).orientation = 0;
+  }
+
+  std::deque<Face> frontier;
+  visited_set<Face> visited;
+  bool orientable = true;
+  bool psuedo_manifold = true;
+  auto push_faces = [&](typename Complex::template SimplexID<k + 1> facet) {
+    for (auto face : F.down_view(facet)) {
+      frontier.push_back(face);
+    }
+  };
+  auto propagate = [&]() {
+    while (!frontier.empty()) {
+      Face curr = frontier.front();
+      frontier.pop_front();
+      if (visited.count(curr)) {
+        continue;
+      }
+
+      typename Complex::KeyType w[2];
+      std::size_t nw = 0;
+      for (auto a : F.cover_view(curr)) {
+        if (nw < 2) {
+          w[nw] = a;
+        }
+        ++nw;
+      }
+      if (nw != 2) {
+        // Boundary or non-manifold face
+        psuedo_manifold &= nw == 1;
+        visited.insert(curr);
+        continue;
+      }
+
+      auto &edge0 = *F.get_edge_up(curr, w[0]);
+      auto &edge1 = *F.get_edge_up(curr, w[1]);
+      auto s0 = F.get_simplex_up(curr, w[0]);
+      auto s1 = F.get_simplex_up(curr, w[1]);
+      auto &node0 = *s0;
+      auto &node1 = *s1;
+      if (node0.orientation == 0 && node1.orientation == 0) {
+        // Revisited once either side has been oriented
+        continue;
+      }
+      visited.insert(curr);
+      if (node0.orientation == 0) {
+        node0.orientation =
+            -edge0.orientation * edge1.orientation * node1.orientation;
+        push_faces(s0);
+      } else if (node1.orientation == 0) {
+        node1.orientation =
+            -edge1.orientation * edge0.orientation * node0.orientation;
+        push_faces(s1);
+      } else if (edge0.orientation * node0.orientation +
+                     edge1.orientation * node1.orientation !=
+                 0) {
+        orientable = false;
+      }
+    }
+  };
+
+  // Orient from the boundary of the region inwards
+  for (auto facet : casc::get<Complex::topLevel>(region)) {
+    push_faces(facet);
+  }
+  propagate();
+  // Seed whatever could not be reached
+  for (auto facet : casc::get<Complex::topLevel>(region)) {
+    if ((*facet).orientation == 0) {
+      (*facet).orientation = -1;
+      push_faces(facet);
+      propagate();
+    }
+  }
+  return std::make_tuple(orientable, psuedo_manifold);
+}
 } // end namespace casc
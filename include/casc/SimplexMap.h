@@ -23,10 +23,13 @@
 
 #pragma once
 
+#include "node_pool.h"
 #include "stringutil.h"
 #include "util.h"
 #include <array>
+#include <functional>
 #include <map>
+#include <utility>
 
 namespace casc {
 
@@ -76,6 +79,13 @@ template <typename Complex> struct SimplexMap {
     return std::get<k>(tupleMap);
   }
 
+  /**
+   * @brief      Clear the contents.
+   */
+  void clear() {
+    util::int_for_each<std::size_t, LevelIndex>(ClearHelper(), this);
+  }
+
   /**
    * @brief      Print the SimplexMap.
    *
@@ -93,6 +103,22 @@ template <typename Complex> struct SimplexMap {
   }
 
 private:
+  /**
+   * @brief      Helper struct to clear the SimplexMap.
+   */
+  struct ClearHelper {
+    /**
+     * @brief      Clear a dimension.
+     *
+     * @param      that  Pointer to this SimplexMap.
+     *
+     * @tparam     k     Simplex dimension to clear.
+     */
+    template <std::size_t k> static void apply(type_this *that) {
+      std::get<k>(that->tupleMap).clear();
+    }
+  };
+
   /**
    * @brief      Helper struct to print the SimplexMap.
    */
@@ -123,7 +149,10 @@ private:
   using ArrayLevel = typename util::int_type_map<std::size_t, std::tuple,
                                                  LevelIndex, array>::type;
   /// Alias for a Map of type T to a SimplexSet.
-  template <class T> using map = std::map<T, SimplexSet<Complex>>;
+  template <class T>
+  using map =
+      std::map<T, SimplexSet<Complex>, std::less<T>,
+               recycling_allocator<std::pair<const T, SimplexSet<Complex>>>>;
   /// The full tuple of maps of an Array of keys to SimplexSet.
   typename util::type_map<ArrayLevel, map>::type tupleMap;
 };
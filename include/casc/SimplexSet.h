@@ -23,8 +23,10 @@
 
 #pragma once
 
+#include "flat_set.h"
 #include "util.h"
 #include <algorithm>
+#include <iterator>
 #include <unordered_set>
 
 namespace casc {
@@ -36,6 +38,11 @@ namespace casc {
  * dimension. Many convenience functions are wrapped so this behaves much like
  * a std::set.
  *
+ * Each level is stored in a NodeSet unless the traits of the complex select
+ * a different `SimplexSetContainer`, for example casc::flat_set. With sorted
+ * containers set_union(), set_intersection() and set_difference() are linear
+ * merges instead of hash lookups.
+ *
  * @tparam     Complex  Typename of the simplicial_complex.
  */
 template <typename Complex> struct SimplexSet {
@@ -62,8 +69,11 @@ template <typename Complex> struct SimplexSet {
                                   SimplexID>::type;
   // No real sense to hide this tuple of sets from the end users.
   // Making it private, we'd have to introduce lots of friend structs.
-  /// Tuple of NodeSets per level.
-  typename util::type_map<SimplexIDLevel, NodeSet>::type tupleSet;
+  /// Typename of the container for one level.
+  template <typename T>
+  using LevelSet = typename Complex::template SimplexSetContainer<T>;
+  /// Tuple of LevelSets per level.
+  typename util::type_map<SimplexIDLevel, LevelSet>::type tupleSet;
 
   /// Default constructor
   SimplexSet(){};
@@ -114,9 +124,11 @@ template <typename Complex> struct SimplexSet {
    * @param[in]  s     Simplex to insert.
    *
    * @tparam     k     Simplex dimension of 's'.
+   *
+   * @return     True if 's' was inserted, false if it was already present.
    */
-  template <std::size_t k> inline void insert(SimplexID<k> s) {
-    std::get<k>(tupleSet).insert(s);
+  template <std::size_t k> inline bool insert(SimplexID<k> s) {
+    return std::get<k>(tupleSet).insert(s).second;
   }
 
   /**
@@ -279,9 +291,9 @@ private:
      */
     template <std::size_t k>
     static void apply(type_this *that, const SimplexSet<Complex> &S) {
-      auto s = std::get<k>(S.tupleSet);
-      for (auto simplex : s) {
-        that->insert(simplex);
+      if (that != &S) {
+        const auto &s = std::get<k>(S.tupleSet);
+        std::get<k>(that->tupleSet).insert(s.begin(), s.end());
       }
     }
   };
@@ -300,8 +312,11 @@ private:
      */
     template <std::size_t k>
     static void apply(type_this *that, const SimplexSet<Complex> &S) {
-      auto s = std::get<k>(S.tupleSet);
-      for (auto simplex : s) {
+      if (that == &S) {
+        std::get<k>(that->tupleSet).clear();
+        return;
+      }
+      for (auto simplex : std::get<k>(S.tupleSet)) {
         that->erase(simplex);
       }
     }
@@ -322,8 +337,7 @@ private:
     template <std::size_t k>
     static void apply(std::ostream &output, const SimplexSet<Complex> &S) {
       output << "[l=" << k;
-      auto s = std::get<k>(S.tupleSet);
-      for (auto simplex : s) {
+      for (auto simplex : std::get<k>(S.tupleSet)) {
         output << ", " << simplex;
       }
       output << "]";
@@ -364,14 +378,14 @@ private:
 };
 
 /**
- * @brief      Get the NodeSet for a simplex dimension from a SimplexSet.
+ * @brief      Get the LevelSet for a simplex dimension from a SimplexSet.
  *
  * @param      S        SimplexSet of interest.
  *
  * @tparam     k        Simplex dimension desired.
  * @tparam     Complex  Typename of the simplicial_complex.
  *
- * @return     A NodeSet which holds simplices of dimension 'k' and a member of
+ * @return     A LevelSet which holds simplices of dimension 'k' and a member of
  *             SimplexSet 'S'.
  */
 template <std::size_t k, typename Complex>
@@ -390,6 +404,80 @@ static inline auto &get(const SimplexSet<Complex> &S) {
 /// @cond detail
 /// Namespace for simplex container related helpers
 namespace simplex_set_detail {
+/// Union of two hashed levels.
+template <typename Set>
+void level_union(const Set &a, const Set &b, Set &d) {
+  if (&d != &a)
+    d.insert(a.begin(), a.end());
+  if (&d != &b)
+    d.insert(b.begin(), b.end());
+}
+
+/// Union of two sorted levels as a single merge.
+template <typename T, typename C>
+void level_union(const flat_set<T, C> &a, const flat_set<T, C> &b,
+                 flat_set<T, C> &d) {
+  if (d.empty() && &d != &a && &d != &b) {
+    d.reserve(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::inserter(d, d.end()), C());
+  } else {
+    if (&d != &a)
+      d.insert(a.begin(), a.end());
+    if (&d != &b)
+      d.insert(b.begin(), b.end());
+  }
+}
+
+/// Intersection of two hashed levels probing the larger one.
+template <typename Set>
+void level_intersection(const Set &a, const Set &b, Set &d) {
+  const Set &small = (a.size() < b.size()) ? a : b;
+  const Set &large = (a.size() < b.size()) ? b : a;
+  for (auto item : small) {
+    if (large.find(item) != large.end())
+      d.insert(item);
+  }
+}
+
+/// Intersection of two sorted levels as a single merge.
+template <typename T, typename C>
+void level_intersection(const flat_set<T, C> &a, const flat_set<T, C> &b,
+                        flat_set<T, C> &d) {
+  if (&d == &a || &d == &b) {
+    // Do not write into a set which is being merged
+    flat_set<T, C> tmp;
+    level_intersection(a, b, tmp);
+    d.insert(tmp.begin(), tmp.end());
+    return;
+  }
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                        std::inserter(d, d.end()), C());
+}
+
+/// Difference of two hashed levels.
+template <typename Set>
+void level_difference(const Set &a, const Set &b, Set &d) {
+  for (auto item : a) {
+    if (b.find(item) == b.end())
+      d.insert(item);
+  }
+}
+
+/// Difference of two sorted levels as a single merge.
+template <typename T, typename C>
+void level_difference(const flat_set<T, C> &a, const flat_set<T, C> &b,
+                      flat_set<T, C> &d) {
+  if (&d == &a || &d == &b) {
+    // Do not write into a set which is being merged
+    flat_set<T, C> tmp;
+    level_difference(a, b, tmp);
+    d.insert(tmp.begin(), tmp.end());
+    return;
+  }
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                      std::inserter(d, d.end()), C());
+}
 
 /**
  * @brief      Helper struct to compute the union of two SimplexSets.
@@ -411,11 +499,7 @@ template <typename Complex> struct UnionH {
   template <std::size_t k>
   static void apply(const SimplexSet<Complex> &A, const SimplexSet<Complex> &B,
                     SimplexSet<Complex> &dest) {
-    auto a = std::get<k>(A.tupleSet);
-    auto b = std::get<k>(B.tupleSet);
-    auto &d = std::get<k>(dest.tupleSet);
-    d.insert(a.begin(), a.end());
-    d.insert(b.begin(), b.end());
+    level_union(casc::get<k>(A), casc::get<k>(B), casc::get<k>(dest));
   }
 };
 
@@ -439,21 +523,7 @@ template <typename Complex> struct IntersectH {
   template <std::size_t k>
   static void apply(const SimplexSet<Complex> &A, const SimplexSet<Complex> &B,
                     SimplexSet<Complex> &dest) {
-    auto a = casc::get<k>(A);
-    auto b = casc::get<k>(B);
-    auto &d = casc::get<k>(dest);
-
-    if (a.size() < b.size()) {
-      for (auto item : a) {
-        if (b.find(item) != b.end())
-          d.insert(item);
-      }
-    } else {
-      for (auto item : b) {
-        if (a.find(item) != a.end())
-          d.insert(item);
-      }
-    }
+    level_intersection(casc::get<k>(A), casc::get<k>(B), casc::get<k>(dest));
   }
 };
 
@@ -477,14 +547,7 @@ template <typename Complex> struct DifferenceH {
   template <std::size_t k>
   static void apply(const SimplexSet<Complex> &A, const SimplexSet<Complex> &B,
                     SimplexSet<Complex> &dest) {
-    auto a = casc::get<k>(A);
-    auto b = casc::get<k>(B);
-    auto &d = casc::get<k>(dest);
-
-    for (auto item : a) {
-      if (b.find(item) == b.end())
-        d.insert(item);
-    }
+    level_difference(casc::get<k>(A), casc::get<k>(B), casc::get<k>(dest));
   }
 };
 
@@ -510,9 +573,7 @@ template <typename Complex> struct OperatorEQH {
    */
   template <std::size_t k>
   void apply(const SimplexSet<Complex> &lhs, const SimplexSet<Complex> &rhs) {
-    auto a = casc::get<k>(lhs);
-    auto b = casc::get<k>(rhs);
-    result &= a == b;
+    result &= casc::get<k>(lhs) == casc::get<k>(rhs);
   }
 };
 } // end namespace simplex_set_detail
@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <array>
 #include <assert.h>
+#include <atomic>
 #include <cstdint>
 #include <fstream>
 #include <functional>
@@ -36,6 +37,7 @@
 #include <ostream>
 #include <set>
 #include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -43,6 +45,9 @@
 #include <vector>
 
 #include "index_tracker.h"
+#include "node_pool.h"
+#include "parallel.h"
+#include "stats.h"
 #include "util.h"
 
 #if __has_cpp_attribute(maybe_unused)
@@ -56,218 +61,796 @@ namespace casc {
 /// @cond detail
 /// Namespace for CASC internal data structures
 namespace detail {
-/// Data structure to store simplices by level.
-template <class T> using map = std::map<std::size_t, T>;
+/**
+ * @brief      Column of NodeData parallel to the slots of a registry.
+ *
+ * Entry i holds the data of the Node in slot i. Tombstones keep the data of
+ * the removed Node until the registry is compacted. Whenever the column is
+ * reallocated or entries are moved the `_data_ptr` of the affected Nodes is
+ * updated.
+ *
+ * @tparam     T     Typename of the Node pointer.
+ * @tparam     D     Typename of the data.
+ */
+template <class T, class D> struct asc_column {
+  /**
+   * @brief      Add an entry for the Node in the last slot.
+   *
+   * @param[in]  slots  The slots of the registry.
+   */
+  void push_back(const std::vector<T> &slots) {
+    const D *old = _data.data();
+    _data.emplace_back();
+    if (_data.data() == old) {
+      slots.back()->_data_ptr = &_data.back();
+      return;
+    }
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+      if (slots[i] != nullptr) {
+        slots[i]->_data_ptr = &_data[i];
+      }
+    }
+  }
+
+  /// Move the entry of slot r to slot w which now holds the Node p.
+  void move(std::size_t r, std::size_t w, T p) {
+    if (r != w) {
+      _data[w] = std::move(_data[r]);
+    }
+    p->_data_ptr = &_data[w];
+  }
+
+  /// Keep the first n entries.
+  void truncate(std::size_t n) { _data.resize(n); }
+  /// Reserve entries for n Nodes.
+  void reserve(std::size_t n) { _data.reserve(n); }
+  /// Remove all entries.
+  void clear() { _data.clear(); }
+  /// Number of heap bytes reserved for entries
+  std::size_t bytes() const { return _data.capacity() * sizeof(D); }
+  /// Pointer to the entry of slot 0.
+  D *data() { return _data.data(); }
+
+private:
+  std::vector<D> _data; ///< Data of the Node in each slot
+};
 
 /**
- * @brief      A generic pair type representing Key to Value associations.
+ * @brief      Specialization for Nodes which store their own data.
  *
- * @tparam     T1    Typename of the Key
- * @tparam     T2    Typename of the Value
+ * @tparam     T     Typename of the Node pointer.
  */
-template <typename T1, typename T2> struct asc_pair {
-  using this_t = asc_pair<T1, T2>;
-  asc_pair() {}
-  asc_pair(const T1 &first, const T2 &second) : _pair(first, second) {}
-  asc_pair(T1 &&first, T2 &&second)
-      : _pair(std::forward<T1>(first), std::forward<T2>(second)) {}
-  asc_pair(const this_t &other) : _pair(other._pair) {}
-  asc_pair(this_t &&other)
-      : _pair(std::forward<std::pair<T1, T2>>(other._pair)) {}
-
-  operator T1() const { return _pair.first; }
-
-  this_t &operator=(const this_t &other) {
-    _pair = other._pair;
-    return *this;
+template <class T> struct asc_column<T, void> {
+  void push_back(const std::vector<T> &) {}
+  void move(std::size_t, std::size_t, T) {}
+  void truncate(std::size_t) {}
+  void reserve(std::size_t) {}
+  void clear() {}
+  std::size_t bytes() const { return 0; }
+};
+
+/**
+ * @brief      Dense registry of the Nodes of a level.
+ *
+ * Nodes are stored in a vector of slots in order of creation. Each Node
+ * records its own slot so that insertion and removal are O(1). Removal
+ * leaves a tombstone which is skipped during iteration. When tombstones
+ * outnumber the live Nodes the next insertion squeezes them out, preserving
+ * the order of the remaining Nodes.
+ *
+ * Iterators are indices into the slot vector. Removing Nodes, including the
+ * current one, during iteration is safe. Ranges over the level hold a pin,
+ * which defers compaction while the range exists, so inserting while
+ * iterating a range neither skips nor repeats Nodes. Nodes inserted during
+ * iteration are appended behind the end of the range. A stored range keeps
+ * its tombstones until it is destroyed. Iterators alone are not counted.
+ *
+ * When the level stores its NodeData in a column, the registry also owns
+ * the column, see asc_column.
+ *
+ * @tparam     T     Typename of the Node pointer to store. The pointed to
+ *                   type must have a `std::size_t _slot` member.
+ * @tparam     D     Typename of the data stored in a column or void if the
+ *                   Nodes store their own data.
+ */
+template <class T, class D = void> struct asc_registry {
+  /// Typename of the slot vector
+  using vector_t = std::vector<T>;
+
+  /**
+   * @brief      Bidirectional iterator over live Nodes.
+   *
+   * @tparam     Registry  Possibly const qualified typename of the registry.
+   */
+  template <typename Registry>
+  struct slot_iterator
+      : public std::iterator<std::bidirectional_iterator_tag, T, std::ptrdiff_t,
+                             const T *, const T &> {
+    /// Empty constructor
+    slot_iterator() : reg(nullptr), i(0) {}
+    /// Construct an iterator pointing to slot j or the next live slot
+    slot_iterator(Registry *r, std::size_t j) : reg(r), i(j) { skip_forward(); }
+    /// Increment the iterator
+    slot_iterator &operator++() {
+      ++i;
+      skip_forward();
+      return *this;
+    }
+    /// Increment the iterator
+    slot_iterator operator++(int) {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    /// Decrement the iterator
+    slot_iterator &operator--() {
+      if (i > reg->_slots.size())
+        i = reg->_slots.size();
+      do {
+        --i;
+      } while (reg->_slots[i] == nullptr);
+      return *this;
+    }
+    /// Decrement the iterator
+    slot_iterator operator--(int) {
+      auto tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    /// Iterators past the last slot all compare equal.
+    bool operator==(const slot_iterator &j) const {
+      const auto n = reg->_slots.size();
+      return (i >= n && j.i >= n) || i == j.i;
+    }
+    /// Iterator inequality comparison
+    bool operator!=(const slot_iterator &j) const { return !(*this == j); }
+    /// Dereferencing the iterator produces the Node pointer.
+    const T &operator*() const { return reg->_slots[i]; }
+    /// Access the Node pointer.
+    const T *operator->() const { return &reg->_slots[i]; }
+
+  private:
+    /// Advance to the next live slot
+    void skip_forward() {
+      const auto n = reg->_slots.size();
+      while (i < n && reg->_slots[i] == nullptr)
+        ++i;
+    }
+
+    Registry *reg; ///< The registry being iterated
+    std::size_t i; ///< Current slot
+  };
+
+  /// Iterator typename
+  using iterator = slot_iterator<asc_registry>;
+  /// Const iterator typename
+  using const_iterator = slot_iterator<const asc_registry>;
+
+  /**
+   * @brief      Defers the compaction of a registry while it exists.
+   */
+  class pin {
+  public:
+    /// Pin a registry.
+    explicit pin(const asc_registry &r) : _reg(&r) { acquire(); }
+    /// Pin the same registry.
+    pin(const pin &p) : _reg(p._reg) { acquire(); }
+    /// Pin the registry of p instead.
+    pin &operator=(const pin &p) {
+      if (_reg != p._reg) {
+        release();
+        _reg = p._reg;
+        acquire();
+      }
+      return *this;
+    }
+    /// Allow compaction once no pins remain.
+    ~pin() { release(); }
+
+  private:
+    void acquire() { _reg->_pins.fetch_add(1, std::memory_order_relaxed); }
+    void release() { _reg->_pins.fetch_sub(1, std::memory_order_relaxed); }
+
+    const asc_registry *_reg; ///< The pinned registry
+  };
+
+  asc_registry() : _size(0), _pins(0) {}
+
+  /// Move constructor, pins of rhs stay on rhs.
+  asc_registry(asc_registry &&rhs)
+      : _slots(std::move(rhs._slots)), _column(std::move(rhs._column)),
+        _size(rhs._size), _pins(0) {
+    rhs._size = 0;
   }
 
-  this_t &operator=(this_t &&other) {
-    _pair = std::move(other._pair);
+  /// Move assignment, pins of rhs stay on rhs.
+  asc_registry &operator=(asc_registry &&rhs) {
+    _slots = std::move(rhs._slots);
+    _column = std::move(rhs._column);
+    _size = rhs._size;
+    rhs._size = 0;
     return *this;
   }
 
-  friend bool operator==(const this_t &lhs, const this_t &rhs) {
-    return lhs.first == rhs.first;
+  /**
+   * @brief      Append a Node to the registry.
+   *
+   * Squeezes out the tombstones first if they outnumber the live Nodes and
+   * the registry is not pinned.
+   *
+   * @param[in]  p     The Node to add.
+   */
+  void insert(T p) {
+    if (_slots.size() - _size > std::max<std::size_t>(_size, 32) &&
+        !pinned()) {
+      compact();
+    }
+    p->_slot = _slots.size();
+    _slots.push_back(p);
+    _column.push_back(_slots);
+    ++_size;
+  }
+
+  /**
+   * @brief      Remove a Node from the registry.
+   *
+   * @param[in]  p     The Node to remove.
+   */
+  void erase(T p) {
+    assert(p->_slot < _slots.size() && _slots[p->_slot] == p);
+    _slots[p->_slot] = nullptr;
+    --_size;
+  }
+
+  /**
+   * @brief      Squeeze out tombstones while preserving the order of Nodes.
+   *
+   * Must not be called while the registry is pinned.
+   */
+  void compact() {
+    assert(!pinned());
+    std::size_t w = 0;
+    for (std::size_t r = 0; r < _slots.size(); ++r) {
+      if (_slots[r] != nullptr) {
+        _slots[w] = _slots[r];
+        _slots[w]->_slot = w;
+        _column.move(r, w, _slots[w]);
+        ++w;
+      }
+    }
+    _slots.resize(w);
+    _column.truncate(w);
+  }
+
+  /// Reserve slots for n Nodes.
+  void reserve(std::size_t n) {
+    _slots.reserve(n);
+    _column.reserve(n);
+  }
+
+  /// Remove all Nodes from the registry.
+  void clear() {
+    _slots.clear();
+    _column.clear();
+    _size = 0;
+  }
+
+  /// Number of live Nodes
+  std::size_t size() const { return _size; }
+  /// Whether a range over the registry defers compaction
+  bool pinned() const { return _pins.load(std::memory_order_relaxed) != 0; }
+  /// Number of slots including tombstones
+  std::size_t slots() const { return _slots.size(); }
+  /// Number of heap bytes reserved for slots and the data column
+  std::size_t bytes() const {
+    return _slots.capacity() * sizeof(T) + _column.bytes();
+  }
+  /// The data of the Node in each slot, if stored in a column.
+  D *column() { return _column.data(); }
+  /// Get the Node in slot i or nullptr if the slot is a tombstone.
+  T operator[](std::size_t i) const { return _slots[i]; }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, _slots.size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, _slots.size()); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  const_iterator cend() const { return const_iterator(this, _slots.size()); }
+
+private:
+  vector_t _slots;          ///< Nodes by creation, nullptr for tombstones
+  asc_column<T, D> _column; ///< Data of the Nodes in each slot
+  std::size_t _size;        ///< Number of live Nodes
+  /// Number of pins, compaction is deferred while nonzero
+  mutable std::atomic<std::size_t> _pins;
+};
+
+/**
+ * @brief      Range over a level which pins its registry.
+ *
+ * Copies of the range share the pin, so the tombstones of the level are
+ * kept until the last copy is destroyed.
+ *
+ * @tparam     Iterator  Typename of the iterators.
+ * @tparam     Registry  Typename of the registry.
+ */
+template <typename Iterator, typename Registry>
+struct level_range : public util::range<Iterator> {
+  /// Construct a range over [b, e) pinning reg.
+  level_range(Iterator b, Iterator e, const Registry &reg)
+      : util::range<Iterator>(b, e), _pin(reg) {}
+
+private:
+  typename Registry::pin _pin; ///< Defers compaction of the level
+};
+
+/// Make a level_range, deducing the template arguments.
+template <typename Iterator, typename Registry>
+level_range<Iterator, Registry> make_level_range(Iterator b, Iterator e,
+                                                 const Registry &reg) {
+  return level_range<Iterator, Registry>(b, e, reg);
+}
+
+/**
+ * @brief      Reference to an entry of a map with split key and value
+ *             storage.
+ *
+ * @tparam     KEY_T  Typename of the Key
+ * @tparam     VAL_T  Possibly const qualified typename of the Value
+ */
+template <typename KEY_T, typename VAL_T> struct asc_pair_ref {
+  const KEY_T &first; ///< The Key
+  VAL_T &second;      ///< The Value
+};
+
+/**
+ * @brief      Pointer-like holder of an asc_pair_ref to support `it->first`.
+ *
+ * @tparam     KEY_T  Typename of the Key
+ * @tparam     VAL_T  Possibly const qualified typename of the Value
+ */
+template <typename KEY_T, typename VAL_T> struct asc_pair_ptr {
+  asc_pair_ref<KEY_T, VAL_T> ref; ///< The referenced entry
+  /// Access the entry.
+  const asc_pair_ref<KEY_T, VAL_T> *operator->() const { return &ref; }
+};
+
+/**
+ * @brief      Random access iterator over parallel arrays of Keys and Values.
+ *
+ * @tparam     KEY_T  Typename of the Key
+ * @tparam     VAL_T  Possibly const qualified typename of the Value
+ */
+template <typename KEY_T, typename VAL_T>
+struct asc_split_iterator
+    : public std::iterator<std::random_access_iterator_tag,
+                           asc_pair_ref<KEY_T, VAL_T>, std::ptrdiff_t,
+                           asc_pair_ptr<KEY_T, VAL_T>,
+                           asc_pair_ref<KEY_T, VAL_T>> {
+  /// Dereferencing produces a reference to the Key and Value.
+  using reference = asc_pair_ref<KEY_T, VAL_T>;
+  /// Result of the arrow operator.
+  using pointer = asc_pair_ptr<KEY_T, VAL_T>;
+
+  /// Empty constructor
+  asc_split_iterator() : _key(nullptr), _val(nullptr) {}
+  /// Construct an iterator pointing to a Key and its Value
+  asc_split_iterator(const KEY_T *key, VAL_T *val) : _key(key), _val(val) {}
+  /// Mutable iterators convert to const iterators.
+  template <typename V, typename = std::enable_if_t<
+                            std::is_same<const V, VAL_T>::value &&
+                            !std::is_same<V, VAL_T>::value>>
+  asc_split_iterator(const asc_split_iterator<KEY_T, V> &it)
+      : _key(it._key), _val(it._val) {}
+
+  /// Dereferencing the iterator produces the entry.
+  reference operator*() const { return reference{*_key, *_val}; }
+  /// Access the entry.
+  pointer operator->() const { return pointer{**this}; }
+  /// Access the entry n positions away.
+  reference operator[](std::ptrdiff_t n) const { return *(*this + n); }
+
+  /// Increment the iterator
+  asc_split_iterator &operator++() {
+    ++_key;
+    ++_val;
+    return *this;
+  }
+  /// Increment the iterator
+  asc_split_iterator operator++(int) {
+    auto tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  /// Decrement the iterator
+  asc_split_iterator &operator--() {
+    --_key;
+    --_val;
+    return *this;
   }
-  friend bool operator!=(const this_t &lhs, const this_t &rhs) {
-    return lhs.first != rhs.first;
+  /// Decrement the iterator
+  asc_split_iterator operator--(int) {
+    auto tmp = *this;
+    --(*this);
+    return tmp;
   }
-  friend bool operator<=(const this_t &lhs, const this_t &rhs) {
-    return lhs.first <= rhs.first;
+  /// Advance the iterator
+  asc_split_iterator &operator+=(std::ptrdiff_t n) {
+    _key += n;
+    _val += n;
+    return *this;
   }
-  friend bool operator>=(const this_t &lhs, const this_t &rhs) {
-    return lhs.first >= rhs.first;
+  /// Move the iterator back
+  asc_split_iterator &operator-=(std::ptrdiff_t n) { return *this += -n; }
+  /// Iterator n positions ahead
+  asc_split_iterator operator+(std::ptrdiff_t n) const {
+    auto tmp = *this;
+    return tmp += n;
   }
-  friend bool operator<(const this_t &lhs, const this_t &rhs) {
-    return lhs.first < rhs.first;
+  /// Iterator n positions back
+  asc_split_iterator operator-(std::ptrdiff_t n) const {
+    auto tmp = *this;
+    return tmp -= n;
   }
-  friend bool operator>(const this_t &lhs, const this_t &rhs) {
-    return lhs.first > rhs.first;
+  /// Distance between iterators
+  std::ptrdiff_t operator-(const asc_split_iterator &j) const {
+    return _key - j._key;
   }
 
-  T1 &first = _pair.first;
-  T2 &second = _pair.second;
+  /// Iterator equality comparison
+  bool operator==(const asc_split_iterator &j) const { return _key == j._key; }
+  /// Iterator inequality comparison
+  bool operator!=(const asc_split_iterator &j) const { return _key != j._key; }
+  /// Iterator ordering
+  bool operator<(const asc_split_iterator &j) const { return _key < j._key; }
+  /// Iterator ordering
+  bool operator>(const asc_split_iterator &j) const { return _key > j._key; }
+  /// Iterator ordering
+  bool operator<=(const asc_split_iterator &j) const { return _key <= j._key; }
+  /// Iterator ordering
+  bool operator>=(const asc_split_iterator &j) const { return _key >= j._key; }
 
 private:
-  std::pair<T1, T2> _pair;
+  template <typename, typename> friend struct asc_split_iterator;
+
+  const KEY_T *_key; ///< Current Key
+  VAL_T *_val;       ///< Current Value
 };
 
 /**
- * @brief      Array of asc_pairs sorted by Key for boundary adjacency storage.
+ * @brief      Fixed capacity map sorted by Key for boundary adjacency storage.
+ *
+ * Keys and Values are stored in separate arrays so that a search only reads
+ * the Keys. Searches compare against all k slots with a fixed trip count
+ * and no early exit, which the compiler unrolls and vectorizes.
  *
  * @tparam     KEY_T  Typename of Key
  * @tparam     VAL_T  Typename of Value
  * @tparam     k      Size of the array
  */
 template <typename KEY_T, typename VAL_T, std::size_t k> struct asc_arraymap {
-  using pair_t = asc_pair<KEY_T, VAL_T>;
-  using array_t = std::array<pair_t, k>;
-  using iterator = typename array_t::iterator;
-  using const_iterator = typename array_t::const_iterator;
+  using iterator = asc_split_iterator<KEY_T, VAL_T>;
+  using const_iterator = asc_split_iterator<KEY_T, const VAL_T>;
+  /// Bytes of storage per entry.
+  static constexpr std::size_t entry_size = sizeof(KEY_T) + sizeof(VAL_T);
 
-  asc_arraymap() {
-    _begin = _array.begin();
-    _end = _array.begin();
-  }
-
-  void insert(pair_t &p) {
-    if (_end == _array.end())
-      throw std::out_of_range(
-          "insert&: Adding element beyond the end of array.");
-    *_end = p;
-    ++_end;
-    std::sort(_begin, _end);
-  }
+  asc_arraymap() : _keys{}, _size(0) {}
 
-  void insert(pair_t &&p) {
-    if (_end == _array.end())
-      throw std::out_of_range(
-          "insert&&: Adding element beyond the end of array.");
-    *_end = std::forward<pair_t>(p);
-    ++_end;
-    std::sort(_begin, _end);
+  /**
+   * @brief      Position of a Key.
+   *
+   * Slots past the end may hold stale Keys of erased entries. They come
+   * after every live slot so taking the first match is still correct.
+   *
+   * @param[in]  key   The Key to search for.
+   *
+   * @return     Position of key or size() if it is absent.
+   */
+  std::size_t index(const KEY_T &key) const {
+    std::size_t rval = k;
+    for (std::size_t i = k; i-- > 0;) {
+      rval = (_keys[i] == key) ? i : rval;
+    }
+    return std::min<std::size_t>(rval, _size);
   }
 
-  iterator find(const KEY_T &key) { return std::find(_begin, _end, key); }
+  iterator find(const KEY_T &key) { return begin() + index(key); }
+  const_iterator find(const KEY_T &key) const { return begin() + index(key); }
 
   void erase(const KEY_T &key) {
-    auto it = std::find(_begin, _end, key);
-    if (it != _end) {
-      std::copy(it + 1, _end, it);
-      --_end;
+    const std::size_t i = index(key);
+    if (i < _size) {
+      std::copy(_keys.begin() + i + 1, _keys.begin() + _size,
+                _keys.begin() + i);
+      std::copy(_vals.begin() + i + 1, _vals.begin() + _size,
+                _vals.begin() + i);
+      --_size;
     }
   }
 
-  std::size_t size() const { return std::distance(_end, _begin); }
+  std::size_t size() const { return _size; }
+
+  /// Number of entries which fit in the array.
+  static constexpr std::size_t capacity() { return k; }
 
   VAL_T &operator[](const KEY_T &key) {
-    auto it = std::find(_begin, _end, key);
-    if (it != _end) {
-      return it->second;
-    } else {
-      if (_end == _array.end())
-        throw std::out_of_range(
-            "operator[]: Adding element beyond the end of array.");
-      _end->first = key;
-      ++_end;
-      std::sort(_begin, _end);
-      return std::find(_begin, _end, key)->second;
+    const std::size_t i = index(key);
+    if (i < _size) {
+      return _vals[i];
     }
+    if (_size == k)
+      throw std::out_of_range(
+          "operator[]: Adding element beyond the end of array.");
+    // Shift the larger entries to keep the Keys sorted
+    std::size_t pos = _size;
+    for (; pos > 0 && key < _keys[pos - 1]; --pos) {
+      _keys[pos] = _keys[pos - 1];
+      _vals[pos] = _vals[pos - 1];
+    }
+    _keys[pos] = key;
+    _vals[pos] = VAL_T();
+    ++_size;
+    return _vals[pos];
   }
 
-  iterator begin() { return _begin; }
-  iterator end() { return _end; }
-  const_iterator cbegin() const { return _begin; }
-  const_iterator cend() const { return _end; }
+  iterator begin() { return iterator(_keys.data(), _vals.data()); }
+  iterator end() { return begin() + _size; }
+  const_iterator begin() const {
+    return const_iterator(_keys.data(), _vals.data());
+  }
+  const_iterator end() const { return begin() + _size; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
 
 private:
-  array_t _array;
-  iterator _begin;
-  iterator _end;
+  std::array<KEY_T, k> _keys; ///< Sorted Keys followed by stale slots
+  std::uint32_t _size;        ///< Number of live entries
+  std::array<VAL_T, k> _vals; ///< Values parallel to the Keys
 };
 
 /**
- * @brief      Sorted vector of asc_pairs for coboundary relation storage.
+ * @brief      Whether asc_vectormap can store the Keys after the Values in a
+ *             single allocation.
  *
  * @tparam     KEY_T  Typename of Key
  * @tparam     VAL_T  Typename of Values
  */
-template <typename KEY_T, typename VAL_T> struct asc_vectormap {
-  using pair_t = asc_pair<KEY_T, VAL_T>;
-  using vector_t = std::vector<pair_t>;
-  using iterator = typename vector_t::iterator;
-  using const_iterator = typename vector_t::const_iterator;
+template <typename KEY_T, typename VAL_T>
+using asc_packable =
+    std::integral_constant<bool, std::is_trivially_copyable<KEY_T>::value &&
+                                     std::is_trivially_copyable<VAL_T>::value &&
+                                     alignof(KEY_T) <= alignof(VAL_T)>;
+
+/**
+ * @brief      Sorted map for coboundary relation storage.
+ *
+ * Keys and Values share one allocation, the Values first and the Keys
+ * after them, so that the branchless binary search only reads the Keys.
+ * Keys which are not trivially copyable or are more strictly aligned than
+ * the Values use the specialization below instead.
+ *
+ * @tparam     KEY_T   Typename of Key
+ * @tparam     VAL_T   Typename of Values
+ * @tparam     Packed  Whether the Keys and Values share an allocation
+ */
+template <typename KEY_T, typename VAL_T,
+          bool Packed = asc_packable<KEY_T, VAL_T>::value>
+struct asc_vectormap {
+  static_assert(std::is_trivially_copyable<KEY_T>::value &&
+                    std::is_trivially_copyable<VAL_T>::value,
+                "asc_vectormap stores trivially copyable Keys and Values");
+  static_assert(alignof(KEY_T) <= alignof(VAL_T),
+                "asc_vectormap stores the Keys after the Values");
+
+  using iterator = asc_split_iterator<KEY_T, VAL_T>;
+  using const_iterator = asc_split_iterator<KEY_T, const VAL_T>;
+  /// Bytes of storage per entry.
+  static constexpr std::size_t entry_size = sizeof(KEY_T) + sizeof(VAL_T);
+
+  asc_vectormap() : _vals(nullptr), _size(0), _capacity(0) {}
+
+  /// Copy constructor
+  asc_vectormap(const asc_vectormap &rhs) : asc_vectormap() {
+    grow(rhs._size);
+    std::copy(rhs.vals(), rhs.vals() + rhs._size, vals());
+    std::copy(rhs.keys(), rhs.keys() + rhs._size, keys());
+    _size = rhs._size;
+  }
 
-  asc_vectormap() {}
+  /// Move constructor
+  asc_vectormap(asc_vectormap &&rhs) noexcept
+      : _vals(rhs._vals), _size(rhs._size), _capacity(rhs._capacity) {
+    rhs._vals = nullptr;
+    rhs._size = 0;
+    rhs._capacity = 0;
+  }
 
-  void insert(pair_t &p) {
-    iterator first = std::lower_bound(_vector.begin(), _vector.end(), p);
-    if ((first == _vector.end()) || (*first != p)) {
-      _vector.insert(first, p);
-    } else {
-      std::cout << "Item already exists...";
-    }
+  /// Copy and move assignment
+  asc_vectormap &operator=(asc_vectormap rhs) {
+    std::swap(_vals, rhs._vals);
+    std::swap(_size, rhs._size);
+    std::swap(_capacity, rhs._capacity);
+    return *this;
   }
 
-  void insert(pair_t &&p) {
-    iterator first = std::lower_bound(_vector.begin(), _vector.end(), p);
-    if ((first == _vector.end()) || (*first != p)) {
-      _vector.insert(first, std::forward<pair_t>(p));
-    } else {
-      std::cout << "Item already exists...";
+  ~asc_vectormap() { ::operator delete(_vals); }
+
+  /**
+   * @brief      Position of the first Key not less than key.
+   *
+   * The search halves the range with a conditional move rather than a
+   * branch so that it does not stall on mispredictions.
+   *
+   * @param[in]  key   The Key to search for.
+   *
+   * @return     The position.
+   */
+  std::size_t lower_bound(const KEY_T &key) const {
+    if (_size == 0)
+      return 0;
+    const KEY_T *base = keys();
+    std::size_t n = _size;
+    while (n > 1) {
+      const std::size_t half = n / 2;
+      base = (base[half] < key) ? base + half : base;
+      n -= half;
     }
+    return (base - keys()) + (*base < key);
   }
 
   iterator find(const KEY_T &key) {
-    iterator first = std::lower_bound(_vector.begin(), _vector.end(), key);
-    if (first != _vector.end()) {
-      if (*first != key) {
-        return _vector.end();
-      } else {
-        return first;
-      }
-    } else {
-      return first;
+    const std::size_t i = lower_bound(key);
+    return (i < _size && keys()[i] == key) ? begin() + i : end();
+  }
+
+  const_iterator find(const KEY_T &key) const {
+    const std::size_t i = lower_bound(key);
+    return (i < _size && keys()[i] == key) ? begin() + i : end();
+  }
+
+  void erase(const KEY_T &key) {
+    const std::size_t i = lower_bound(key);
+    if (i < _size && keys()[i] == key) {
+      std::copy(vals() + i + 1, vals() + _size, vals() + i);
+      std::copy(keys() + i + 1, keys() + _size, keys() + i);
+      --_size;
+    }
+  }
+
+  std::size_t size() const { return _size; }
+
+  /// Number of entries which fit without reallocating.
+  std::size_t capacity() const { return _capacity; }
+
+  VAL_T &at(const KEY_T &key) {
+    const std::size_t i = lower_bound(key);
+    if (i == _size || keys()[i] != key) {
+      throw std::out_of_range("Could not find element in asc_vectormap.");
     }
+    return vals()[i];
+  }
+
+  VAL_T &operator[](const KEY_T &key) {
+    const std::size_t i = lower_bound(key);
+    if (i < _size && keys()[i] == key) {
+      return vals()[i];
+    }
+    if (_size == _capacity) {
+      grow(std::max<std::size_t>(4, 2 * _capacity));
+    }
+    std::copy_backward(vals() + i, vals() + _size, vals() + _size + 1);
+    std::copy_backward(keys() + i, keys() + _size, keys() + _size + 1);
+    keys()[i] = key;
+    vals()[i] = VAL_T();
+    ++_size;
+    return vals()[i];
+  }
+
+  iterator begin() { return iterator(keys(), vals()); }
+  iterator end() { return begin() + _size; }
+  const_iterator begin() const { return const_iterator(keys(), vals()); }
+  const_iterator end() const { return begin() + _size; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+private:
+  /// The Values
+  VAL_T *vals() const { return _vals; }
+  /// The Keys stored after capacity() Values
+  KEY_T *keys() const { return reinterpret_cast<KEY_T *>(_vals + _capacity); }
+
+  /// Reallocate to hold n entries.
+  void grow(std::size_t n) {
+    if (n <= _capacity)
+      return;
+    auto p = static_cast<VAL_T *>(::operator new(n * entry_size));
+    std::copy(vals(), vals() + _size, p);
+    std::copy(keys(), keys() + _size, reinterpret_cast<KEY_T *>(p + n));
+    ::operator delete(_vals);
+    _vals = p;
+    _capacity = static_cast<std::uint32_t>(n);
+  }
+
+  VAL_T *_vals;            ///< Values followed by the Keys
+  std::uint32_t _size;     ///< Number of entries
+  std::uint32_t _capacity; ///< Number of allocated entries
+};
+
+/**
+ * @brief      Sorted map for coboundary relation storage with Keys which
+ *             cannot be packed after the Values.
+ *
+ * Keys and Values are kept in two parallel vectors.
+ *
+ * @tparam     KEY_T  Typename of Key
+ * @tparam     VAL_T  Typename of Values
+ */
+template <typename KEY_T, typename VAL_T>
+struct asc_vectormap<KEY_T, VAL_T, false> {
+  using iterator = asc_split_iterator<KEY_T, VAL_T>;
+  using const_iterator = asc_split_iterator<KEY_T, const VAL_T>;
+  /// Bytes of storage per entry, excluding heap memory owned by the Keys.
+  static constexpr std::size_t entry_size = sizeof(KEY_T) + sizeof(VAL_T);
+
+  /// Position of the first Key not less than key.
+  std::size_t lower_bound(const KEY_T &key) const {
+    return std::lower_bound(_keys.begin(), _keys.end(), key) - _keys.begin();
+  }
+
+  iterator find(const KEY_T &key) {
+    const std::size_t i = lower_bound(key);
+    return (i < size() && _keys[i] == key) ? begin() + i : end();
+  }
+
+  const_iterator find(const KEY_T &key) const {
+    const std::size_t i = lower_bound(key);
+    return (i < size() && _keys[i] == key) ? begin() + i : end();
   }
 
   void erase(const KEY_T &key) {
-    iterator it = this->find(key);
-    if (it != _vector.end()) {
-      _vector.erase(it);
+    const std::size_t i = lower_bound(key);
+    if (i < size() && _keys[i] == key) {
+      _keys.erase(_keys.begin() + i);
+      _vals.erase(_vals.begin() + i);
     }
   }
 
-  std::size_t size() const { return _vector.size(); }
+  std::size_t size() const { return _keys.size(); }
+
+  /// Number of entries which fit without reallocating.
+  std::size_t capacity() const {
+    return std::min(_keys.capacity(), _vals.capacity());
+  }
 
   VAL_T &at(const KEY_T &key) {
-    iterator first = std::lower_bound(_vector.begin(), _vector.end(), key);
-    if ((first == _vector.end()) || (first->first != key)) {
+    const std::size_t i = lower_bound(key);
+    if (i == size() || _keys[i] != key) {
       throw std::out_of_range("Could not find element in asc_vectormap.");
-    } else {
-      return first->second;
     }
+    return _vals[i];
   }
 
   VAL_T &operator[](const KEY_T &key) {
-    iterator first = std::lower_bound(_vector.begin(), _vector.end(), key);
-    if ((first == _vector.end()) || (first->first != key)) {
-      first = _vector.emplace(first, pair_t());
-      first->first = key;
-      return first->second;
-    } else {
-      return first->second;
+    const std::size_t i = lower_bound(key);
+    if (i == size() || _keys[i] != key) {
+      _keys.insert(_keys.begin() + i, key);
+      _vals.insert(_vals.begin() + i, VAL_T());
     }
+    return _vals[i];
   }
 
-  iterator begin() { return _vector.begin(); }
-  iterator end() { return _vector.end(); }
-  const_iterator cbegin() const { return _vector.cbegin(); }
-  const_iterator cend() const { return _vector.cend(); }
+  iterator begin() { return iterator(_keys.data(), _vals.data()); }
+  iterator end() { return begin() + size(); }
+  const_iterator begin() const {
+    return const_iterator(_keys.data(), _vals.data());
+  }
+  const_iterator end() const { return begin() + size(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
 
 private:
-  vector_t _vector;
+  std::vector<KEY_T> _keys; ///< Sorted Keys
+  std::vector<VAL_T> _vals; ///< Values parallel to the Keys
 };
 
 /**
@@ -288,9 +871,10 @@ struct asc_NodeBase {
    *
    * @param[in]  id    An internal integer identifier of the Node.
    */
-  asc_NodeBase(std::size_t id) : _node(id) {}
+  asc_NodeBase(std::size_t id) : _node(id), _slot(0) {}
   virtual ~asc_NodeBase(){}; /**< Destructor */
   std::size_t _node;         /**< Internal Node ID*/
+  std::size_t _slot;         /**< Position in the level registry */
 };
 
 /**
@@ -300,6 +884,39 @@ struct asc_NodeBase {
  */
 template <class DataType> struct asc_NodeData {
   DataType _data; /**< stored data with type DataType */
+
+  /// Get the stored data.
+  DataType &data() { return _data; }
+  /// Get the stored data.
+  const DataType &data() const { return _data; }
+  /// Copy the data of another Node.
+  void assign_data(const asc_NodeData &rhs) { _data = rhs._data; }
+};
+
+/**
+ * @brief      Marker for NodeData stored in a column of the level registry.
+ *
+ * @tparam     DataType  Typename of the data to be stored.
+ */
+template <class DataType> struct column_data {};
+
+/**
+ * @brief      Specialization for Nodes whose data lives in a column.
+ *
+ * The registry of the level owns the data of all Nodes in a contiguous
+ * column parallel to its slots and keeps `_data_ptr` pointing into it.
+ *
+ * @tparam     DataType  Typename of the data to be stored.
+ */
+template <class DataType> struct asc_NodeData<column_data<DataType>> {
+  DataType *_data_ptr = nullptr; /**< The data in the column */
+
+  /// Get the stored data.
+  DataType &data() { return *_data_ptr; }
+  /// Get the stored data.
+  const DataType &data() const { return *_data_ptr; }
+  /// Copy the data of another Node.
+  void assign_data(const asc_NodeData &rhs) { *_data_ptr = *rhs._data_ptr; }
 };
 
 /**
@@ -308,25 +925,32 @@ template <class DataType> struct asc_NodeData {
  * This exists so that the compiler knows to not allocate any memory to
  * store data when void is specified.
  */
-template <> struct asc_NodeData<void> {};
+template <> struct asc_NodeData<void> {
+  /// There is no data to copy.
+  void assign_data(const asc_NodeData &) {}
+};
 
 /**
  * @brief      Base class for Nodes with edge data.
  *
- * @tparam     KeyType   Typename of index for indexing Nodes.
+ * The data of the edge to each face is stored inline in the slot of the
+ * face in the `_down` map. Faces are linked when the Node is created so the
+ * slots are stable for the lifetime of the Node.
+ *
  * @tparam     DataType  Typename of the data stored on the edge.
+ * @tparam     k         Number of faces of the Node.
  */
-template <class KeyType, class DataType> struct asc_EdgeData {
-  /** The map of SimplexIDs to stored edge data. */
-  std::unordered_map<KeyType, DataType> _edge_data;
+template <class DataType, std::size_t k> struct asc_EdgeData {
+  /** The edge data of each face, parallel to `_down`. */
+  std::array<DataType, k> _edge_data{};
 };
 
 /**
  * @brief      Explicit specialization for Nodes with no edge data.
  *
- * @tparam     KeyType   Typename of index for indexing Nodes.
+ * @tparam     k     Number of faces of the Node.
  */
-template <class KeyType> struct asc_EdgeData<KeyType, void> {};
+template <std::size_t k> struct asc_EdgeData<void, k> {};
 
 /**
  * @brief      Base class for Node with parent nodes
@@ -340,13 +964,31 @@ template <class KeyType> struct asc_EdgeData<KeyType, void> {};
 template <class KeyType, std::size_t k, std::size_t N, class NodeDataTypes,
           class EdgeDataTypes>
 struct asc_NodeDown
-    : public asc_EdgeData<KeyType,
-                          typename util::type_get<k - 1, EdgeDataTypes>::type> {
+    : public asc_EdgeData<typename util::type_get<k - 1, EdgeDataTypes>::type,
+                          k> {
   /** Alias the typename of the parent Node */
   using DownNodeT = asc_Node<KeyType, k - 1, N, NodeDataTypes, EdgeDataTypes>;
 
   /** Map of indices to parent Node pointers*/
   asc_arraymap<KeyType, DownNodeT *, k> _down;
+
+  /**
+   * @brief      Get the data of the edge to a face.
+   *
+   * @param[in]  key   Key of the face, which must be linked.
+   *
+   * @return     Reference to the edge data.
+   */
+  auto &edge_data(const KeyType &key) {
+    assert(_down.index(key) < k);
+    return this->_edge_data[_down.index(key)];
+  }
+
+  /// @copydoc edge_data(const KeyType &)
+  auto const &edge_data(const KeyType &key) const {
+    assert(_down.index(key) < k);
+    return this->_edge_data[_down.index(key)];
+  }
   // std::map<KeyType, DownNodeT*> _down;
 };
 
@@ -556,11 +1198,11 @@ public:
   /// Iterator inequality comparison
   bool operator!=(node_id_iterator j) const { return !(*this == j); }
   /// Dereferencing the iterator produces a SimplexID.
-  Data operator*() { return Data(i->second); }
+  Data operator*() { return Data(*i); }
   /// Const version
-  const Data operator*() const { return Data(i->second); }
+  const Data operator*() const { return Data(*i); }
   /// Dereferencing the iterator produces a SimplexID.
-  typename super::pointer operator->() { return Data(i->second); }
+  typename super::pointer operator->() { return Data(*i); }
 
 protected:
   /// The iterator to wrap.
@@ -625,9 +1267,9 @@ public:
   /// Iterator inequality comparison
   bool operator!=(node_data_iterator j) const { return !(*this == j); }
   /// Dereferencing the iterator produces the data.
-  typename super::reference operator*() { return i->second->_data; }
+  typename super::reference operator*() { return (*i)->data(); }
   /// Dereferencing the iterator produces the data.
-  typename super::pointer operator->() { return i->second->_data; }
+  typename super::pointer operator->() { return &(*i)->data(); }
 
 protected:
   /// The wrapped iterator.
@@ -650,37 +1292,403 @@ inline node_data_iterator<Iter, Data> make_node_data_iterator(Iter j) {
 }
 
 /**
- * @brief      Helper to build a traits struct via expanding explicitly
- * specified
- *             traits from AbstractSimplicialComplex.
+ * @brief      An iterator adapter over the key-pointer pairs of `_up` or
+ *             `_down` which produces the SimplexIDs pointed to.
  *
- * @tparam     K     Typename for the KeyType
- * @tparam     Ts    Types of data to be stored on simplices.
+ * @tparam     Iter  Typename of the iterator
+ * @tparam     Data  Typename of the SimplexID
  */
-template <typename K, typename... Ts> struct simplicial_complex_traits_default {
-  /// Template to assign ints for all levels.
-  template <std::size_t k> using all_int = int;
-  /// Alias for KeyType
-  using KeyType = K;
-  /// The typenames of the data to be stored on simplices.
-  using NodeTypes = util::type_holder<Ts...>;
-  /// Assign all_int type to all edges
-  using EdgeTypes = typename util::int_type_map<
-      std::size_t, util::type_holder,
-      typename std::make_index_sequence<sizeof...(Ts) - 1>, all_int>::type;
-};
-} // end namespace detail
-/// @endcond
-
-/**
- * @class      simplicial_complex
- *
- * @brief      The CASC data structure for representing simplicial complexes of
- *             arbitrary dimensionality with coloring.
- *
- * You can create a CASC object by defining a struct containing the
- * traits of the complex. For example:
- * ~~~~~~~~~~~~~~~{.cpp}
+template <typename Iter, typename Data>
+struct node_link_iterator
+    : public std::iterator<std::bidirectional_iterator_tag, Data,
+                           std::ptrdiff_t, void, Data> {
+public:
+  /// Empty constructor.
+  node_link_iterator() {}
+  /// Instantiate with an iterator to wrap.
+  node_link_iterator(Iter j) : i(j) {}
+  /// Increment the iterator
+  node_link_iterator &operator++() {
+    ++i;
+    return *this;
+  }
+  /// Increment the iterator
+  node_link_iterator operator++(int) {
+    auto tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  /// Decrement the iterator
+  node_link_iterator &operator--() {
+    --i;
+    return *this;
+  }
+  /// Decrement the iterator
+  node_link_iterator operator--(int) {
+    auto tmp = *this;
+    --(*this);
+    return tmp;
+  }
+  /// Iterator comparison
+  bool operator==(node_link_iterator j) const { return i == j.i; }
+  /// Iterator inequality comparison
+  bool operator!=(node_link_iterator j) const { return !(*this == j); }
+  /// Dereferencing the iterator produces a SimplexID.
+  Data operator*() const { return Data(i->second); }
+
+protected:
+  /// The wrapped iterator.
+  Iter i;
+};
+
+/**
+ * @brief      An iterator adapter over the key-pointer pairs of `_up` or
+ *             `_down` which produces the keys.
+ *
+ * @tparam     Iter  Typename of the iterator
+ * @tparam     Key   Typename of the keys
+ */
+template <typename Iter, typename Key>
+struct node_key_iterator
+    : public std::iterator<std::bidirectional_iterator_tag, Key,
+                           std::ptrdiff_t, const Key *, const Key &> {
+public:
+  /// Empty constructor.
+  node_key_iterator() {}
+  /// Instantiate with an iterator to wrap.
+  node_key_iterator(Iter j) : i(j) {}
+  /// Increment the iterator
+  node_key_iterator &operator++() {
+    ++i;
+    return *this;
+  }
+  /// Increment the iterator
+  node_key_iterator operator++(int) {
+    auto tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  /// Decrement the iterator
+  node_key_iterator &operator--() {
+    --i;
+    return *this;
+  }
+  /// Decrement the iterator
+  node_key_iterator operator--(int) {
+    auto tmp = *this;
+    --(*this);
+    return tmp;
+  }
+  /// Iterator comparison
+  bool operator==(node_key_iterator j) const { return i == j.i; }
+  /// Iterator inequality comparison
+  bool operator!=(node_key_iterator j) const { return !(*this == j); }
+  /// Dereferencing the iterator produces the key.
+  const Key &operator*() const { return i->first; }
+  /// Dereferencing the iterator produces the key.
+  const Key *operator->() const { return &i->first; }
+
+protected:
+  /// The wrapped iterator.
+  Iter i;
+};
+
+/**
+ * @brief      Helper to build a traits struct via expanding explicitly
+ * specified
+ *             traits from AbstractSimplicialComplex.
+ *
+ * @tparam     K     Typename for the KeyType
+ * @tparam     Ts    Types of data to be stored on simplices.
+ */
+template <typename K, typename... Ts> struct simplicial_complex_traits_default {
+  /// Template to assign ints for all levels.
+  template <std::size_t k> using all_int = int;
+  /// Alias for KeyType
+  using KeyType = K;
+  /// The typenames of the data to be stored on simplices.
+  using NodeTypes = util::type_holder<Ts...>;
+  /// Assign all_int type to all edges
+  using EdgeTypes = typename util::int_type_map<
+      std::size_t, util::type_holder,
+      typename std::make_index_sequence<sizeof...(Ts) - 1>, all_int>::type;
+};
+
+/**
+ * @brief      Select the allocator used to store Nodes of type T.
+ *
+ * Defaults to casc::node_pool unless the traits define an alias template
+ * `NodeAllocator<T>`.
+ *
+ * @tparam     traits  The complex traits.
+ * @tparam     T       Typename of the Node.
+ */
+template <typename traits, typename T, typename = void> struct node_allocator {
+  /// The default pooled allocator
+  using type = node_pool<T>;
+};
+
+/**
+ * @brief      Specialization for traits which specify a NodeAllocator.
+ *
+ * @tparam     traits  The complex traits.
+ * @tparam     T       Typename of the Node.
+ */
+template <typename traits, typename T>
+struct node_allocator<
+    traits, T, util::void_t<typename traits::template NodeAllocator<T>>> {
+  /// The user specified allocator
+  using type = typename traits::template NodeAllocator<T>;
+};
+
+/**
+ * @brief      Select the container used by SimplexSet to store simplices of
+ *             type T.
+ *
+ * Defaults to casc::NodeSet unless the traits define an alias template
+ * `SimplexSetContainer<T>`. Defined after NodeSet.
+ *
+ * @tparam     traits  The complex traits.
+ * @tparam     T       Typename of the SimplexID.
+ */
+template <typename traits, typename T, typename = void>
+struct simplex_set_container;
+
+/// Placeholder used when the traits do not request a name index.
+struct no_name_index {};
+
+/// A disabled name index uses no memory.
+inline std::size_t name_index_bytes(const no_name_index &) { return 0; }
+
+/**
+ * @brief      Estimate the heap bytes of a hashed name index.
+ *
+ * @param[in]  index  The index.
+ *
+ * @tparam     Map    Typename of the unordered map.
+ *
+ * @return     Estimated number of bytes.
+ */
+template <typename Map> std::size_t name_index_bytes(const Map &index) {
+  using value_type = typename Map::value_type;
+  return index.bucket_count() * sizeof(void *) +
+         index.size() * (sizeof(value_type) + sizeof(void *));
+}
+
+/**
+ * @brief      Select the index of the simplices of a level by name.
+ *
+ * Defaults to no index unless the traits define an alias template
+ * `NameIndex<Name, T>`.
+ *
+ * @tparam     traits  The complex traits.
+ * @tparam     Name    Typename of the sorted simplex name.
+ * @tparam     T       Typename of the Node pointer.
+ */
+template <typename traits, typename Name, typename T, typename = void>
+struct name_index {
+  /// No index by default
+  using type = no_name_index;
+};
+
+/**
+ * @brief      Specialization for traits which specify a NameIndex.
+ *
+ * @tparam     traits  The complex traits.
+ * @tparam     Name    Typename of the sorted simplex name.
+ * @tparam     T       Typename of the Node pointer.
+ */
+template <typename traits, typename Name, typename T>
+struct name_index<
+    traits, Name, T,
+    util::void_t<typename traits::template NameIndex<Name, T>>> {
+  /// The user specified map
+  using type = typename traits::template NameIndex<Name, T>;
+};
+
+/**
+ * @brief      Whether the NodeData of each level is stored in a column.
+ *
+ * Defaults to false unless the traits define `ColumnarNodeData` as
+ * std::true_type.
+ *
+ * @tparam     traits  The complex traits.
+ */
+template <typename traits, typename = void>
+struct columnar_node_data : std::false_type {};
+
+/**
+ * @brief      Specialization for traits which specify ColumnarNodeData.
+ *
+ * @tparam     traits  The complex traits.
+ */
+template <typename traits>
+struct columnar_node_data<traits,
+                          util::void_t<typename traits::ColumnarNodeData>>
+    : std::integral_constant<bool, traits::ColumnarNodeData::value> {};
+
+/**
+ * @brief      Typename of the data member of a Node.
+ *
+ * @tparam     Columnar  Whether data is stored in a column.
+ * @tparam     T         Typename of the user data.
+ */
+template <bool Columnar, typename T> struct node_storage {
+  /// Column storage only applies to levels with data
+  using type = typename std::conditional<Columnar && !std::is_void<T>::value,
+                                         column_data<T>, T>::type;
+};
+
+/**
+ * @brief      Typename of the data stored in the column of a registry.
+ *
+ * @tparam     Columnar  Whether data is stored in a column.
+ * @tparam     T         Typename of the user data.
+ */
+template <bool Columnar, typename T> struct column_storage {
+  /// Levels without a column are marked by void
+  using type = typename std::conditional<Columnar && !std::is_void<T>::value,
+                                         T, void>::type;
+};
+} // end namespace detail
+/// @endcond
+
+/**
+ * @brief      Hash of a simplex name.
+ */
+struct hashName {
+  /**
+   * @brief      Compute the hash.
+   *
+   * @param[in]  name  The sorted name of a simplex.
+   *
+   * @tparam     KeyType  Typename of the keys.
+   * @tparam     k        Number of keys.
+   *
+   * @return     Resultant hash.
+   */
+  template <typename KeyType, std::size_t k>
+  std::size_t operator()(const std::array<KeyType, k> &name) const {
+    std::size_t h = 0;
+    for (const auto &key : name) {
+      h ^= std::hash<KeyType>()(key) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+};
+
+/**
+ * @brief      Helpful alias defining a hashed index of simplices by name.
+ *
+ * Select it as the `NameIndex` of the complex traits to look up simplices
+ * by name in constant time:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * struct complex_traits{
+ *     using KeyType = int;
+ *     using NodeTypes = util::type_holder<int,int,int,int>;
+ *     using EdgeTypes = util::type_holder<int,int,int>;
+ *     template <typename Name, typename T>
+ *     using NameIndex = casc::NameMap<Name, T>;
+ * };
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     Name  Typename of the sorted simplex name.
+ * @tparam     T     Typename of the Node pointer.
+ */
+template <typename Name, typename T>
+using NameMap = std::unordered_map<Name, T, hashName>;
+
+/**
+ * @brief      Memory footprint of one level of a simplicial_complex.
+ *
+ * All sizes are in bytes except for the node count. Heap usage of the
+ * standard library containers is estimated from their size and capacity and
+ * does not include the bookkeeping of the system allocator.
+ */
+struct level_memory {
+  /// Number of live simplices.
+  std::size_t nodes = 0;
+  /// Bytes of the live Nodes themselves, i.e., nodes * sizeof(Node).
+  std::size_t node_bytes = 0;
+  /// Bytes reserved by the Node allocator including free slots.
+  std::size_t pool_bytes = 0;
+  /// Bytes of unused asc_arraymap entries inside the live Nodes.
+  std::size_t down_slack = 0;
+  /// Heap bytes of the asc_vectormap coboundary storage. Without a scan
+  /// only the used entries are counted, which excludes up_slack.
+  std::size_t up_bytes = 0;
+  /// Bytes of unused asc_vectormap capacity, included in up_bytes.
+  std::size_t up_slack = 0;
+  /// Heap bytes of the level registry and any data column, including
+  /// tombstones.
+  std::size_t registry_bytes = 0;
+  /// Estimated heap bytes of the name index, if enabled.
+  std::size_t index_bytes = 0;
+
+  /// Total bytes attributed to the level.
+  std::size_t total() const {
+    return pool_bytes + up_bytes + registry_bytes + index_bytes;
+  }
+};
+
+/**
+ * @brief      Memory footprint of a simplicial_complex.
+ *
+ * @tparam     N     Number of levels in the complex.
+ */
+template <std::size_t N> struct complex_memory {
+  /// Footprint of each level.
+  std::array<level_memory, N> levels;
+  /// Heap bytes of the tracker of unused vertex keys, which grow linearly
+  /// with the number of free key intervals.
+  std::size_t tracker_bytes = 0;
+
+  /// Total bytes used by the complex.
+  std::size_t total() const {
+    std::size_t rval = tracker_bytes;
+    for (const auto &l : levels) {
+      rval += l.total();
+    }
+    return rval;
+  }
+
+  /**
+   * @brief      Print a table of the footprint per level.
+   *
+   * @param      output  The output stream.
+   * @param[in]  stats   The footprint to print.
+   *
+   * @return     A handle to the output stream.
+   */
+  friend std::ostream &operator<<(std::ostream &output,
+                                  const complex_memory &stats) {
+    output << "level nodes node_bytes pool_bytes down_slack up_bytes "
+              "up_slack registry_bytes index_bytes\n";
+    for (std::size_t k = 0; k < N; ++k) {
+      const auto &l = stats.levels[k];
+      output << k << " " << l.nodes << " " << l.node_bytes << " "
+             << l.pool_bytes << " " << l.down_slack << " " << l.up_bytes << " "
+             << l.up_slack << " " << l.registry_bytes << " "
+             << l.index_bytes << "\n";
+    }
+    output << "tracker_bytes " << stats.tracker_bytes << "\n";
+    output << "total " << stats.total() << "\n";
+    return output;
+  }
+};
+
+template <typename Complex, typename Index> class frozen_complex;
+template <typename Complex> struct SimplexSet;
+
+/**
+ * @class      simplicial_complex
+ *
+ * @brief      The CASC data structure for representing simplicial complexes of
+ *             arbitrary dimensionality with coloring.
+ *
+ * You can create a CASC object by defining a struct containing the
+ * traits of the complex. For example:
+ * ~~~~~~~~~~~~~~~{.cpp}
  * struct complex_traits{
  *     using KeyType = int;
  *     using NodeTypes = util::type_holder<int,int,int,int>;
@@ -692,6 +1700,23 @@ template <typename K, typename... Ts> struct simplicial_complex_traits_default {
  * This is the preferred method for creating a new CASC type. Alternatively you
  * can use the ::AbstractSimplicialComplex alias to build a struct for you.
  *
+ * Simplices are found by name by walking the cofaces of each key in turn.
+ * Traits which define `NameIndex`, usually as casc::NameMap, additionally
+ * keep a hash index per level so that get_simplex_up() and exists() take
+ * constant time, at the cost of one map entry per simplex. This pays off
+ * when vertices have many cofaces; on low valence meshes the walk is as
+ * fast.
+ *
+ * The cofaces of a simplex are kept sorted by key. Trivially copyable keys
+ * aligned no more strictly than a pointer, such as the integer types, are
+ * stored in the same allocation as the coface pointers; other keys use a
+ * pair of vectors, which costs an extra allocation per simplex.
+ *
+ * Thread safety: any number of threads may concurrently call const member
+ * functions, traverse the complex and read or write the data of distinct
+ * simplices. Inserting or removing simplices requires exclusive access.
+ * See parallel_for_each() for processing a level on all cores.
+ *
  * @tparam     traits  A struct defining the dimension of the complex and data
  *                     to be stored on each node and edge.
  */
@@ -701,6 +1726,8 @@ public:
   using KeyType = typename traits::KeyType;
   /// Typenames of the data stored on simplices.
   using NodeDataTypes = typename traits::NodeTypes;
+  /// Whether the data of each level is stored in a contiguous column.
+  using ColumnarData = detail::columnar_node_data<traits>;
   /// Typenames of the data stored on edges.
   using EdgeDataTypes = typename traits::EdgeTypes;
   /// Type of this
@@ -715,12 +1742,30 @@ public:
   using LevelIndex = typename std::make_index_sequence<numLevels>;
 
 private:
+  /// Alias detail::node_storage<ColumnarData, T> as NodeStorage<T>
+  template <typename T>
+  using NodeStorage =
+      typename detail::node_storage<ColumnarData::value, T>::type;
+  /// Typenames of the data members of the Nodes.
+  using NodeStorageTypes =
+      typename util::type_map<NodeDataTypes, NodeStorage>::type;
   /// Alias templated asc_node<...> as Node<k>
   template <std::size_t k>
   using Node =
-      detail::asc_Node<KeyType, k, topLevel, NodeDataTypes, EdgeDataTypes>;
+      detail::asc_Node<KeyType, k, topLevel, NodeStorageTypes, EdgeDataTypes>;
   /// Alias Node<k>* as NodePtr<k>
   template <std::size_t k> using NodePtr = Node<k> *;
+  /// Alias the allocator used to store Node<k>
+  template <std::size_t k>
+  using NodeAllocator = typename detail::node_allocator<traits, Node<k>>::type;
+  /// Alias the index of Node<k> by sorted name
+  template <std::size_t k>
+  using NameIndex = typename detail::name_index<traits, std::array<KeyType, k>,
+                                                NodePtr<k>>::type;
+  /// Whether the traits request an index by name
+  using NameIndexed =
+      std::integral_constant<bool, !std::is_same<NameIndex<1>,
+                                                 detail::no_name_index>::value>;
 
 public:
   /** Convenience alias for the user specified NodeData<k> typename */
@@ -730,9 +1775,23 @@ public:
   template <std::size_t k>
   using EdgeData = typename util::type_get<k, EdgeDataTypes>::type;
 
+  /// Container used by SimplexSet to store the SimplexIDs of one level.
+  template <typename T>
+  using SimplexSetContainer =
+      typename detail::simplex_set_container<traits, T>::type;
+
+  /// frozen_complex reads the nodes directly when flattening.
+  template <typename Complex, typename Index> friend class frozen_complex;
+
   friend struct SimplexID; /**< SimplexID is a friend of
                               simplicial_complex */
 
+  /// Lazy range over the coboundary keys of a k-simplex.
+  template <std::size_t k>
+  using CoverRange = util::range<detail::node_key_iterator<
+      typename detail::asc_vectormap<KeyType, NodePtr<k + 1>>::const_iterator,
+      KeyType>>;
+
   /**
    * @brief      A handle for a simplex object in the complex.
    *
@@ -805,15 +1864,31 @@ public:
       return reinterpret_cast<std::uintptr_t>(ptr);
     }
 
+    /**
+     * @brief      Position of the simplex in the registry of its level.
+     *
+     * Indices are bounded by the size of the level plus its removed slots
+     * and stay stable until revision() changes. They are meant for
+     * indexing flat per-simplex arrays such as visited_set.
+     */
+    std::size_t index() const { return ptr->_slot; }
+
+    /**
+     * @brief      Dereferencing a SimplexID returns the data stored.
+     *
+     * With ColumnarNodeData the data of a level lives in one vector,
+     * so references returned by operator*() and data() are invalidated
+     * by inserting or removing simplices of the same level. The
+     * SimplexID itself stays valid; dereference it again.
+     */
+    complex::NodeData<k> const &operator*() const { return ptr->data(); }
     /// Dereferencing a SimplexID returns the data stored.
-    complex::NodeData<k> const &operator*() const { return ptr->_data; }
-    /// Dereferencing a SimplexID returns the data stored.
-    complex::NodeData<k> &operator*() { return ptr->_data; }
+    complex::NodeData<k> &operator*() { return ptr->data(); }
 
     /// Get a handle to the stored data.
-    complex::NodeData<k> const &data() const { return ptr->_data; }
+    complex::NodeData<k> const &data() const { return ptr->data(); }
     /// Get a handle to the stored data.
-    complex::NodeData<k> &data() { return ptr->_data; }
+    complex::NodeData<k> &data() { return ptr->data(); }
 
     /**
      * @brief      Gets the name of a simplex as an std::Array.
@@ -858,6 +1933,15 @@ public:
       cover_insert(std::back_inserter(rval));
       return rval;
     }
+
+    /**
+     * @brief      Iterate over the coboundary keys without copying them.
+     *
+     * @return     A range over the coboundary keys.
+     */
+    CoverRange<k> cover_view() const {
+      return CoverRange<k>(ptr->_up.cbegin(), ptr->_up.cend());
+    }
     // }
 
     /**
@@ -1001,7 +2085,7 @@ public:
        * @return     Handle to the output stream.
        */
       static std::ostream &apply(std::ostream &out, const SimplexID<l> &nid) {
-        auto down = (*nid.ptr)._down;
+        const auto &down = (*nid.ptr)._down;
         for (auto it = down.cbegin(); it != down.cend() - 1; ++it) {
           out << it->first << ",";
         }
@@ -1112,9 +2196,9 @@ public:
     KeyType key() const { return edge; }
 
     /// Return the data stored on the edge.
-    auto const &data() const { return ptr->_edge_data[edge]; }
+    auto const &data() const { return ptr->edge_data(edge); }
     /// Return the data stored on the edge.
-    auto &data() { return ptr->_edge_data[edge]; }
+    auto &data() { return ptr->edge_data(edge); }
 
     /**
      * @brief      Get the coboundary simplex.
@@ -1140,7 +2224,7 @@ public:
   /**
    * @brief      Default constructor
    */
-  simplicial_complex() : node_count(0) {
+  simplicial_complex() : node_count(0), revision_count(0) {
     for (auto &x : level_count) // Initialize level_count to 0 for all
                                 // levels
     {
@@ -1150,16 +2234,94 @@ public:
     _root = create_node<0>();
   }
 
+  simplicial_complex(const simplicial_complex &) = delete;
+  simplicial_complex &operator=(const simplicial_complex &) = delete;
+
+  /**
+   * @brief      Move constructor.
+   *
+   * Takes ownership of all simplices of 'rhs' which is left as an empty
+   * complex.
+   *
+   * @param      rhs   The complex to move from.
+   */
+  simplicial_complex(simplicial_complex &&rhs)
+      : _root(rhs._root), node_count(rhs.node_count),
+        revision_count(rhs.revision_count), level_count(rhs.level_count),
+        levels(std::move(rhs.levels)), pools(std::move(rhs.pools)),
+        unused_vertices(std::move(rhs.unused_vertices)),
+        names(std::move(rhs.names)) {
+    rhs.reset();
+  }
+
+  /**
+   * @brief      Move assignment.
+   *
+   * @param      rhs   The complex to move from.
+   *
+   * @return     Reference to this.
+   */
+  simplicial_complex &operator=(simplicial_complex &&rhs) {
+    if (this != &rhs) {
+      util::int_for_each<std::size_t, LevelIndex>(DestroyLevel(), this);
+      _root = rhs._root;
+      node_count = rhs.node_count;
+      revision_count = std::max(revision_count, rhs.revision_count) + 1;
+      level_count = rhs.level_count;
+      levels = std::move(rhs.levels);
+      pools = std::move(rhs.pools);
+      unused_vertices = std::move(rhs.unused_vertices);
+      names = std::move(rhs.names);
+      rhs.reset();
+    }
+    return *this;
+  }
+
+  /**
+   * @brief      Make a deep copy of the complex.
+   *
+   * Every Node is copied together with its data and edge data, then the
+   * `_up` and `_down` maps of the copies are rewired through a table mapping
+   * the registry slot of each original Node to its copy. No names are looked
+   * up and no maps are searched, so the copy takes time linear in the
+   * number of simplices. Internal node IDs and unused vertex keys are kept,
+   * and the levels of the copy iterate in the same order as the original.
+   *
+   * The copy constructor is deleted so that forking a mesh is explicit.
+   * SimplexIDs of the original do not refer to the copy.
+   *
+   * Example -- try a decimation on a fork:
+   * ~~~~~~~~~~~~~~~{.cpp}
+   * auto trial = mesh.clone();
+   * casc::decimate_by_cost(trial, 1000, cost, Callback<Mesh>());
+   * if (quality(trial) > quality(mesh))
+   *   mesh = std::move(trial);
+   * ~~~~~~~~~~~~~~~
+   *
+   * @return     The copy.
+   */
+  type_this clone() const {
+    type_this rval;
+    util::int_for_each<std::size_t, LevelIndex>(DestroyLevel(), &rval);
+    RemapLevel remap;
+    util::int_for_each<std::size_t, LevelIndex>(CopyLevel(), this, &rval,
+                                                remap);
+    util::int_for_each<std::size_t, LevelIndex>(RelinkLevel(), &rval, remap);
+    rval._root = std::get<0>(remap)[_root->_slot];
+    rval.node_count = node_count;
+    rval.unused_vertices = unused_vertices;
+    return rval;
+  }
+
   /**
    * @brief      Destruct the simplicial complex.
    *
-   * Recursively go over the simplices and remove them prior to
-   * destructing
-   * the CASC object itself.
+   * Since the whole complex is going away there is no need to unlink
+   * simplices from each other. Each node is destructed in place and the
+   * storage is returned to the allocators which free their blocks in bulk.
    */
   ~simplicial_complex() {
-    std::size_t count;
-    remove_recurse<0, 0>::apply(this, &_root, &_root + 1, count);
+    util::int_for_each<std::size_t, LevelIndex>(DestroyLevel(), this);
   }
 
   /**
@@ -1191,17 +2353,19 @@ public:
    * ~~~~~~~~~~~~~~~
    *
    * @param[in]  s     A C style array of vertices of simplex 's'.
-   * @param[in]  data  The data to be stored at the simplex 's'.
+   * @param[in]  data  The data to be stored at the simplex 's'. It is
+   *                   copied before any node is created, so it may refer to
+   *                   the data of another simplex of the complex.
    *
    * @tparam     n     Dimension of simplex 's'.
    */
   template <std::size_t n>
-  SimplexID<n> insert(const KeyType (&s)[n], const NodeData<n> &data) {
+  SimplexID<n> insert(const KeyType (&s)[n], NodeData<n> data) {
     for (const KeyType *p = s; p < s + n; ++p) {
       unused_vertices.remove(*p);
     }
     Node<n> *rval = insert_full<0, n>::apply(this, _root, s);
-    rval->_data = data;
+    rval->data() = std::move(data);
     return rval;
   }
 
@@ -1226,31 +2390,75 @@ public:
    *             along with data.
    *
    * @param[in]  s     Array of vertices comprising 's'.
-   * @param[in]  data  The data to be stored at the simplex 's'.
+   * @param[in]  data  The data to be stored at the simplex 's'. It is
+   *                   copied before any node is created.
    *
    * @tparam     n     Dimension of simplex 's'.
    */
   template <std::size_t n>
-  SimplexID<n> insert(const std::array<KeyType, n> &s,
-                      const NodeData<n> &data) {
+  SimplexID<n> insert(const std::array<KeyType, n> &s, NodeData<n> data) {
     for (KeyType x : s) {
       unused_vertices.remove(x);
     }
     Node<n> *rval = insert_full<0, n>::apply(this, _root, s.data());
-    rval->_data = data;
+    rval->data() = std::move(data);
     return rval;
   }
 
   /**
-   * @brief      Add a new vertex to the complex.
+   * @brief      Insert many simplices and all of their sub-simplices at once.
    *
-   * A list of currently unused indices are tracked using a B-tree. This
-   * function retrieves a currently unused index and creates a new vertex
-   * while returning the new key.
+   * The sub-simplices of all inputs are generated level by level, sorted and
+   * deduplicated so that each shared face is looked up and linked exactly
+   * once. Simplices which already exist in the complex are reused. This is
+   * much faster than calling insert() for every simplex when loading a mesh.
    *
-   * @return     The key of the new vertex.
-   */
-  KeyType add_vertex() {
+   * Example -- insert the simplices {1,2,3} and {2,3,4}:
+   * ~~~~~~~~~~~~~~~{.cpp}
+   * int faces[] = {1,2,3, 2,3,4};
+   * int data[] = {5, 6};
+   * mesh.bulk_insert<3>(faces, 2, data);
+   * ~~~~~~~~~~~~~~~
+   *
+   * @param[in]  s      Pointer to count*n keys. Simplex i is named by
+   *                    s[i*n] ... s[i*n+n-1].
+   * @param[in]  count  The number of simplices to insert.
+   * @param[in]  data   Optional pointer to count values to be stored on the
+   *                    simplices. If a simplex is repeated the last value is
+   *                    kept. With ColumnarNodeData it must not point into
+   *                    the data of the complex, which may move.
+   *
+   * @tparam     n      Dimension of the simplices.
+   */
+  template <std::size_t n>
+  void bulk_insert(const KeyType *s, std::size_t count,
+                   const NodeData<n> *data = nullptr) {
+    static_assert(n > 0 && n <= topLevel,
+                  "Can only bulk insert vertices through facets");
+    std::vector<std::array<KeyType, n>> names(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      std::copy(s + i * n, s + (i + 1) * n, names[i].begin());
+      std::sort(names[i].begin(), names[i].end());
+    }
+
+    bulk_table<0> root;
+    root.emplace_back(std::array<KeyType, 0>{}, _root);
+    bulk_table<n> top = bulk_build<1, n>::apply(this, names, std::move(root));
+    if (data != nullptr) {
+      bulk_assign<n>(top, names, data, std::is_void<NodeData<n>>());
+    }
+  }
+
+  /**
+   * @brief      Add a new vertex to the complex.
+   *
+   * A list of currently unused indices are tracked using a B-tree. This
+   * function retrieves a currently unused index and creates a new vertex
+   * while returning the new key.
+   *
+   * @return     The key of the new vertex.
+   */
+  KeyType add_vertex() {
     KeyType v[1] = {unused_vertices.pop()};
     insert<1>(v);
     return v[0];
@@ -1267,6 +2475,32 @@ public:
     return v[0];
   }
 
+  /**
+   * @brief      Add many new vertices to the complex.
+   *
+   * The keys are taken from the tracker of unused indices in consecutive
+   * runs rather than one B-tree update per vertex.
+   *
+   * @param[in]  n         Number of vertices to add.
+   * @param[out] out       Output iterator receiving the new keys.
+   *
+   * @tparam     OutputIt  Typename of the output iterator.
+   *
+   * @return     Iterator past the last key written.
+   */
+  template <typename OutputIt>
+  OutputIt add_vertices(std::size_t n, OutputIt out) {
+    std::vector<KeyType> keys;
+    keys.reserve(n);
+    unused_vertices.pop(n, std::back_inserter(keys));
+    std::get<1>(levels).reserve(std::get<1>(levels).slots() + n);
+    for (const KeyType &v : keys) {
+      insert_full<0, 1>::apply(this, _root, &v);
+      *out++ = v;
+    }
+    return out;
+  }
+
   /**
    * @brief      Apply a lambda function the name of a simplex.
    *
@@ -1329,12 +2563,12 @@ public:
    */
   template <std::size_t n>
   SimplexID<n> get_simplex_up(const KeyType (&s)[n]) const {
-    return get_recurse<0, n>::apply(s, _root);
+    return find_name<n>(s, Indexed<n>());
   }
 
   template <std::size_t n>
   SimplexID<n> get_simplex_up(const std::array<KeyType, n> &arr) const {
-    return get_recurse<0, n>::apply(arr.data(), _root);
+    return find_name<n>(arr.data(), Indexed<n>());
   }
 
   /**
@@ -1484,6 +2718,68 @@ public:
     return rval;
   }
 
+  /**
+   * @brief      Iterate over the coboundary keys of a simplex in place.
+   *
+   * Unlike get_cover(SimplexID<k>) no container is built. The range is
+   * invalidated when a coface of `id` is inserted or removed.
+   *
+   * @param[in]  id    The identifier of a simplex.
+   *
+   * @tparam     k     The dimension of the simplex.
+   *
+   * @return     A range over the coboundary keys.
+   */
+  template <std::size_t k>
+  CoverRange<k> cover_view(const SimplexID<k> id) const {
+    return CoverRange<k>(id.ptr->_up.cbegin(), id.ptr->_up.cend());
+  }
+
+  /// Lazy range over the cofaces of a k-simplex.
+  template <std::size_t k>
+  using UpRange = util::range<detail::node_link_iterator<
+      typename detail::asc_vectormap<KeyType, NodePtr<k + 1>>::const_iterator,
+      SimplexID<k + 1>>>;
+
+  /// Lazy range over the faces of a k-simplex.
+  template <std::size_t k>
+  using DownRange = util::range<detail::node_link_iterator<
+      typename detail::asc_arraymap<KeyType, NodePtr<k - 1>,
+                                    k>::const_iterator,
+      SimplexID<k - 1>>>;
+
+  /**
+   * @brief      Iterate over the cofaces of a simplex in place.
+   *
+   * Allocation free alternative to up(SimplexID<k>). The range is
+   * invalidated when a coface of `id` is inserted or removed.
+   *
+   * @param[in]  id    The simplex of interest.
+   *
+   * @tparam     k     The dimension of the simplex.
+   *
+   * @return     Range of (k+1)-simplices of which `id` is a face.
+   */
+  template <std::size_t k> UpRange<k> up_view(const SimplexID<k> id) const {
+    return UpRange<k>(id.ptr->_up.cbegin(), id.ptr->_up.cend());
+  }
+
+  /**
+   * @brief      Iterate over the faces of a simplex in place.
+   *
+   * Allocation free alternative to down(SimplexID<k>).
+   *
+   * @param[in]  id    The simplex of interest.
+   *
+   * @tparam     k     The dimension of the simplex.
+   *
+   * @return     Range of (k-1)-simplices which are faces of `id`.
+   */
+  template <std::size_t k>
+  DownRange<k> down_view(const SimplexID<k> id) const {
+    return DownRange<k>(id.ptr->_down.cbegin(), id.ptr->_down.cend());
+  }
+
   /**
    * @brief      Get the coboundary of a set of simplices.
    *
@@ -1568,6 +2864,34 @@ public:
     }
   }
 
+  template <std::size_t k, std::size_t N, class InsertIter>
+  void up(const util::small_set<SimplexID<k>, N> &simplices,
+          InsertIter iter) const {
+    for (auto simplex : simplices) {
+      up(simplex, iter);
+    }
+  }
+
+  /**
+   * @brief      Get the coboundary of a small set of simplices.
+   *
+   * No memory is allocated as long as the result has at most N simplices.
+   *
+   * @param      simplices  The set of simplices
+   *
+   * @tparam     k          The dimension of the simplices.
+   * @tparam     N          Inline capacity of the sets.
+   *
+   * @return     The set of coboundary simplices.
+   */
+  template <std::size_t k, std::size_t N>
+  util::small_set<SimplexID<k + 1>, N>
+  up(const util::small_set<SimplexID<k>, N> &simplices) const {
+    util::small_set<SimplexID<k + 1>, N> rval;
+    up(simplices, std::inserter(rval, rval.end()));
+    return rval;
+  }
+
   /**
    * @brief      Get the boundary of a set of simplices.
    *
@@ -1653,6 +2977,34 @@ public:
     }
   }
 
+  template <std::size_t k, std::size_t N, class InsertIter>
+  void down(const util::small_set<SimplexID<k>, N> &simplices,
+            InsertIter iter) const {
+    for (auto simplex : simplices) {
+      down(simplex, iter);
+    }
+  }
+
+  /**
+   * @brief      Get the boundary of a small set of simplices.
+   *
+   * No memory is allocated as long as the result has at most N simplices.
+   *
+   * @param      simplices  The set of simplices
+   *
+   * @tparam     k          The dimension of the simplices.
+   * @tparam     N          Inline capacity of the sets.
+   *
+   * @return     The set of boundary simplices.
+   */
+  template <std::size_t k, std::size_t N>
+  util::small_set<SimplexID<k - 1>, N>
+  down(const util::small_set<SimplexID<k>, N> &simplices) const {
+    util::small_set<SimplexID<k - 1>, N> rval;
+    down(simplices, std::inserter(rval, rval.end()));
+    return rval;
+  }
+
   /**
    * @brief      Gets the edge up from a simplex.
    *
@@ -1723,8 +3075,7 @@ public:
    * @return     True if the simplex is in the complex.
    */
   template <std::size_t k> bool exists(const KeyType (&s)[k]) const {
-
-    return get_recurse<0, k>::apply(s, _root) != nullptr;
+    return find_name<k>(s, Indexed<k>()) != nullptr;
   }
 
   /**
@@ -1738,13 +3089,84 @@ public:
     return std::get<k>(levels).size();
   }
 
-  // template <std::size_t k> using SimplexIDIterator =
-  // detail::node_id_iterator<typename detail::map<NodePtr<k>>::iterator,
-  // SimplexID<k>>;
+  /**
+   * @brief      Get a counter which changes whenever simplices are inserted
+   *             or removed.
+   *
+   * Derived indexes such as halfedge_view compare it against the revision
+   * they were built from to tell when they are out of date. Changes to the
+   * data of simplices do not count, but renumbering SimplexID::index() in
+   * get_data_column() does.
+   *
+   * @return     The revision.
+   */
+  std::size_t revision() const { return revision_count; }
+
+  /**
+   * @brief      Get the number of registry slots of dimension 'k'.
+   *
+   * Slots of removed simplices are counted until the registry is
+   * compacted, so SimplexID::index() is always smaller than this.
+   *
+   * @tparam     k     The dimension of interest.
+   *
+   * @return     Number of slots.
+   */
+  template <std::size_t k> std::size_t slots() const {
+    return std::get<k>(levels).slots();
+  }
+
+  /// Typename of the memory footprint report.
+  using MemoryStats = complex_memory<numLevels>;
+
+  /**
+   * @brief      Report the memory footprint of each level.
+   *
+   * Node counts and the sizes of the allocators, registries, data columns
+   * and name indexes are read in constant time per level. Without a scan
+   * the coface storage is estimated from the number of faces of the next
+   * level, one entry each, and the slack is reported as zero. If @p scan is
+   * true the Nodes are also visited once, without allocating, to measure
+   * the capacity and slack of the face and coface maps. Edge data is stored
+   * inline in the Nodes. Sizing the vertex key tracker walks its B-tree, in
+   * time linear in the number of free key intervals.
+   *
+   * @param[in]  scan  Whether to visit the Nodes.
+   *
+   * @return     The footprint.
+   */
+  MemoryStats memory_stats(bool scan = true) const {
+    MemoryStats stats;
+    util::int_for_each<std::size_t, LevelIndex>(MemoryLevel(), this, stats,
+                                                scan);
+    stats.tracker_bytes = unused_vertices.bytes();
+    return stats;
+  }
+
+  /**
+   * @brief      Get the simplex in a registry slot.
+   *
+   * @param[in]  i     Slot index smaller than slots<k>().
+   *
+   * @tparam     k     The dimension of the simplex.
+   *
+   * @return     The simplex, or a SimplexID wrapping nullptr if the slot
+   *             belongs to a removed simplex.
+   */
+  template <std::size_t k> SimplexID<k> get_simplex_at(std::size_t i) const {
+    return SimplexID<k>(std::get<k>(levels)[i]);
+  }
+
   /**
    * @brief      Create an iterator to traverse the SimplexIDs of a
    *             dimension.
    *
+   * The range pins the level: removed k-simplices are not squeezed out
+   * while it, or a copy of it, exists. Inserting k-simplices while
+   * iterating it therefore neither skips nor repeats simplices, and
+   * SimplexID::index() is stable. A stored range keeps the tombstones of
+   * the level until it is destroyed.
+   *
    * @tparam     k     The simplex dimension to traverse.
    *
    * @return     An iterator across all k-simplices of the complex.
@@ -1756,7 +3178,8 @@ public:
         detail::make_node_id_iterator<decltype(begin), SimplexID<k>>(begin);
     auto data_end =
         detail::make_node_id_iterator<decltype(end), SimplexID<k>>(end);
-    return util::make_range(data_begin, data_end);
+    return detail::make_level_range(data_begin, data_end,
+                                    std::get<k>(levels));
   }
 
   /**
@@ -1775,16 +3198,16 @@ public:
             begin);
     auto data_end =
         detail::make_node_id_iterator<decltype(end), const SimplexID<k>>(end);
-    return util::make_range(data_begin, data_end);
+    return detail::make_level_range(data_begin, data_end,
+                                    std::get<k>(levels));
   }
 
-  // template <std::size_t k> using DataIterator =
-  // detail::node_data_iterator<typename std::map<std::size_t,
-  // NodePtr<k>>::iterator, NodeData<k>>;
   /**
    * @brief      Create an iterator to traverse the simplex data of a
    *             dimension.
    *
+   * The range pins the level like get_level_id().
+   *
    * @tparam     k     The simplex dimension to traverse.
    *
    * @return     An iterator across the data of all k-simplices in the
@@ -1797,7 +3220,8 @@ public:
         detail::make_node_data_iterator<decltype(begin), NodeData<k>>(begin);
     auto data_end =
         detail::make_node_data_iterator<decltype(end), NodeData<k>>(end);
-    return util::make_range(data_begin, data_end);
+    return detail::make_level_range(data_begin, data_end,
+                                    std::get<k>(levels));
   }
 
   /**
@@ -1817,7 +3241,58 @@ public:
             begin);
     auto data_end =
         detail::make_node_data_iterator<decltype(end), const NodeData<k>>(end);
-    return util::make_range(data_begin, data_end);
+    return detail::make_level_range(data_begin, data_end,
+                                    std::get<k>(levels));
+  }
+
+  /**
+   * @brief      Get the contiguous column holding the data of a dimension.
+   *
+   * Requires traits which store the data in columns:
+   * ~~~~~~~~~~~~~~~{.cpp}
+   * struct complex_traits{
+   *     using KeyType = int;
+   *     using NodeTypes = util::type_holder<int,Vertex,int,int>;
+   *     using EdgeTypes = util::type_holder<int,int,int>;
+   *     using ColumnarNodeData = std::true_type;
+   * };
+   * ~~~~~~~~~~~~~~~
+   *
+   * Removed simplices are squeezed out of the level first. Entry i of the
+   * column is then the data of the i-th simplex of get_level_id<k>() and
+   * `column[s.index()]` is `*s`. If k-simplices were removed since the
+   * last squeeze, SimplexID::index() is renumbered and revision() changes,
+   * so views such as halfedge_view report stale() and any visited_set of
+   * k-simplices must be cleared. Squeezing while a range from
+   * get_level_id<k>() or get_level<k>() is alive throws std::logic_error.
+   * The column is invalidated by inserting or removing k-simplices.
+   *
+   * Example -- find the lowest vertex:
+   * ~~~~~~~~~~~~~~~{.cpp}
+   * double zmin = std::numeric_limits<double>::infinity();
+   * for (const auto &v : mesh.get_data_column<1>())
+   *   zmin = std::min(zmin, v.position[2]);
+   * ~~~~~~~~~~~~~~~
+   *
+   * @tparam     k     The simplex dimension.
+   *
+   * @return     Range over the data of all k-simplices.
+   */
+  template <std::size_t k> util::range<NodeData<k> *> get_data_column() {
+    static_assert(ColumnarData::value, "The traits must set ColumnarNodeData");
+    static_assert(!std::is_void<NodeData<k>>::value, "Level k has no data");
+    auto &registry = std::get<k>(levels);
+    if (registry.slots() != registry.size()) {
+      if (registry.pinned()) {
+        throw std::logic_error(
+            "get_data_column: A range over the level is still alive.");
+      }
+      registry.compact();
+      // SimplexID::index() changed, which outdates derived indexes
+      ++revision_count;
+    }
+    auto first = registry.column();
+    return util::make_range(first, first + registry.size());
   }
 
   /**
@@ -1866,6 +3341,27 @@ public:
     return remove_recurse<k, 0>::apply(this, &s.ptr, &s.ptr + 1, count);
   }
 
+  /**
+   * @brief      Remove a set of simplices and all dependent simplices.
+   *
+   * Equivalent to calling remove() on each simplex of S. The union of their
+   * coboundaries is collected once and the simplices are destroyed from the
+   * top level down. Each simplex only unlinks itself from the faces which
+   * survive, and the keys of removed vertices are returned to the tracker
+   * in runs.
+   *
+   * @param[in]  S     The simplices to remove. The root is never removed.
+   *
+   * @return     Number of simplices removed.
+   */
+  std::size_t remove_batch(const SimplexSet<type_this> &S) {
+    DoomedLevel doomed;
+    util::int_for_each<std::size_t, LevelIndex>(CollectDoomed(), &S, doomed);
+    std::size_t count = 0;
+    util::int_for_each<std::size_t, RevLevelIndex>(DestroyDoomed(), this,
+                                                   doomed, count);
+    return count;
+  }
 
   /**
    * @brief      Checks whether a simplex is near a boundary.
@@ -2173,9 +3669,8 @@ private:
       std::set<Node<level + 1> *> next;
       // for each node of interest...
       for (auto i = begin; i != end; ++i) {
-        auto up = (*i)->_up;
-        for (auto j = up.begin(); j != up.end(); ++j) {
-          next.insert(j->second);
+        for (const auto &p : (*i)->_up) {
+          next.insert(p.second);
         }
         that->remove_node(*i);
         ++count;
@@ -2216,6 +3711,225 @@ private:
     }
   };
 
+  /// Reversed index of all simplex dimensions.
+  using RevLevelIndex =
+      typename util::reverse_sequence<std::size_t, LevelIndex>::type;
+  /// Alias a vector of NodePtr<k>
+  template <std::size_t k> using NodePtrVector = std::vector<NodePtr<k>>;
+  /// Typename of a tuple of the Nodes to remove per level.
+  using DoomedLevel = typename util::int_type_map<std::size_t, std::tuple,
+                                                  LevelIndex,
+                                                  NodePtrVector>::type;
+
+  /**
+   * @brief      Functor to collect the Nodes removed by remove_batch().
+   *
+   * Run from the bottom level up, each level adds its cofaces to the level
+   * above before that level is made unique.
+   */
+  struct CollectDoomed {
+    /**
+     * @brief      Collect the Nodes of level k.
+     *
+     * @param[in]  S       The simplices to remove.
+     * @param      doomed  The Nodes to remove per level.
+     *
+     * @tparam     k       The level to collect.
+     */
+    template <std::size_t k>
+    void apply(const SimplexSet<type_this> *S, DoomedLevel &doomed) {
+      collect<k>(*S, doomed, std::integral_constant<bool, (k > 0)>());
+    }
+
+    /// Make the Nodes of level k unique and add their cofaces.
+    template <std::size_t k>
+    static void collect(const SimplexSet<type_this> &S, DoomedLevel &doomed,
+                        std::true_type) {
+      auto &level = std::get<k>(doomed);
+      for (auto s : S.template get<k>()) {
+        level.push_back(s.ptr);
+      }
+      std::sort(level.begin(), level.end());
+      level.erase(std::unique(level.begin(), level.end()), level.end());
+      cover<k>(level, doomed, std::integral_constant<bool, (k < topLevel)>());
+    }
+
+    /// The root is never removed.
+    template <std::size_t k>
+    static void collect(const SimplexSet<type_this> &, DoomedLevel &,
+                        std::false_type) {}
+
+    /// Add the cofaces of the Nodes of level k.
+    template <std::size_t k>
+    static void cover(const NodePtrVector<k> &level, DoomedLevel &doomed,
+                      std::true_type) {
+      auto &next = std::get<k + 1>(doomed);
+      for (auto p : level) {
+        for (auto curr : p->_up) {
+          next.push_back(curr.second);
+        }
+      }
+    }
+
+    /// Facets have no cofaces.
+    template <std::size_t k>
+    static void cover(const NodePtrVector<k> &, DoomedLevel &,
+                      std::false_type) {}
+  };
+
+  /**
+   * @brief      Functor to destroy the Nodes collected by CollectDoomed.
+   *
+   * Run from the top level down so that the cofaces of a Node are gone
+   * before it is destroyed. The faces of a Node are unlinked only when they
+   * survive and the cofaces are never unlinked.
+   */
+  struct DestroyDoomed {
+    /**
+     * @brief      Destroy the Nodes of level k.
+     *
+     * @param      that    The simplicial complex
+     * @param      doomed  The Nodes to remove per level.
+     * @param      count   Number of Nodes removed.
+     *
+     * @tparam     k       The level to destroy.
+     */
+    template <std::size_t k>
+    void apply(type_this *that, DoomedLevel &doomed, std::size_t &count) {
+      destroy<k>(that, doomed, count, std::integral_constant<bool, (k > 0)>());
+    }
+
+    /// Destroy the Nodes of level k.
+    template <std::size_t k>
+    static void destroy(type_this *that, DoomedLevel &doomed,
+                        std::size_t &count, std::true_type) {
+      const auto &level = std::get<k>(doomed);
+      const auto &faces = std::get<k - 1>(doomed);
+      release_keys(that, level, std::integral_constant<bool, (k == 1)>());
+      for (auto p : level) {
+        CASC_STATS_SPAN(remove_node, k);
+        that->unindex_node(p, NameIndexed());
+        for (auto curr = p->_down.begin(); curr != p->_down.end(); ++curr) {
+          if (!std::binary_search(faces.begin(), faces.end(), curr->second)) {
+            curr->second->_up.erase(curr->first);
+          }
+        }
+        std::get<k>(that->levels).erase(p);
+        std::get<k>(that->pools).destroy(p);
+      }
+      that->level_count[k] -= level.size();
+      that->revision_count += level.size();
+      count += level.size();
+    }
+
+    /// The root is never removed.
+    template <std::size_t k>
+    static void destroy(type_this *, DoomedLevel &, std::size_t &,
+                        std::false_type) {}
+
+    /// Return the keys of removed vertices to the tracker.
+    template <std::size_t k>
+    static void release_keys(type_this *that, const NodePtrVector<k> &level,
+                             std::true_type) {
+      std::vector<KeyType> keys;
+      keys.reserve(level.size());
+      for (auto p : level) {
+        keys.push_back(p->_down.begin()->first);
+      }
+      std::sort(keys.begin(), keys.end());
+      that->unused_vertices.insert(keys.begin(), keys.end());
+    }
+
+    /// Only vertices hold keys.
+    template <std::size_t k>
+    static void release_keys(type_this *, const NodePtrVector<k> &,
+                             std::false_type) {}
+  };
+
+  /// Typename of a tuple of the copies of Nodes indexed by registry slot.
+  using RemapLevel = DoomedLevel;
+
+  /**
+   * @brief      Functor to copy the Nodes of a level for clone().
+   */
+  struct CopyLevel {
+    /**
+     * @brief      Copy the Nodes of level k.
+     *
+     * The copies still point to the faces and cofaces of the originals.
+     *
+     * @param[in]  from   The complex to copy.
+     * @param      to     The empty complex to copy into.
+     * @param      remap  Filled with the copy of each original by slot.
+     *
+     * @tparam     k      The level to copy.
+     */
+    template <std::size_t k>
+    void apply(const type_this *from, type_this *to, RemapLevel &remap) {
+      const auto &level = std::get<k>(from->levels);
+      auto &pool = std::get<k>(to->pools);
+      auto &registry = std::get<k>(to->levels);
+      auto &copies = std::get<k>(remap);
+      copies.assign(level.slots(), nullptr);
+      registry.reserve(level.size());
+      for (auto p : level) {
+        auto q = pool.construct(*p);
+        registry.insert(q);
+        q->assign_data(*p);
+        copies[p->_slot] = q;
+      }
+      to->level_count[k] = from->level_count[k];
+    }
+  };
+
+  /**
+   * @brief      Functor to point the copies of clone() at each other.
+   */
+  struct RelinkLevel {
+    /**
+     * @brief      Relink the Nodes of level k and index them by name.
+     *
+     * @param      to     The complex holding the copies.
+     * @param[in]  remap  The copy of each original by slot.
+     *
+     * @tparam     k      The level to relink.
+     */
+    template <std::size_t k>
+    void apply(type_this *to, const RemapLevel &remap) {
+      for (auto q : std::get<k>(to->levels)) {
+        down<k>(q, remap, std::integral_constant<bool, (k > 0)>());
+        up<k>(q, remap, std::integral_constant<bool, (k < topLevel)>());
+        to->index_node(q, Indexed<k>());
+      }
+    }
+
+    /// Point the faces of a copy at the copied faces.
+    template <std::size_t k>
+    static void down(Node<k> *q, const RemapLevel &remap, std::true_type) {
+      const auto &copies = std::get<k - 1>(remap);
+      for (auto it = q->_down.begin(); it != q->_down.end(); ++it) {
+        it->second = copies[it->second->_slot];
+      }
+    }
+
+    /// The root has no faces.
+    template <std::size_t k>
+    static void down(Node<k> *, const RemapLevel &, std::false_type) {}
+
+    /// Point the cofaces of a copy at the copied cofaces.
+    template <std::size_t k>
+    static void up(Node<k> *q, const RemapLevel &remap, std::true_type) {
+      const auto &copies = std::get<k + 1>(remap);
+      for (auto it = q->_up.begin(); it != q->_up.end(); ++it) {
+        it->second = copies[it->second->_slot];
+      }
+    }
+
+    /// Top level Nodes have no cofaces.
+    template <std::size_t k>
+    static void up(Node<k> *, const RemapLevel &, std::false_type) {}
+  };
+
   /**
    * @brief      Recursively retrieve a simplex of interest.
    *
@@ -2236,6 +3950,7 @@ private:
       // TODO: We probably don't need to check if root is a valid
       // simplex (10)
       if (root) {
+        CASC_STATS_RECORD(get_recurse, 1);
         auto p = root->_up.find(*s);
         if (p != root->_up.end()) {
           return get_recurse<level + 1, n - 1>::apply(s + 1, root->_up.at(*s));
@@ -2427,7 +4142,7 @@ private:
      */
     static Node<level + n + 1> *apply(type_this *that, Node<level> *root,
                                       const KeyType *begin) {
-
+      CASC_STATS_RECORD(insert, level + 1);
       KeyType v = *(begin + n);
       Node<level + 1> *nn;
       // if root->v doesn't exist then create it
@@ -2438,6 +4153,7 @@ private:
         nn->_down[v] = root;
         root->_up[v] = nn;
         that->backfill(root, nn, v);
+        that->index_node(nn, NameIndexed());
       } else {
         nn = iter->second; // otherwise get it
       }
@@ -2478,6 +4194,323 @@ private:
    */
   void backfill(Node<0> *, Node<1> *, int) { return; }
 
+  /// Sorted table of simplex names and the associated nodes.
+  template <std::size_t j>
+  using bulk_table = std::vector<std::pair<std::array<KeyType, j>, NodePtr<j>>>;
+
+  /**
+   * @brief      Call a function for each j-subset of a sorted name.
+   *
+   * @param[in]  name  The sorted name of a simplex.
+   * @param[in]  fn    Functor accepting a std::array<KeyType,j>.
+   *
+   * @tparam     j     Size of the subsets.
+   * @tparam     n     Size of the name.
+   * @tparam     Fn    Typename of the functor.
+   */
+  template <std::size_t j, std::size_t n, typename Fn>
+  static void for_each_subset(const std::array<KeyType, n> &name, Fn &&fn) {
+    std::array<std::size_t, j> idx;
+    std::array<KeyType, j> sub;
+    for (std::size_t i = 0; i < j; ++i) {
+      idx[i] = i;
+    }
+    while (true) {
+      for (std::size_t i = 0; i < j; ++i) {
+        sub[i] = name[idx[i]];
+      }
+      fn(sub);
+      // Advance to the next combination in lexicographic order
+      std::size_t i = j;
+      while (i > 0 && idx[i - 1] == n - j + i - 1) {
+        --i;
+      }
+      if (i == 0) {
+        return;
+      }
+      ++idx[i - 1];
+      for (std::size_t l = i; l < j; ++l) {
+        idx[l] = idx[l - 1] + 1;
+      }
+    }
+  }
+
+  /**
+   * @brief      Get the name of a face by dropping a key.
+   *
+   * @param[in]  name  The name of the simplex.
+   * @param[in]  i     Index of the key to drop.
+   *
+   * @tparam     j     Size of the name.
+   *
+   * @return     Name with key i removed.
+   */
+  template <std::size_t j>
+  static std::array<KeyType, j - 1> drop_key(const std::array<KeyType, j> &name,
+                                             std::size_t i) {
+    std::array<KeyType, j - 1> rval;
+    std::size_t l = 0;
+    for (std::size_t m = 0; m < j; ++m) {
+      if (m != i) {
+        rval[l++] = name[m];
+      }
+    }
+    return rval;
+  }
+
+  /**
+   * @brief      Find a node in a sorted bulk_table.
+   *
+   * @param[in]  table  The table to search.
+   * @param[in]  name   The name of the simplex.
+   *
+   * @tparam     j      Dimension of the simplex.
+   *
+   * @return     Pointer to the node or nullptr if not present.
+   */
+  template <std::size_t j>
+  static NodePtr<j> bulk_find(const bulk_table<j> &table,
+                              const std::array<KeyType, j> &name) {
+    auto it = std::lower_bound(
+        table.begin(), table.end(), name,
+        [](const auto &entry, const auto &key) { return entry.first < key; });
+    return (it != table.end() && it->first == name) ? it->second : nullptr;
+  }
+
+  /**
+   * @brief      Link a new node to the faces other than its base.
+   *
+   * This is the same as backfill() except that the up pointers of the faces
+   * are handed to `emit` instead of being written.
+   *
+   * @param      root   is a parent node
+   * @param      nn     is the new child node
+   * @param      value  is the exposed id of nn
+   * @param      emit   Functor called as emit(child, key) for each face.
+   *
+   * @tparam     level  Dimension of the current root simplex.
+   * @tparam     Emit   Typename of the functor.
+   */
+  template <std::size_t level, typename Emit>
+  static void bulk_backfill(Node<level> *root, Node<level + 1> *nn,
+                            KeyType value, Emit &&emit) {
+    for (auto curr = root->_down.begin(); curr != root->_down.end(); ++curr) {
+      KeyType v = curr->first;
+      Node<level> *child = curr->second->_up.find(value)->second;
+      nn->_down[v] = child;
+      emit(child, v);
+    }
+  }
+
+  /// Vertices have no faces other than the root.
+  template <typename Emit>
+  static void bulk_backfill(Node<0> *, Node<1> *, KeyType, Emit &&) {}
+
+  /**
+   * @brief      Create and link all j-simplices of a set of names.
+   *
+   * Face generation, sorting and linking are split across the threads of
+   * casc::parallel. Only node creation, which touches the pools and the
+   * registry, is serial. Up pointers of the (j-1)-faces are written by the
+   * thread owning the face so that no locking is required.
+   *
+   * @param[in]  names  Sorted names of the simplices being inserted.
+   * @param[in]  prev   Table of all (j-1)-faces of names.
+   *
+   * @tparam     j      Level to build.
+   * @tparam     n      Dimension of the simplices being inserted.
+   *
+   * @return     Table of all j-faces of names.
+   */
+  template <std::size_t j, std::size_t n>
+  bulk_table<j> bulk_level(const std::vector<std::array<KeyType, n>> &names,
+                           const bulk_table<j - 1> &prev) {
+    constexpr std::size_t grain = 1 << 12;
+    // Number of j-faces of each n-simplex
+    std::size_t per = 1;
+    for (std::size_t i = 0; i < j; ++i) {
+      per = per * (n - i) / (i + 1);
+    }
+    std::vector<std::array<KeyType, j>> faces(names.size() * per);
+    parallel::for_chunks(
+        names.size(), grain, [&](std::size_t, std::size_t b, std::size_t e) {
+          auto out = faces.begin() + b * per;
+          for (std::size_t i = b; i < e; ++i) {
+            for_each_subset<j>(names[i],
+                               [&out](const std::array<KeyType, j> &f) {
+                                 *out++ = f;
+                               });
+          }
+        });
+    parallel::sort(faces.begin(), faces.end());
+    faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+
+    // Faces are sorted so their prefixes can be found by walking prev.
+    bulk_table<j> rval(faces.size());
+    std::vector<NodePtr<j - 1>> bases(faces.size());
+    parallel::for_chunks(
+        faces.size(), grain, [&](std::size_t, std::size_t b, std::size_t e) {
+          if (b == e) {
+            return;
+          }
+          auto pit = std::lower_bound(
+              prev.begin(), prev.end(), drop_key<j>(faces[b], j - 1),
+              [](const auto &entry, const auto &key) {
+                return entry.first < key;
+              });
+          for (std::size_t i = b; i < e; ++i) {
+            const auto prefix = drop_key<j>(faces[i], j - 1);
+            while (pit->first < prefix) {
+              ++pit;
+            }
+            assert(pit != prev.end() && pit->first == prefix);
+            bases[i] = pit->second;
+            auto it = bases[i]->_up.find(faces[i][j - 1]);
+            rval[i].first = faces[i];
+            rval[i].second = (it != bases[i]->_up.end()) ? it->second : nullptr;
+          }
+        });
+
+    std::vector<std::size_t> fresh;
+    std::get<j>(levels).reserve(std::get<j>(levels).slots() + faces.size());
+    for (std::size_t i = 0; i < rval.size(); ++i) {
+      if (rval[i].second == nullptr) {
+        rval[i].second = create_node<j>();
+        fresh.push_back(i);
+      }
+    }
+    if (j == 1) {
+      // New vertex keys are sorted, claim them in runs
+      std::vector<KeyType> keys;
+      keys.reserve(fresh.size());
+      for (auto i : fresh) {
+        keys.push_back(rval[i].first[0]);
+      }
+      unused_vertices.remove(keys.begin(), keys.end());
+    }
+
+    // Fill in the down pointers of the new nodes and bucket the up pointers
+    // of each face by the thread which owns it. A single owner writes them
+    // in place.
+    using UpLink = std::tuple<NodePtr<j - 1>, KeyType, NodePtr<j>>;
+    const std::size_t owners = parallel::num_threads();
+    const std::size_t slots = std::get<j - 1>(levels).slots();
+    const std::size_t chunks = parallel::chunk_count(fresh.size(), grain);
+    std::vector<std::vector<std::vector<UpLink>>> links(
+        chunks, std::vector<std::vector<UpLink>>(owners));
+    parallel::for_chunks(
+        fresh.size(), grain, [&](std::size_t c, std::size_t b, std::size_t e) {
+          auto &out = links[c];
+          auto emit = [&](NodePtr<j - 1> child, KeyType v, NodePtr<j> nn) {
+            if (owners == 1) {
+              child->_up[v] = nn;
+            } else {
+              out[child->_slot * owners / slots].emplace_back(child, v, nn);
+            }
+          };
+          for (std::size_t i = b; i < e; ++i) {
+            NodePtr<j - 1> base = bases[fresh[i]];
+            NodePtr<j> nn = rval[fresh[i]].second;
+            const KeyType v = rval[fresh[i]].first[j - 1];
+            nn->_down[v] = base;
+            emit(base, v, nn);
+            bulk_backfill(base, nn, v, [&](NodePtr<j - 1> child, KeyType k) {
+              emit(child, k, nn);
+            });
+          }
+        });
+    parallel::for_chunks(owners, 1,
+                         [&](std::size_t, std::size_t b, std::size_t e) {
+                           for (std::size_t o = b; o < e; ++o) {
+                             for (const auto &bucket : links) {
+                               for (const auto &l : bucket[o]) {
+                                 std::get<0>(l)->_up[std::get<1>(l)] =
+                                     std::get<2>(l);
+                               }
+                             }
+                           }
+                         });
+    index_fresh(rval, fresh, NameIndexed());
+    return rval;
+  }
+
+  /**
+   * @brief      Recursively build the levels of a bulk insertion.
+   *
+   * @tparam     j     Level to build.
+   * @tparam     n     Dimension of the simplices being inserted.
+   * @tparam     done  Whether all levels have been built.
+   */
+  template <std::size_t j, std::size_t n, bool done = (j > n)>
+  struct bulk_build {
+    /**
+     * @brief      Build level j and recurse to the next level.
+     *
+     * @param      that   The simplicial complex
+     * @param[in]  names  Sorted names of the simplices being inserted.
+     * @param      prev   Table of all (j-1)-faces of names.
+     *
+     * @return     Table of the inserted n-simplices.
+     */
+    static bulk_table<n>
+    apply(type_this *that, const std::vector<std::array<KeyType, n>> &names,
+          bulk_table<j - 1> &&prev) {
+      bulk_table<j> curr;
+      {
+        bulk_table<j - 1> tmp(std::move(prev));
+        curr = that->template bulk_level<j, n>(names, tmp);
+      }
+      return bulk_build<j + 1, n>::apply(that, names, std::move(curr));
+    }
+  };
+
+  /**
+   * @brief      Terminal case when all levels have been built.
+   *
+   * @tparam     j     One past the last level built.
+   * @tparam     n     Dimension of the simplices being inserted.
+   */
+  template <std::size_t j, std::size_t n> struct bulk_build<j, n, true> {
+    /**
+     * @brief      Return the table of inserted simplices.
+     *
+     * @param      that   The simplicial complex
+     * @param[in]  names  Sorted names of the simplices being inserted.
+     * @param      prev   Table of the inserted n-simplices.
+     *
+     * @return     Table of the inserted n-simplices.
+     */
+    static bulk_table<n> apply(type_this *,
+                               const std::vector<std::array<KeyType, n>> &,
+                               bulk_table<n> &&prev) {
+      return std::move(prev);
+    }
+  };
+
+  /**
+   * @brief      Store user data on bulk inserted simplices.
+   *
+   * @param[in]  table  Table of the inserted simplices.
+   * @param[in]  names  Sorted names in input order.
+   * @param[in]  data   Data to store in input order.
+   *
+   * @tparam     n      Dimension of the simplices.
+   */
+  template <std::size_t n>
+  void bulk_assign(const bulk_table<n> &table,
+                   const std::vector<std::array<KeyType, n>> &names,
+                   const NodeData<n> *data, std::false_type) {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      bulk_find<n>(table, names[i])->data() = data[i];
+    }
+  }
+
+  /// Nothing to store for levels without data.
+  template <std::size_t n>
+  void bulk_assign(const bulk_table<n> &,
+                   const std::vector<std::array<KeyType, n>> &, const void *,
+                   std::true_type) {}
+
   /**
    * @brief      Creates a new node of some dimension.
    *
@@ -2488,23 +4521,13 @@ private:
    * @return     A pointer to the new node.
    */
   template <std::size_t level> Node<level> *create_node() {
+    CASC_STATS_SPAN(create_node, level);
     // Create the new node
-    auto p = new Node<level>(node_count++);
+    auto p = std::get<level>(pools).construct(node_count++);
     ++(level_count[level]); // Increment the count in the level
+    ++revision_count;
 
-    // node_count-1 to match the internal IDs correctly.
-    MAYBE_UNUSED bool ret =
-        std::get<level>(levels)
-            .insert(std::pair<std::size_t, NodePtr<level>>(node_count - 1, p))
-            .second;
-    assert(ret);
-    /*
-       // sanity check to make sure there aren't duplicate keys...
-       if (ret==false) {
-        std::cout << "Error: Node '" << node_count << "' already existed
-           with value " << *p << std::endl;
-       }
-     */
+    std::get<level>(levels).insert(p);
     return p;
   }
 
@@ -2516,15 +4539,19 @@ private:
    * @tparam     level  Dimension of the simplex
    */
   template <std::size_t level> void remove_node(Node<level> *p) {
+    CASC_STATS_SPAN(remove_node, level);
+    unindex_node(p, NameIndexed());
     for (auto curr = p->_down.begin(); curr != p->_down.end(); ++curr) {
       curr->second->_up.erase(curr->first);
     }
     for (auto curr = p->_up.begin(); curr != p->_up.end(); ++curr) {
+      unindex_node(curr->second, NameIndexed());
       curr->second->_down.erase(curr->first);
     }
     --(level_count[level]);
-    std::get<level>(levels).erase(p->_node);
-    delete p;
+    ++revision_count;
+    std::get<level>(levels).erase(p);
+    std::get<level>(pools).destroy(p);
   }
 
   /**
@@ -2533,17 +4560,21 @@ private:
    * @param      p     Simplex to remove
    */
   void remove_node(Node<1> *p) {
+    CASC_STATS_SPAN(remove_node, 1);
+    unindex_node(p, NameIndexed());
     // This for loop should only have a single iteration.
     for (auto curr = p->_down.begin(); curr != p->_down.end(); ++curr) {
       unused_vertices.insert(curr->first);
       curr->second->_up.erase(curr->first);
     }
     for (auto curr = p->_up.begin(); curr != p->_up.end(); ++curr) {
+      unindex_node(curr->second, NameIndexed());
       curr->second->_down.erase(curr->first);
     }
     --(level_count[1]);
-    std::get<1>(levels).erase(p->_node);
-    delete p;
+    ++revision_count;
+    std::get<1>(levels).erase(p);
+    std::get<1>(pools).destroy(p);
   }
 
   /**
@@ -2552,13 +4583,15 @@ private:
    * @param      p     Simplex to remove
    */
   void remove_node(Node<0> *p) {
+    CASC_STATS_SPAN(remove_node, 0);
     for (auto curr = p->_up.begin(); curr != p->_up.end(); ++curr) {
-
+      unindex_node(curr->second, NameIndexed());
       curr->second->_down.erase(curr->first);
     }
     --(level_count[0]);
-    std::get<0>(levels).erase(p->_node);
-    delete p;
+    ++revision_count;
+    std::get<0>(levels).erase(p);
+    std::get<0>(pools).destroy(p);
   }
 
   /**
@@ -2567,27 +4600,251 @@ private:
    * @param      p     Simplex to remove
    */
   void remove_node(Node<topLevel> *p) {
+    CASC_STATS_SPAN(remove_node, topLevel);
+    unindex_node(p, NameIndexed());
     for (auto curr = p->_down.begin(); curr != p->_down.end(); ++curr) {
       curr->second->_up.erase(curr->first);
     }
     --(level_count[topLevel]);
-    std::get<topLevel>(levels).erase(p->_node);
-    delete p;
+    ++revision_count;
+    std::get<topLevel>(levels).erase(p);
+    std::get<topLevel>(pools).destroy(p);
+  }
+
+  /// Whether n-simplices are looked up in the name index.
+  template <std::size_t n>
+  using Indexed = std::integral_constant<bool, NameIndexed::value && (n > 0)>;
+
+  /**
+   * @brief      Get the name of a Node from the keys of its faces.
+   *
+   * @param[in]  p     The Node, all of whose faces must be linked.
+   *
+   * @tparam     k     The dimension of the Node.
+   *
+   * @return     The sorted name.
+   */
+  template <std::size_t k>
+  static std::array<KeyType, k> node_name(const Node<k> *p) {
+    std::array<KeyType, k> name;
+    auto it = p->_down.begin();
+    for (auto &key : name) {
+      key = (it++)->first;
+    }
+    return name;
+  }
+
+  /**
+   * @brief      Find a simplex in the name index.
+   *
+   * @param[in]  s     Pointer to the n keys of the name in any order.
+   *
+   * @tparam     n     The dimension of the simplex.
+   *
+   * @return     The Node or nullptr if it does not exist.
+   */
+  template <std::size_t n>
+  NodePtr<n> find_name(const KeyType *s, std::true_type) const {
+    std::array<KeyType, n> name;
+    std::copy(s, s + n, name.begin());
+    std::sort(name.begin(), name.end());
+    const auto &index = std::get<n>(names);
+    auto it = index.find(name);
+    return (it != index.end()) ? it->second : nullptr;
+  }
+
+  /// Find a simplex by walking the cofaces of each key.
+  template <std::size_t n>
+  NodePtr<n> find_name(const KeyType *s, std::false_type) const {
+    return get_recurse<0, n>::apply(s, _root);
+  }
+
+  /// Add a Node to the name index. Names with repeated keys are skipped.
+  template <std::size_t k> void index_node(Node<k> *p, std::true_type) {
+    if (p->_down.size() == k) {
+      std::get<k>(names).emplace(node_name(p), p);
+    }
+  }
+
+  /// Nothing to index.
+  template <std::size_t k> void index_node(Node<k> *, std::false_type) {}
+
+  /// Add the Nodes created by a bulk insertion to the name index.
+  template <std::size_t j>
+  void index_fresh(const bulk_table<j> &table,
+                   const std::vector<std::size_t> &fresh, std::true_type) {
+    auto &index = std::get<j>(names);
+    index.reserve(index.size() + fresh.size());
+    for (auto i : fresh) {
+      index.emplace(table[i].first, table[i].second);
+    }
+  }
+
+  /// Nothing to index.
+  template <std::size_t j>
+  void index_fresh(const bulk_table<j> &, const std::vector<std::size_t> &,
+                   std::false_type) {}
+
+  /**
+   * @brief      Remove a Node from the name index.
+   *
+   * Faces are unlinked one at a time during removal, so the name is only
+   * known, and the Node is only unindexed, while all faces are linked.
+   *
+   * @param      p     The Node.
+   *
+   * @tparam     k     The dimension of the Node.
+   */
+  template <std::size_t k> void unindex_node(Node<k> *p, std::true_type) {
+    if (p->_down.size() == k) {
+      auto &index = std::get<k>(names);
+      auto it = index.find(node_name(p));
+      if (it != index.end() && it->second == p) {
+        index.erase(it);
+      }
+    }
+  }
+
+  /// Nothing to unindex.
+  template <std::size_t k> void unindex_node(Node<k> *, std::false_type) {}
+
+  /**
+   * @brief      Functor to destruct all nodes of a level without unlinking.
+   */
+  struct DestroyLevel {
+    /**
+     * @brief      Destruct the nodes of level k.
+     *
+     * @param      that  The simplicial complex
+     *
+     * @tparam     k     The level to destroy.
+     */
+    template <std::size_t k> void apply(type_this *that) {
+      auto &pool = std::get<k>(that->pools);
+      for (auto curr : std::get<k>(that->levels)) {
+        pool.destroy(curr);
+      }
+      std::get<k>(that->levels).clear();
+      that->level_count[k] = 0;
+    }
+  };
+
+  /**
+   * @brief      Functor to measure the memory footprint of a level.
+   */
+  struct MemoryLevel {
+    /**
+     * @brief      Fill in the footprint of level k.
+     *
+     * @param[in]  that   The simplicial complex
+     * @param      stats  The report to fill.
+     * @param[in]  scan   Whether to visit the Nodes.
+     *
+     * @tparam     k      The level to measure.
+     */
+    template <std::size_t k>
+    void apply(const type_this *that, MemoryStats &stats, bool scan) {
+      auto &l = stats.levels[k];
+      const auto &reg = std::get<k>(that->levels);
+      l.nodes = reg.size();
+      l.node_bytes = l.nodes * sizeof(Node<k>);
+      l.pool_bytes = std::get<k>(that->pools).bytes();
+      l.registry_bytes = reg.bytes();
+      l.index_bytes = detail::name_index_bytes(std::get<k>(that->names));
+      if (scan) {
+        for (auto p : reg) {
+          down(*p, l, std::integral_constant<bool, (k > 0)>());
+          up(*p, l, std::integral_constant<bool, (k < topLevel)>());
+        }
+      } else {
+        estimate_up<k>(that, l, std::integral_constant<bool, (k < topLevel)>());
+      }
+    }
+
+    /// Each (k+1)-simplex is a coface of its k+1 faces.
+    template <std::size_t k>
+    static void estimate_up(const type_this *that, level_memory &l,
+                            std::true_type) {
+      using map_t = decltype(std::declval<Node<k>>()._up);
+      l.up_bytes = (k + 1) * std::get<k + 1>(that->levels).size() *
+                   map_t::entry_size;
+    }
+
+    /// Top level Nodes have no cofaces.
+    template <std::size_t k>
+    static void estimate_up(const type_this *, level_memory &,
+                            std::false_type) {}
+
+    /// Account for the faces of a Node.
+    template <std::size_t k>
+    static void down(const Node<k> &node, level_memory &l, std::true_type) {
+      l.down_slack += (node._down.capacity() - node._down.size()) *
+                      decltype(node._down)::entry_size;
+    }
+
+    /// The root has no faces.
+    template <std::size_t k>
+    static void down(const Node<k> &, level_memory &, std::false_type) {}
+
+    /// Account for the cofaces of a Node.
+    template <std::size_t k>
+    static void up(const Node<k> &node, level_memory &l, std::true_type) {
+      using map_t = decltype(node._up);
+      l.up_bytes += node._up.capacity() * map_t::entry_size;
+      l.up_slack += (node._up.capacity() - node._up.size()) * map_t::entry_size;
+    }
+
+    /// Top level Nodes have no cofaces.
+    template <std::size_t k>
+    static void up(const Node<k> &, level_memory &, std::false_type) {}
+  };
+
+  /**
+   * @brief      Reinitialize a moved from complex as an empty complex.
+   */
+  void reset() {
+    levels = decltype(levels)();
+    pools = NodeAllocatorLevel();
+    unused_vertices = index_tracker::index_tracker<KeyType>();
+    names = NameIndexLevel();
+    node_count = 0;
+    for (auto &x : level_count) {
+      x = 0;
+    }
+    _root = create_node<0>();
   }
 
   /// The root node
   NodePtr<0> _root;
   /// A counter of the total number of nodes.
   std::size_t node_count;
+  /// A counter of the nodes created and removed, see revision().
+  std::size_t revision_count;
   /// A counter of the number of simplices per level.
   std::array<std::size_t, numLevels> level_count;
-  /// Typename of a tuple of LevelIndex broadcasted with NodePtr<k>.
-  using NodePtrLevel = typename util::int_type_map<std::size_t, std::tuple,
-                                                   LevelIndex, NodePtr>::type;
-  /// Typename of a map of levels to NodePtr<k>*'s.
-  typename util::type_map<NodePtrLevel, detail::map>::type levels;
+  /// Alias the registry of NodePtr<k>'s and their data column.
+  template <std::size_t k>
+  using Registry = detail::asc_registry<
+      NodePtr<k>, typename detail::column_storage<ColumnarData::value,
+                                                  NodeData<k>>::type>;
+  /// Typename of a tuple of LevelIndex broadcasted with Registry<k>.
+  using RegistryLevel = typename util::int_type_map<std::size_t, std::tuple,
+                                                    LevelIndex, Registry>::type;
+  /// Per level registries of NodePtr<k>'s.
+  RegistryLevel levels;
+  /// Typename of a tuple of LevelIndex broadcasted with NodeAllocator<k>.
+  using NodeAllocatorLevel =
+      typename util::int_type_map<std::size_t, std::tuple, LevelIndex,
+                                  NodeAllocator>::type;
+  /// Per level storage of the nodes.
+  NodeAllocatorLevel pools;
   /// B-tree of unused vertex indices.
   index_tracker::index_tracker<KeyType> unused_vertices;
+  /// Typename of a tuple of LevelIndex broadcasted with NameIndex<k>.
+  using NameIndexLevel = typename util::int_type_map<std::size_t, std::tuple,
+                                                     LevelIndex, NameIndex>::type;
+  /// Per level index of the nodes by name.
+  NameIndexLevel names;
 };
 
 /**
@@ -2639,7 +4896,38 @@ template <typename SimplexID> struct hashSimplexID {
 } // end namespace simplex_set_detail
 /// @endcond
 
-/// Helpful alias defining a unordered_set of simplices. See also hashSimplexID.
+/**
+ * @brief      Helpful alias defining a unordered_set of simplices. See also
+ *             hashSimplexID.
+ *
+ * Elements are allocated with recycling_allocator since these sets are
+ * mostly short lived scratch space of traversals and decimation.
+ */
 template <typename T>
-using NodeSet = std::unordered_set<T, simplex_set_detail::hashSimplexID<T>>;
+using NodeSet = std::unordered_set<T, simplex_set_detail::hashSimplexID<T>,
+                                   std::equal_to<T>, recycling_allocator<T>>;
+
+/// @cond detail
+namespace detail {
+/// By default SimplexSets hash their elements.
+template <typename traits, typename T, typename> struct simplex_set_container {
+  /// The default hashed set
+  using type = NodeSet<T>;
+};
+
+/**
+ * @brief      Specialization for traits which specify a SimplexSetContainer.
+ *
+ * @tparam     traits  The complex traits.
+ * @tparam     T       Typename of the SimplexID.
+ */
+template <typename traits, typename T>
+struct simplex_set_container<
+    traits, T,
+    util::void_t<typename traits::template SimplexSetContainer<T>>> {
+  /// The user specified container
+  using type = typename traits::template SimplexSetContainer<T>;
+};
+} // end namespace detail
+/// @endcond
 } // end namespace casc
@@ -0,0 +1,90 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  copy_on_write.h
+ * @brief Shared handle to a simplicial_complex which is cloned on write.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace casc {
+/**
+ * @brief      Copy-on-write handle to a simplicial_complex.
+ *
+ * Copying the handle only shares the complex. The first call to write() on
+ * a handle whose complex is shared replaces it with a private clone, so
+ * forks which are mostly read cost nothing until they diverge.
+ *
+ * SimplexIDs taken from read() of a shared complex keep referring to the
+ * shared complex after write() has cloned it. Look them up again by name.
+ * Handles sharing a complex may be read concurrently, a single handle must
+ * not be written concurrently with any other use of it.
+ *
+ * Example -- fork a mesh for several trials:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::copy_on_write<Mesh> base(std::move(mesh));
+ * std::vector<casc::copy_on_write<Mesh>> trials(8, base);
+ * for (auto &t : trials)
+ *   casc::decimate_by_cost(t.write(), target, cost, Callback<Mesh>());
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     Complex  Typename of the simplicial_complex
+ */
+template <typename Complex> class copy_on_write {
+public:
+  /// Construct a handle to an empty complex.
+  copy_on_write() : _ptr(std::make_shared<Complex>()) {}
+
+  /**
+   * @brief      Construct a handle taking ownership of a complex.
+   *
+   * @param      F     The complex to move from.
+   */
+  explicit copy_on_write(Complex &&F)
+      : _ptr(std::make_shared<Complex>(std::move(F))) {}
+
+  /// Read only access to the complex.
+  const Complex &read() const { return *_ptr; }
+  /// Read only access to the complex.
+  const Complex &operator*() const { return *_ptr; }
+  /// Read only access to the complex.
+  const Complex *operator->() const { return _ptr.get(); }
+
+  /**
+   * @brief      Writable access to the complex, cloning it if it is shared.
+   *
+   * @return     Reference to a complex owned only by this handle.
+   */
+  Complex &write() {
+    if (_ptr.use_count() > 1) {
+      _ptr = std::make_shared<Complex>(_ptr->clone());
+    }
+    return *_ptr;
+  }
+
+  /// Whether other handles share the complex.
+  bool shared() const { return _ptr.use_count() > 1; }
+
+private:
+  std::shared_ptr<Complex> _ptr; ///< The possibly shared complex
+};
+} // end namespace casc
@@ -23,12 +23,23 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <queue>
+#include <tuple>
 #include <typeinfo>
+#include <unordered_set>
+#include <vector>
 
 #include "CASCFunctions.h"
 #include "CASCTraversals.h"
 #include "SimplexMap.h"
 #include "SimplexSet.h"
+#include "parallel.h"
+#include "stats.h"
 
 #if __has_cpp_attribute(maybe_unused)
 #define MAYBE_UNUSED [[maybe_unused]]
@@ -204,7 +215,7 @@ template <typename Complex, std::size_t BaseLevel> struct InnerVisitor {
 
       // Remove base_name from old_name and append to new_name
       while (i < NewLevel) {
-        if (base_name[k] == old_name[j]) {
+        if (k < BaseLevel && base_name[k] == old_name[j]) {
           // if equivalent than skip the value
           ++j;
           ++k;
@@ -297,14 +308,6 @@ struct RunCallback {
   }
 };
 
-template <typename Complex> struct PerformRemoval {
-  template <std::size_t k>
-  static void apply(Complex &F, casc::SimplexSet<Complex> &S) {
-    for (auto curr : casc::get<k>(S))
-      F.remove(curr);
-  }
-};
-
 template <typename Complex> struct PerformInsertion {
   using KeyType = typename Complex::KeyType;
 
@@ -326,6 +329,48 @@ template <typename Complex> struct PerformInsertion {
   }
 };
 
+/**
+ * @brief      Map the complete neighborhood of a simplex onto a new vertex.
+ *
+ * @param[in]  F           simplicial_complex to operate on.
+ * @param[in]  s           Simplex to decimate.
+ * @param[in]  np          Vertex replacing `s`.
+ * @param      nbhd        Empty scratch set.
+ * @param[out] doomed      Simplices which will be removed.
+ * @param[out] simplexMap  Mapping of new simplices to the merged simplices.
+ *
+ * @tparam     Complex     Typename of the simplicial_complex
+ * @tparam     Simplex     Typename of the simplex
+ */
+template <typename Complex, typename Simplex>
+void map_neighborhood(Complex &F, Simplex s, typename Complex::KeyType np,
+                      casc::SimplexSet<Complex> &nbhd,
+                      casc::SimplexSet<Complex> &doomed,
+                      casc::SimplexMap<Complex> &simplexMap) {
+  {
+    CASC_STATS_SPAN(decimate_neighborhood, 0);
+    // Get the complete neighborhood
+    visit_BFS_down(GetCompleteNeighborhood<Complex>(&nbhd), F, s);
+  }
+
+  doomed = nbhd; // Backup the neighborhood
+  CASC_STATS_SPAN(decimate_map, 0);
+  // Call MainVisitor -> InnerVisitor -> GrabVisitor sequence
+  visit_BFS_down(MainVisitor<Complex>(&nbhd, np, &simplexMap), F, s);
+}
+
+/**
+ * @brief      Clear a level of a SimplexDataSet keeping its capacity.
+ *
+ * @tparam     Complex  Typename of the simplicial_complex
+ */
+template <typename Complex> struct ClearDataSet {
+  template <std::size_t k>
+  static void apply(typename SimplexDataSet<Complex>::type &rv) {
+    std::get<k>(rv).clear();
+  }
+};
+
 template <typename Complex> struct DoomedHelper {
   template <std::size_t k>
   static void apply(SimplexSet<Complex> &doomed,
@@ -339,6 +384,50 @@ template <typename Complex> struct DoomedHelper {
 } // end namespace decimation_detail
 /// @endcond
 
+/**
+ * @brief      Reusable scratch space for decimation.
+ *
+ * Decimating a simplex fills several SimplexSets, a SimplexMap and the
+ * callback results. Passing the same context to consecutive calls of
+ * decimate() or decimateFirstHalf() keeps the memory of these containers
+ * between calls. Together with recycling_allocator this serves most of the
+ * scratch allocations of steady state collapses from reused memory. The
+ * collapse itself still allocates for the new nodes, their `_up` arrays
+ * and edge data, about 20 allocations per edge collapse on a surface mesh.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::decimation_context<Mesh> ctx;
+ * for (auto name : edges)
+ *   casc::decimate(mesh, mesh.get_simplex_up(name), Callback<Mesh>(), ctx);
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     Complex  Typename of the simplicial_complex
+ */
+template <typename Complex> struct decimation_context {
+  /// Typename of the callback results
+  using DataSet = typename decimation_detail::SimplexDataSet<Complex>::type;
+
+  /// Neighborhood scratch space
+  SimplexSet<Complex> nbhd;
+  /// Simplices removed by the current decimation
+  SimplexSet<Complex> doomed;
+  /// Mapping of new simplices to the simplices merged into them
+  SimplexMap<Complex> simplexMap;
+  /// Results of the user callback for each new simplex
+  DataSet rv;
+
+  /// Empty all containers.
+  void clear() {
+    nbhd.clear();
+    doomed.clear();
+    simplexMap.clear();
+    util::int_for_each<std::size_t,
+                       std::make_index_sequence<Complex::numLevels>>(
+        decimation_detail::ClearDataSet<Complex>(), rv);
+  }
+};
+
 /**
  * @brief      Remove simplex in SimplexSet S from complex F
  *
@@ -349,10 +438,8 @@ template <typename Complex> struct DoomedHelper {
  */
 template <typename Complex>
 void perform_removal(Complex &F, casc::SimplexSet<Complex> &S) {
-  using SimplexSet = typename casc::SimplexSet<Complex>;
-  using LevelIndex = typename SimplexSet::cRevIndex;
-  util::int_for_each<std::size_t, LevelIndex>(
-      decimation_detail::PerformRemoval<Complex>(), F, S);
+  CASC_STATS_SPAN(decimate_removal, 0);
+  F.remove_batch(S);
 }
 
 /**
@@ -368,6 +455,7 @@ void perform_insertion(
     Complex &F, typename decimation_detail::SimplexDataSet<Complex>::type &S) {
   using SimplexSet = typename casc::SimplexSet<Complex>;
   using LevelIndex = typename SimplexSet::cLevelIndex;
+  CASC_STATS_SPAN(decimate_insertion, 0);
   util::int_for_each<std::size_t, LevelIndex>(
       decimation_detail::PerformInsertion<Complex>(), F, S);
 }
@@ -390,6 +478,7 @@ void run_user_callback(
   using SimplexMap = typename casc::SimplexMap<Complex>;
   using LevelIndex = typename SimplexMap::cLevelIndex;
 
+  CASC_STATS_SPAN(decimate_callback, 0);
   util::int_for_each<std::size_t, LevelIndex>(
       decimation_detail::RunCallback<Complex, Callback>(), F, S,
       std::forward<Callback<Complex>>(clbk), rv);
@@ -410,29 +499,37 @@ void run_user_callback(
 template <typename Complex, typename Simplex,
           template <typename> class Callback>
 void decimate(Complex &F, Simplex s, Callback<Complex> &&clbk) {
-  /// Alias for SimplexSet
-  using SimplexSet = typename casc::SimplexSet<Complex>;
-  /// Alias for SimplexMap
-  using SimplexMap = typename casc::SimplexMap<Complex>;
+  decimation_context<Complex> ctx;
+  decimate(F, s, std::forward<Callback<Complex>>(clbk), ctx);
+}
 
+/**
+ * @brief      Decimate a simplex using the scratch space of a context.
+ *
+ * @param[in]  F         simplicial_complex to operate on.
+ * @param[in]  s         Simplex to decimate.
+ * @param[in]  clbk      Callback function to map meta-data
+ * @param      ctx       Context whose containers are reused.
+ *
+ * @tparam     Complex   Typename of the simplicial_complex
+ * @tparam     Simplex   Typename of the simplex
+ * @tparam     Callback  Typename of the template template callback functor
+ */
+template <typename Complex, typename Simplex,
+          template <typename> class Callback>
+void decimate(Complex &F, Simplex s, Callback<Complex> &&clbk,
+              decimation_context<Complex> &ctx) {
+  ctx.clear();
   // Create the vertex to replace `s`
   typename Complex::KeyType np = F.add_vertex();
-  SimplexSet nbhd;
-  SimplexMap simplexMap;
-
-  // Get the complete neighborhood
-  visit_BFS_down(decimation_detail::GetCompleteNeighborhood<Complex>(&nbhd), F,
-                 s);
 
-  SimplexSet doomed = nbhd; // Backup the neighborhood
-  // Call MainVisitor -> InnerVisitor -> GrabVisitor sequence
-  visit_BFS_down(
-      decimation_detail::MainVisitor<Complex>(&nbhd, np, &simplexMap), F, s);
+  decimation_detail::map_neighborhood(F, s, np, ctx.nbhd, ctx.doomed,
+                                      ctx.simplexMap);
   // Run the user specified callback
-  typename decimation_detail::SimplexDataSet<Complex>::type rv;
-  run_user_callback(F, simplexMap, std::forward<Callback<Complex>>(clbk), rv);
-  perform_removal(F, doomed); // Remove simplices in the neighborhood
-  perform_insertion(F, rv);   // Insert new simplices
+  run_user_callback(F, ctx.simplexMap, std::forward<Callback<Complex>>(clbk),
+                    ctx.rv);
+  perform_removal(F, ctx.doomed); // Remove simplices in the neighborhood
+  perform_insertion(F, ctx.rv);   // Insert new simplices
 }
 
 /**
@@ -448,23 +545,154 @@ void decimate(Complex &F, Simplex s, Callback<Complex> &&clbk) {
 template <typename Complex, typename Simplex>
 typename Complex::KeyType decimateFirstHalf(Complex &F, Simplex s,
                                             SimplexMap<Complex> &simplexMap) {
-  /// Alias for SimplexSet
-  using SimplexSet = typename casc::SimplexSet<Complex>;
-
   // Create the vertex to replace `s`
   typename Complex::KeyType np = F.add_vertex();
-  SimplexSet nbhd;
+  casc::SimplexSet<Complex> nbhd, doomed;
 
-  // Get the complete neighborhood
-  visit_BFS_down(decimation_detail::GetCompleteNeighborhood<Complex>(&nbhd), F,
-                 s);
+  decimation_detail::map_neighborhood(F, s, np, nbhd, doomed, simplexMap);
+  return np;
+}
 
-  // Call MainVisitor -> InnerVisitor -> GrabVisitor sequence
-  visit_BFS_down(
-      decimation_detail::MainVisitor<Complex>(&nbhd, np, &simplexMap), F, s);
+/**
+ * @brief      Given a simplex to decimate generate a pre-post mapping in the
+ *             scratch space of a context.
+ *
+ * The mapping is stored in `ctx.simplexMap` and the simplices to remove in
+ * `ctx.doomed`. After running the callback into `ctx.rv` the decimation is
+ * completed by decimateBackHalf(F, ctx).
+ *
+ * @param[in]  F         simplicial_complex to operate on.
+ * @param[in]  s         Simplex to decimate.
+ * @param      ctx       Context whose containers are reused.
+ *
+ * @tparam     Complex   Typename of the simplicial_complex
+ * @tparam     Simplex   Typename of the simplex
+ *
+ * @return     The vertex replacing `s`.
+ */
+template <typename Complex, typename Simplex>
+typename Complex::KeyType decimateFirstHalf(Complex &F, Simplex s,
+                                            decimation_context<Complex> &ctx) {
+  ctx.clear();
+  // Create the vertex to replace `s`
+  typename Complex::KeyType np = F.add_vertex();
+
+  decimation_detail::map_neighborhood(F, s, np, ctx.nbhd, ctx.doomed,
+                                      ctx.simplexMap);
   return np;
 }
 
+/**
+ * @brief      Decimate many simplices at once.
+ *
+ * A maximal set of simplices with pairwise disjoint complete neighborhoods is
+ * chosen greedily in input order. Two neighborhoods overlap exactly when a
+ * vertex of one simplex equals or is adjacent to a vertex of the other.
+ * Decimating such simplices in any order gives the same result, so the
+ * neighborhood mapping and the user callback run concurrently using
+ * casc::parallel. All removals and insertions are then applied serially.
+ *
+ * Simplices which were not chosen may have been removed or changed and must
+ * be looked up again before another batch. The callback may be invoked from
+ * several threads at once and must not modify the complex.
+ *
+ * Example -- collapse as many edges as possible:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * std::vector<Mesh::SimplexID<2>> edges;
+ * for (auto e : mesh.get_level_id<2>())
+ *   edges.push_back(e);
+ * auto n = casc::decimate_batch(mesh, edges.begin(), edges.end(),
+ *                               Callback<Mesh>());
+ * ~~~~~~~~~~~~~~~
+ *
+ * @param[in]  F         simplicial_complex to operate on.
+ * @param[in]  first     Iterator to the first candidate simplex.
+ * @param[in]  last      Iterator past the last candidate simplex.
+ * @param[in]  clbk      Callback function to map meta-data
+ *
+ * @tparam     Complex   Typename of the simplicial_complex
+ * @tparam     InputIt   Typename of the iterator over SimplexIDs
+ * @tparam     Callback  Typename of the template template callback functor
+ *
+ * @return     Number of simplices decimated.
+ */
+template <typename Complex, typename InputIt,
+          template <typename> class Callback>
+std::size_t decimate_batch(Complex &F, InputIt first, InputIt last,
+                           Callback<Complex> &&clbk) {
+  using Simplex = typename std::iterator_traits<InputIt>::value_type;
+  using KeyType = typename Complex::KeyType;
+  using DataSet = typename decimation_detail::SimplexDataSet<Complex>::type;
+  static_assert(Simplex::level > 0, "Cannot decimate the root");
+
+  // Claim the vertices of each chosen simplex and their neighbors
+  std::vector<Simplex> chosen;
+  std::unordered_set<KeyType> claimed;
+  for (; first != last; ++first) {
+    Simplex s = *first;
+    auto name = F.get_name(s);
+    if (std::any_of(name.begin(), name.end(),
+                    [&](KeyType v) { return claimed.count(v) > 0; })) {
+      continue;
+    }
+    for (auto v : name) {
+      claimed.insert(v);
+      F.get_cover(F.get_simplex_up({v}),
+                  [&](KeyType w) { claimed.insert(w); });
+    }
+    chosen.push_back(s);
+  }
+
+  const std::size_t n = chosen.size();
+  std::vector<KeyType> np(n);
+  F.add_vertices(n, np.begin());
+  std::vector<SimplexSet<Complex>> doomed(n);
+  std::vector<DataSet> rv(n);
+  // Scratch space shared by the simplices of a chunk
+  std::vector<decimation_context<Complex>> ctx(parallel::chunk_count(n, 16));
+  parallel::for_chunks(n, 16, [&](std::size_t c, std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; ++i) {
+      ctx[c].clear();
+      decimation_detail::map_neighborhood(F, chosen[i], np[i], ctx[c].nbhd,
+                                          doomed[i], ctx[c].simplexMap);
+      run_user_callback(F, ctx[c].simplexMap,
+                        std::forward<Callback<Complex>>(clbk), rv[i]);
+    }
+  });
+
+  SimplexSet<Complex> all;
+  for (auto &d : doomed) {
+    all.insert(d);
+  }
+  perform_removal(F, all); // Remove simplices in all neighborhoods
+  for (auto &r : rv) {
+    perform_insertion(F, r); // Insert new simplices
+  }
+  return n;
+}
+
+/**
+ * @brief      Decimate many simplices at once.
+ *
+ * @param[in]  F          simplicial_complex to operate on.
+ * @param[in]  simplices  Range of candidate SimplexIDs.
+ * @param[in]  clbk       Callback function to map meta-data
+ *
+ * @tparam     Complex    Typename of the simplicial_complex
+ * @tparam     Range      Typename of the range
+ * @tparam     Callback   Typename of the template template callback functor
+ *
+ * @return     Number of simplices decimated.
+ *
+ * @see        decimate_batch(Complex&, InputIt, InputIt, Callback<Complex>&&)
+ */
+template <typename Complex, typename Range, template <typename> class Callback>
+std::size_t decimate_batch(Complex &F, const Range &simplices,
+                           Callback<Complex> &&clbk) {
+  return decimate_batch(F, std::begin(simplices), std::end(simplices),
+                        std::forward<Callback<Complex>>(clbk));
+}
+
 /**
  * @brief      Given a simplexMap and mapped resulting data execute the
  *             decimation.
@@ -489,4 +717,114 @@ void decimateBackHalf(
   perform_insertion(F, rv);   // Insert new simplices
 }
 
+/**
+ * @brief      Execute a decimation prepared in a decimation_context.
+ *
+ * @see        decimateFirstHalf(Complex&, Simplex,
+ *             decimation_context<Complex>&)
+ *
+ * @param      F        Simplicial complex to operate on
+ * @param      ctx      Context holding the doomed simplices and the
+ *                      resulting data in `ctx.rv`
+ *
+ * @tparam     Complex  Typename of the complex of interest
+ */
+template <typename Complex>
+void decimateBackHalf(Complex &F, decimation_context<Complex> &ctx) {
+  perform_removal(F, ctx.doomed); // Remove simplices in the neighborhood
+  perform_insertion(F, ctx.rv);   // Insert new simplices
+}
+
+/**
+ * @brief      Collapse edges in order of increasing cost until the complex
+ *             has at most `target` facets.
+ *
+ * Every edge is scored once up front and kept in a min-heap. After each
+ * collapse only the new edges listed in the SimplexMap of the collapse are
+ * scored again, so the whole coarsening takes O(n log n) cost evaluations
+ * and heap operations. Entries of edges which were removed or re-scored are
+ * discarded lazily as they reach the top of the heap.
+ *
+ * Example -- collapse short edges first:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * auto length = [](Mesh &F, Mesh::SimplexID<2> e) {
+ *   auto name = F.get_name(e);
+ *   return distance(*F.get_simplex_up({name[0]}),
+ *                   *F.get_simplex_up({name[1]}));
+ * };
+ * casc::decimate_by_cost(mesh, 1000, length, Callback<Mesh>());
+ * ~~~~~~~~~~~~~~~
+ *
+ * @param[in]  F         simplicial_complex to operate on.
+ * @param[in]  target    Number of facets to stop at.
+ * @param[in]  cost      Functor called as cost(F, SimplexID<2>) returning a
+ *                       double. Edges with infinite cost are never
+ *                       collapsed.
+ * @param[in]  clbk      Callback function to map meta-data
+ *
+ * @tparam     Complex   Typename of the simplicial_complex
+ * @tparam     Cost      Typename of the cost functor
+ * @tparam     Callback  Typename of the template template callback functor
+ *
+ * @return     Number of edges collapsed.
+ */
+template <typename Complex, typename Cost, template <typename> class Callback>
+std::size_t decimate_by_cost(Complex &F, std::size_t target, Cost &&cost,
+                             Callback<Complex> &&clbk) {
+  static_assert(Complex::topLevel >= 2, "Complex has no edges to collapse");
+  using KeyType = typename Complex::KeyType;
+  using Name = std::array<KeyType, 2>;
+  using Entry = std::tuple<double, Name, std::size_t>;
+
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+  // Stamp of the most recent heap entry of each edge
+  std::map<Name, std::size_t> stamps;
+  std::size_t clock = 0;
+  auto score = [&](Name name) {
+    std::sort(name.begin(), name.end());
+    auto s = F.get_simplex_up(name);
+    if (s == nullptr) {
+      return;
+    }
+    const double c = cost(F, s);
+    if (c == std::numeric_limits<double>::infinity()) {
+      stamps.erase(name);
+      return;
+    }
+    stamps[name] = ++clock;
+    heap.emplace(c, name, clock);
+  };
+  for (auto e : F.template get_level_id<2>()) {
+    score(F.get_name(e));
+  }
+
+  std::size_t collapsed = 0;
+  decimation_context<Complex> ctx;
+  while (F.template size<Complex::topLevel>() > target && !heap.empty()) {
+    const Name name = std::get<1>(heap.top());
+    const std::size_t stamp = std::get<2>(heap.top());
+    heap.pop();
+    auto it = stamps.find(name);
+    if (it == stamps.end() || it->second != stamp) {
+      continue; // Superseded by a newer entry
+    }
+    stamps.erase(it);
+    auto s = F.get_simplex_up(name);
+    if (s == nullptr) {
+      continue; // Removed by an earlier collapse
+    }
+
+    decimateFirstHalf(F, s, ctx);
+    run_user_callback(F, ctx.simplexMap,
+                      std::forward<Callback<Complex>>(clbk), ctx.rv);
+    decimateBackHalf(F, ctx);
+    ++collapsed;
+
+    for (const auto &entry : casc::get<2>(ctx.simplexMap)) {
+      score(entry.first);
+    }
+  }
+  return collapsed;
+}
+
 } // end namespace casc
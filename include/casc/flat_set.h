@@ -0,0 +1,233 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  flat_set.h
+ * @brief Set of simplices stored as a sorted vector.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "node_pool.h"
+
+namespace casc {
+/**
+ * @brief      Set stored as a sorted contiguous vector.
+ *
+ * Lookups are binary searches and the elements are iterated in order, which
+ * lets set union, intersection and difference run as linear merges instead
+ * of one hash lookup per element. Inserting an element which is not the new
+ * maximum shifts the larger elements, so flat_set is best suited for the
+ * small sets of stars, closures and links rather than for whole levels.
+ *
+ * A SimplexSet uses flat_set for each level when the complex traits select
+ * it as the `SimplexSetContainer`:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * struct complex_traits{
+ *     using KeyType = int;
+ *     using NodeTypes = util::type_holder<int,int,int,int>;
+ *     using EdgeTypes = util::type_holder<int,int,int>;
+ *     template <typename T> using SimplexSetContainer = casc::flat_set<T>;
+ * };
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     T        Typename of the elements.
+ * @tparam     Compare  Strict weak ordering of the elements.
+ */
+template <typename T, typename Compare = std::less<T>> class flat_set {
+  /// Typename of the underlying storage.
+  using storage = std::vector<T, recycling_allocator<T>>;
+
+public:
+  /// Typename of the elements.
+  using value_type = T;
+  /// Typename of the elements.
+  using key_type = T;
+  /// Typename of sizes.
+  using size_type = std::size_t;
+  /// Elements are immutable to keep the vector sorted.
+  using iterator = typename storage::const_iterator;
+  /// Iterator over the elements in order.
+  using const_iterator = typename storage::const_iterator;
+
+  /// Construct an empty set.
+  flat_set() {}
+
+  /**
+   * @brief      Construct a set from a range of elements.
+   *
+   * @param[in]  first  Iterator to the first element.
+   * @param[in]  last   Past-the-end iterator.
+   *
+   * @tparam     Iter   Typename of the input iterator.
+   */
+  template <typename Iter> flat_set(Iter first, Iter last) {
+    insert(first, last);
+  }
+
+  /// Construct a set from a list of elements.
+  flat_set(std::initializer_list<T> init) { insert(init.begin(), init.end()); }
+
+  /**
+   * @brief      Insert an element.
+   *
+   * @param[in]  v     Element to insert.
+   *
+   * @return     Pair of an iterator to the element and whether it was
+   *             inserted.
+   */
+  std::pair<iterator, bool> insert(const T &v) {
+    // Appending in order is the common case when filling from a merge
+    if (_data.empty() || _comp(_data.back(), v)) {
+      _data.push_back(v);
+      return std::make_pair(std::prev(_data.cend()), true);
+    }
+    auto it = std::lower_bound(_data.begin(), _data.end(), v, _comp);
+    if (!_comp(v, *it)) {
+      return std::make_pair(iterator(it), false);
+    }
+    return std::make_pair(iterator(_data.insert(it, v)), true);
+  }
+
+  /**
+   * @brief      Insert an element. The hint is ignored, this overload exists
+   *             for compatibility with std::inserter.
+   *
+   * @param[in]  v     Element to insert.
+   *
+   * @return     Iterator to the element.
+   */
+  iterator insert(const_iterator, const T &v) { return insert(v).first; }
+
+  /**
+   * @brief      Insert a range of elements.
+   *
+   * The range is appended, sorted if it is not already and merged with the
+   * existing elements, so inserting a sorted range takes linear time.
+   *
+   * @param[in]  first  Iterator to the first element.
+   * @param[in]  last   Past-the-end iterator.
+   *
+   * @tparam     Iter   Typename of the input iterator.
+   */
+  template <typename Iter> void insert(Iter first, Iter last) {
+    const auto n = _data.size();
+    _data.insert(_data.end(), first, last);
+    auto mid = _data.begin() + n;
+    if (!std::is_sorted(mid, _data.end(), _comp)) {
+      std::sort(mid, _data.end(), _comp);
+    }
+    if (n > 0 && mid != _data.end() && !_comp(*(mid - 1), *mid)) {
+      storage merged;
+      merged.reserve(_data.size());
+      std::merge(_data.begin(), mid, mid, _data.end(),
+                 std::back_inserter(merged), _comp);
+      _data.swap(merged);
+    }
+    _data.erase(std::unique(_data.begin(), _data.end(),
+                            [this](const T &a, const T &b) {
+                              return !_comp(a, b) && !_comp(b, a);
+                            }),
+                _data.end());
+  }
+
+  /**
+   * @brief      Remove an element.
+   *
+   * @param[in]  v     Element to remove.
+   *
+   * @return     Number of elements removed.
+   */
+  size_type erase(const T &v) {
+    auto it = std::lower_bound(_data.begin(), _data.end(), v, _comp);
+    if (it == _data.end() || _comp(v, *it)) {
+      return 0;
+    }
+    _data.erase(it);
+    return 1;
+  }
+
+  /**
+   * @brief      Remove the element at a position.
+   *
+   * @param[in]  pos   Iterator to the element to remove.
+   *
+   * @return     Iterator following the removed element.
+   */
+  iterator erase(const_iterator pos) {
+    return _data.erase(_data.begin() + (pos - _data.cbegin()));
+  }
+
+  /**
+   * @brief      Find an element.
+   *
+   * @param[in]  v     Element to search for.
+   *
+   * @return     Iterator to the element or end() if it is not in the set.
+   */
+  const_iterator find(const T &v) const {
+    auto it = std::lower_bound(_data.cbegin(), _data.cend(), v, _comp);
+    if (it == _data.cend() || _comp(v, *it)) {
+      return _data.cend();
+    }
+    return it;
+  }
+
+  /// Number of elements equal to v, either 0 or 1.
+  size_type count(const T &v) const { return find(v) != _data.cend(); }
+
+  /// Iterator to the smallest element.
+  const_iterator begin() const { return _data.cbegin(); }
+  /// Past-the-end iterator.
+  const_iterator end() const { return _data.cend(); }
+  /// Iterator to the smallest element.
+  const_iterator cbegin() const { return _data.cbegin(); }
+  /// Past-the-end iterator.
+  const_iterator cend() const { return _data.cend(); }
+
+  /// Number of elements.
+  size_type size() const { return _data.size(); }
+  /// True if the set has no elements.
+  bool empty() const { return _data.empty(); }
+  /// Remove all elements. The capacity is kept.
+  void clear() { _data.clear(); }
+  /// Reserve storage for n elements.
+  void reserve(size_type n) { _data.reserve(n); }
+
+  /// Sets are equal if they hold the same elements.
+  friend bool operator==(const flat_set &lhs, const flat_set &rhs) {
+    return lhs._data == rhs._data;
+  }
+  /// Sets are inequal if they differ in any element.
+  friend bool operator!=(const flat_set &lhs, const flat_set &rhs) {
+    return !(lhs == rhs);
+  }
+
+private:
+  storage _data; ///< Sorted elements without duplicates
+  Compare _comp; ///< Ordering of the elements
+};
+} // end namespace casc
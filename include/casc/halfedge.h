@@ -0,0 +1,578 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  halfedge.h
+ * @brief Half-edge index of the triangles of a 2-manifold complex.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SimplicialComplex.h"
+#include "util.h"
+
+namespace casc {
+/// @cond detail
+/// Namespace for helpers of the halfedge_view
+namespace halfedge_detail {
+/// Detect NodeData with an `orientation` member such as Orientable.
+template <typename T, typename = void>
+struct has_orientation : std::false_type {};
+
+/// Specialization for NodeData with an `orientation` member.
+template <typename T>
+struct has_orientation<
+    T, util::void_t<decltype(std::declval<T &>().orientation)>>
+    : std::true_type {};
+
+/// Stored orientation of a face.
+template <typename FaceID> int face_orientation(FaceID f, std::true_type) {
+  return (*f).orientation;
+}
+
+/// Faces without orientation data are oriented by the view.
+template <typename FaceID> int face_orientation(FaceID, std::false_type) {
+  return 0;
+}
+} // end namespace halfedge_detail
+/// @endcond
+
+/**
+ * @brief      Half-edge index of a complex of triangles.
+ *
+ * The view numbers the vertices and faces of the complex densely in level
+ * order and stores flat integer arrays for the half-edges. Half-edge
+ * `3*f + i` is the i-th side of face f, so next(), prev() and face() are
+ * arithmetic and twin() and origin() are single array reads. Walking the
+ * fan around a vertex or the neighbors of a face therefore never touches
+ * the `_up` and `_down` maps of the complex.
+ *
+ * Faces are traversed in the orientation stored in their data when the
+ * face NodeData has an `orientation` member, as set by compute_orientation(),
+ * using the convention of the OFF writer: orientation -1 lists the sorted
+ * name and +1 lists it reversed. Faces without a stored orientation are
+ * oriented consistently with their neighbors.
+ *
+ * The view reads the complex when it is built. It is out of date once
+ * simplices are inserted or removed, which stale() reports by comparing
+ * simplicial_complex::revision(), and sync() rebuilds it. Changing stored
+ * orientations requires an explicit rebuild().
+ *
+ * Example -- mean of the one-ring of every vertex:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::halfedge_view<SurfaceMesh> he(mesh);
+ * for (std::uint32_t v = 0; v < he.vertex_count(); ++v) {
+ *   Vector mean;
+ *   std::size_t n = 0;
+ *   he.one_ring(v, [&](std::uint32_t w) {
+ *     mean += (*he.vertex_id(w)).position;
+ *     ++n;
+ *   });
+ * }
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     Complex  Typename of a simplicial_complex with topLevel 3.
+ * @tparam     Index    Unsigned integer typename of the indices.
+ */
+template <typename Complex, typename Index = std::uint32_t>
+class halfedge_view {
+  static_assert(Complex::topLevel == 3,
+                "halfedge_view requires a complex of triangles");
+  static_assert(std::is_unsigned<Index>::value,
+                "halfedge_view requires an unsigned Index");
+
+public:
+  /// Typename of the vertex keys
+  using KeyType = typename Complex::KeyType;
+  /// Typename of the vertex SimplexIDs
+  using VertexID = typename Complex::template SimplexID<1>;
+  /// Typename of the face SimplexIDs
+  using FaceID = typename Complex::template SimplexID<3>;
+
+  /// Index of missing vertices, faces and half-edges.
+  static constexpr Index npos = std::numeric_limits<Index>::max();
+
+  /**
+   * @brief      Iterator over the outgoing half-edges of a vertex in order
+   *             around the vertex.
+   */
+  class fan_iterator {
+  public:
+    /// Iterator traits
+    using iterator_category = std::forward_iterator_tag;
+    /// Iterator traits
+    using value_type = Index;
+    /// Iterator traits
+    using difference_type = std::ptrdiff_t;
+    /// Iterator traits
+    using pointer = const Index *;
+    /// Iterator traits
+    using reference = Index;
+
+    /// Construct an end iterator.
+    fan_iterator() : _view(nullptr), _h(npos), _start(npos) {}
+
+    /// Construct an iterator starting at half-edge h.
+    fan_iterator(const halfedge_view *view, Index h)
+        : _view(view), _h(h), _start(h) {}
+
+    /// The current outgoing half-edge.
+    Index operator*() const { return _h; }
+
+    /// Rotate to the next outgoing half-edge.
+    fan_iterator &operator++() {
+      const Index h = _view->twin(_view->prev(_h));
+      _h = h == _start ? npos : h;
+      return *this;
+    }
+
+    /// Rotate to the next outgoing half-edge.
+    fan_iterator operator++(int) {
+      fan_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    /// Iterators are equal at the same half-edge.
+    bool operator==(const fan_iterator &rhs) const { return _h == rhs._h; }
+    /// Iterators differ at different half-edges.
+    bool operator!=(const fan_iterator &rhs) const { return _h != rhs._h; }
+
+  private:
+    const halfedge_view *_view;
+    Index _h;
+    Index _start;
+  };
+
+  /**
+   * @brief      Build the view of a complex.
+   *
+   * @param[in]  F     The complex. It must outlive the view.
+   *
+   * @throws     std::invalid_argument if an edge has more than two faces,
+   *             a vertex is pinched or the faces cannot be oriented
+   *             consistently.
+   */
+  explicit halfedge_view(const Complex &F) : _F(&F) { rebuild(); }
+
+  /// Whether simplices were inserted or removed since the view was built.
+  bool stale() const { return _revision != _F->revision(); }
+
+  /**
+   * @brief      Rebuild the view if it is out of date.
+   *
+   * @return     True if the view was rebuilt.
+   */
+  bool sync() {
+    if (!stale()) {
+      return false;
+    }
+    rebuild();
+    return true;
+  }
+
+  /**
+   * @brief      Rebuild the view from the complex.
+   *
+   * @throws     std::invalid_argument, see the constructor. The view is
+   *             left empty.
+   */
+  void rebuild() {
+    try {
+      build();
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  /// Number of vertices
+  std::size_t vertex_count() const { return _vertex_ids.size(); }
+  /// Number of faces
+  std::size_t face_count() const { return _face_ids.size(); }
+  /// Number of half-edges, three per face
+  std::size_t halfedge_count() const { return _twin.size(); }
+
+  /// Next half-edge around the face of h.
+  static Index next(Index h) { return h % 3 == 2 ? h - 2 : h + 1; }
+  /// Previous half-edge around the face of h.
+  static Index prev(Index h) { return h % 3 == 0 ? h + 2 : h - 1; }
+  /// Face of half-edge h.
+  static Index face(Index h) { return h / 3; }
+  /// First half-edge of face f.
+  static Index halfedge(Index f) { return 3 * f; }
+  /// Opposite half-edge of h, or npos on the boundary.
+  Index twin(Index h) const { return _twin[h]; }
+  /// Vertex h starts at.
+  Index origin(Index h) const { return _origin[h]; }
+  /// Vertex h points to.
+  Index target(Index h) const { return _origin[next(h)]; }
+  /// Whether h is on the boundary of the complex.
+  bool is_boundary(Index h) const { return _twin[h] == npos; }
+
+  /**
+   * @brief      First outgoing half-edge of a vertex.
+   *
+   * For boundary vertices it is the half-edge along the boundary where
+   * the fan starts.
+   *
+   * @param[in]  v     The vertex.
+   *
+   * @return     The half-edge, or npos if v has no faces.
+   */
+  Index outgoing(Index v) const { return _out[v]; }
+
+  /// Whether v is on the boundary of the complex or has no faces.
+  bool is_boundary_vertex(Index v) const {
+    return _out[v] == npos || _twin[_out[v]] == npos;
+  }
+
+  /**
+   * @brief      Orientation of face f in the convention of Orientable.
+   *
+   * Can be used to write the orientation chosen by the view back into
+   * the complex.
+   *
+   * @param[in]  f     The face.
+   *
+   * @return     -1 if f lists its sorted name, otherwise +1.
+   */
+  int orientation(Index f) const { return _flip[f] ? 1 : -1; }
+
+  /// Key of vertex v.
+  KeyType key(Index v) const { return _keys[v]; }
+  /// SimplexID of vertex v.
+  VertexID vertex_id(Index v) const { return _vertex_ids[v]; }
+  /// SimplexID of face f.
+  FaceID face_id(Index f) const { return _face_ids[f]; }
+
+  /// Index of a vertex of the complex, or npos.
+  Index vertex(VertexID s) const {
+    return s.index() < _vertex_of_slot.size() ? _vertex_of_slot[s.index()]
+                                              : npos;
+  }
+
+  /// Index of a face of the complex, or npos.
+  Index face(FaceID s) const {
+    return s.index() < _face_of_slot.size() ? _face_of_slot[s.index()]
+                                            : npos;
+  }
+
+  /**
+   * @brief      Outgoing half-edges of a vertex in order around it.
+   *
+   * Consecutive half-edges h and h' satisfy h' == twin(prev(h)), so the
+   * faces face(h) are visited in rotational order. For boundary vertices
+   * the fan starts and ends on the boundary.
+   *
+   * @param[in]  v     The vertex.
+   *
+   * @return     Range of half-edge indices.
+   */
+  util::range<fan_iterator> fan(Index v) const {
+    return util::range<fan_iterator>(
+        _out[v] == npos ? fan_iterator() : fan_iterator(this, _out[v]),
+        fan_iterator());
+  }
+
+  /**
+   * @brief      Visit the neighbors of a vertex in order around it.
+   *
+   * @param[in]  v       The vertex.
+   * @param[in]  fn      Functor called as fn(w) for each neighbor w.
+   *
+   * @tparam     Lambda  Typename of the functor.
+   */
+  template <typename Lambda> void one_ring(Index v, Lambda &&fn) const {
+    Index last = npos;
+    for (auto h : fan(v)) {
+      fn(target(h));
+      last = h;
+    }
+    if (last != npos && is_boundary(prev(last))) {
+      fn(origin(prev(last)));
+    }
+  }
+
+  /**
+   * @brief      Get the neighbors of a vertex in order around it.
+   *
+   * @param[in]  v     The vertex.
+   *
+   * @return     Indices of the neighboring vertices.
+   */
+  std::vector<Index> one_ring(Index v) const {
+    std::vector<Index> rval;
+    one_ring(v, [&rval](Index w) { rval.push_back(w); });
+    return rval;
+  }
+
+  /**
+   * @brief      Get the faces across the sides of a face.
+   *
+   * @param[in]  f     The face.
+   *
+   * @return     The face across side i at position i, or npos on the
+   *             boundary.
+   */
+  std::array<Index, 3> face_neighbors(Index f) const {
+    std::array<Index, 3> rval;
+    for (Index i = 0; i < 3; ++i) {
+      const Index t = _twin[3 * f + i];
+      rval[i] = t == npos ? npos : face(t);
+    }
+    return rval;
+  }
+
+  /// Bytes of memory held by the view.
+  std::size_t bytes() const {
+    return (_twin.capacity() + _origin.capacity() + _out.capacity() +
+            _vertex_of_slot.capacity() + _face_of_slot.capacity()) *
+               sizeof(Index) +
+           _keys.capacity() * sizeof(KeyType) +
+           _vertex_ids.capacity() * sizeof(VertexID) +
+           _face_ids.capacity() * sizeof(FaceID) + _flip.capacity() / 8;
+  }
+
+private:
+  /// Side of a face as an undirected edge and its tentative half-edge.
+  struct side {
+    Index lo;   ///< Smaller vertex
+    Index hi;   ///< Larger vertex
+    Index h;    ///< Half-edge
+    bool operator<(const side &rhs) const {
+      return lo != rhs.lo ? lo < rhs.lo : hi != rhs.hi ? hi < rhs.hi
+                                                       : h < rhs.h;
+    }
+  };
+
+  /// Release all arrays.
+  void clear() {
+    _twin.clear();
+    _origin.clear();
+    _out.clear();
+    _keys.clear();
+    _vertex_ids.clear();
+    _face_ids.clear();
+    _vertex_of_slot.clear();
+    _face_of_slot.clear();
+    _flip.clear();
+  }
+
+  /// Fill the arrays from the complex.
+  void build() {
+    using Oriented = halfedge_detail::has_orientation<
+        typename Complex::template NodeData<3>>;
+    const Complex &F = *_F;
+    clear();
+    _revision = F.revision();
+    if (3 * F.template size<3>() >= static_cast<std::size_t>(npos) ||
+        F.template size<1>() >= static_cast<std::size_t>(npos)) {
+      throw std::invalid_argument("halfedge_view: Index is too small");
+    }
+
+    _vertex_of_slot.assign(F.template slots<1>(), npos);
+    for (auto v : F.template get_level_id<1>()) {
+      _vertex_of_slot[v.index()] = static_cast<Index>(_vertex_ids.size());
+      _vertex_ids.push_back(v);
+      _keys.push_back(F.get_name(v)[0]);
+    }
+
+    // Tentative cycles follow the stored orientation or the sorted name
+    const std::size_t nf = F.template size<3>();
+    std::vector<int> stored;
+    stored.reserve(nf);
+    _origin.reserve(3 * nf);
+    _face_of_slot.assign(F.template slots<3>(), npos);
+    for (auto f : F.template get_level_id<3>()) {
+      _face_of_slot[f.index()] = static_cast<Index>(_face_ids.size());
+      _face_ids.push_back(f);
+      const int o = halfedge_detail::face_orientation(f, Oriented());
+      stored.push_back(o);
+      std::array<Index, 3> cycle;
+      const auto name = F.get_name(f);
+      for (std::size_t i = 0; i < 3; ++i) {
+        const KeyType s[1] = {name[i]};
+        cycle[i] = vertex(F.get_simplex_up(s));
+      }
+      if (o == 1) {
+        std::swap(cycle[0], cycle[2]);
+      }
+      _origin.insert(_origin.end(), cycle.begin(), cycle.end());
+    }
+
+    link_twins();
+    orient(stored);
+    link_vertices();
+  }
+
+  /// Pair each half-edge with the other side of its edge.
+  void link_twins() {
+    const std::size_t n = _origin.size();
+    std::vector<side> sides;
+    sides.reserve(n);
+    for (std::size_t h = 0; h < n; ++h) {
+      const Index a = _origin[h];
+      const Index b = _origin[next(static_cast<Index>(h))];
+      sides.push_back(side{std::min(a, b), std::max(a, b),
+                           static_cast<Index>(h)});
+    }
+    std::sort(sides.begin(), sides.end());
+    _twin.assign(n, npos);
+    for (std::size_t i = 0; i < n;) {
+      std::size_t j = i + 1;
+      while (j < n && sides[j].lo == sides[i].lo &&
+             sides[j].hi == sides[i].hi) {
+        ++j;
+      }
+      if (j - i > 2) {
+        throw std::invalid_argument(
+            "halfedge_view: an edge has more than two faces");
+      }
+      if (j - i == 2) {
+        _twin[sides[i].h] = sides[i + 1].h;
+        _twin[sides[i + 1].h] = sides[i].h;
+      }
+      i = j;
+    }
+  }
+
+  /**
+   * @brief      Flip the faces without stored orientation to agree with
+   *             their neighbors, then reorder their half-edges.
+   *
+   * @param[in]  stored  Stored orientation of each face, 0 if none.
+   */
+  void orient(const std::vector<int> &stored) {
+    const std::size_t nf = stored.size();
+    // Twins running in the same direction need exactly one of their faces
+    // flipped
+    auto conflict = [this](Index h) { return _origin[h] == _origin[_twin[h]]; };
+    _flip.assign(nf, false);
+    std::vector<bool> assigned(nf, false);
+    std::vector<Index> queue;
+    queue.reserve(nf);
+    for (std::size_t f = 0; f < nf; ++f) {
+      if (stored[f] != 0) {
+        assigned[f] = true;
+        queue.push_back(static_cast<Index>(f));
+      }
+    }
+    std::size_t head = 0;
+    std::size_t seed = 0;
+    while (true) {
+      while (head < queue.size()) {
+        const Index f = queue[head++];
+        for (Index h = 3 * f; h < 3 * f + 3; ++h) {
+          if (_twin[h] == npos) {
+            continue;
+          }
+          const Index g = face(_twin[h]);
+          const bool flip = _flip[f] != conflict(h);
+          if (!assigned[g]) {
+            assigned[g] = true;
+            _flip[g] = flip;
+            queue.push_back(g);
+          } else if (_flip[g] != flip) {
+            throw std::invalid_argument(
+                "halfedge_view: faces are not consistently orientable");
+          }
+        }
+      }
+      while (seed < nf && assigned[seed]) {
+        ++seed;
+      }
+      if (seed == nf) {
+        break;
+      }
+      assigned[seed] = true;
+      queue.push_back(static_cast<Index>(seed));
+    }
+
+    // Reversing (a,b,c) to (c,b,a) swaps the sides {a,b} and {b,c}
+    auto moved = [this](Index h) {
+      return _flip[face(h)] && h % 3 != 2 ? (h % 3 == 0 ? h + 1 : h - 1) : h;
+    };
+    std::vector<Index> twin(_twin.size(), npos);
+    for (Index h = 0; h < _twin.size(); ++h) {
+      if (_twin[h] != npos) {
+        twin[moved(h)] = moved(_twin[h]);
+      }
+    }
+    _twin.swap(twin);
+    for (std::size_t f = 0; f < nf; ++f) {
+      if (_flip[f]) {
+        std::swap(_origin[3 * f], _origin[3 * f + 2]);
+      }
+      // Report the final orientation in the stored convention
+      _flip[f] = _flip[f] != (stored[f] == 1);
+    }
+  }
+
+  /// Choose the first outgoing half-edge of each vertex.
+  void link_vertices() {
+    const std::size_t nv = _vertex_ids.size();
+    _out.assign(nv, npos);
+    std::vector<Index> degree(nv, 0);
+    for (Index h = 0; h < _origin.size(); ++h) {
+      const Index v = _origin[h];
+      ++degree[v];
+      if (_out[v] == npos || _twin[h] == npos) {
+        _out[v] = h;
+      }
+    }
+    for (std::size_t v = 0; v < nv; ++v) {
+      Index n = 0;
+      for (auto h : fan(static_cast<Index>(v))) {
+        static_cast<void>(h);
+        ++n;
+      }
+      if (n != degree[v]) {
+        throw std::invalid_argument(
+            "halfedge_view: the faces around a vertex are not a fan");
+      }
+    }
+  }
+
+  const Complex *_F;
+  std::size_t _revision;
+  std::vector<Index> _twin;   ///< Opposite half-edge or npos
+  std::vector<Index> _origin; ///< Start vertex of each half-edge
+  std::vector<Index> _out;    ///< First outgoing half-edge of each vertex
+  std::vector<KeyType> _keys;
+  std::vector<VertexID> _vertex_ids;
+  std::vector<FaceID> _face_ids;
+  std::vector<Index> _vertex_of_slot;
+  std::vector<Index> _face_of_slot;
+  std::vector<bool> _flip; ///< Faces listing their reversed sorted name
+};
+
+template <typename Complex, typename Index>
+constexpr Index halfedge_view<Complex, Index>::npos;
+} // end namespace casc
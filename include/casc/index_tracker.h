@@ -23,13 +23,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <assert.h>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <mutex>
+#include <stdexcept>
 #include <vector>
 
+#include "stats.h"
+
 /// Index tracker namespace
 namespace index_tracker {
 /// B-tree internal data structures
@@ -180,6 +185,7 @@ template <typename Node> void rebalance(Pointer<Node> head, std::size_t i) {
   Pointer<Node> curr = head->next[i];
 
   if (curr->k == Node::N) {
+    CASC_STATS_RECORD(btree_split, 1);
     // Pointer<Node> left = curr; // UNUSED
     Pointer<Node> right =
         new Node(curr->data.begin() + Node::d + 1, curr->data.end());
@@ -203,6 +209,7 @@ template <typename Node> void rebalance(Pointer<Node> head, std::size_t i) {
     head->next[i + 1] = right;
     ++(head->k);
   } else if (curr->k < Node::d) {
+    CASC_STATS_RECORD(btree_merge, 1);
     if (i > 0 && head->next[i - 1]->k > Node::d) {
       Pointer<Node> left = head->next[i - 1];
       Pointer<Node> right = head->next[i];
@@ -658,7 +665,7 @@ template <typename Node> void destruct(Pointer<Node> head) {
     return;
   } else {
     if (head->next[0] != nullptr) {
-      for (std::size_t i = 0; i < head->k; ++i) {
+      for (std::size_t i = 0; i <= head->k; ++i) {
         destruct<Node>(head->next[i]);
       }
     }
@@ -666,6 +673,111 @@ template <typename Node> void destruct(Pointer<Node> head) {
   }
 }
 
+/// Deep copy a B-tree.
+template <typename Node> Pointer<Node> copy(Pointer<Node> head) {
+  if (head == nullptr)
+    return nullptr;
+  Pointer<Node> nn = new Node(*head);
+  if (head->next[0] != nullptr) {
+    for (std::size_t i = 0; i <= head->k; ++i) {
+      nn->next[i] = copy<Node>(head->next[i]);
+    }
+  }
+  return nn;
+}
+
+/// Count the nodes of a B-tree.
+template <typename Node> std::size_t count_nodes(Pointer<Node> head) {
+  if (head == nullptr)
+    return 0;
+  std::size_t n = 1;
+  if (head->next[0] != nullptr) {
+    for (std::size_t i = 0; i <= head->k; ++i) {
+      n += count_nodes<Node>(head->next[i]);
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief      Find an interval which intersects [a,b).
+ *
+ * The interval is returned in place so that it may be shrunk without
+ * restructuring the tree.
+ *
+ * @param[in]  head  Root of the B-tree.
+ * @param[in]  a     Inclusive lower bound of the query.
+ * @param[in]  b     Exclusive upper bound of the query.
+ *
+ * @return     Pointer to the interval or nullptr if none intersects [a,b).
+ */
+template <typename Node>
+Data<Node> *find_overlap(Pointer<Node> head, Scalar<Node> a, Scalar<Node> b) {
+  while (head != nullptr) {
+    std::size_t i = 0;
+    while (i < head->k && head->data[i].upper() <= a)
+      ++i;
+    if (i < head->k && head->data[i].lower() < b) {
+      return &head->data[i];
+    }
+    if (head->next[0] == nullptr)
+      return nullptr;
+    head = head->next[i];
+  }
+  return nullptr;
+}
+
+/**
+ * @brief      Find the interval which contains x.
+ *
+ * Unlike find_overlap(head, x, x + 1) this does not overflow at the largest
+ * value of the index type.
+ *
+ * @param[in]  head  Root of the B-tree.
+ * @param[in]  x     The index.
+ *
+ * @return     Pointer to the interval or nullptr if x is not available.
+ */
+template <typename Node>
+const Data<Node> *find_containing(Pointer<Node> head, Scalar<Node> x) {
+  while (head != nullptr) {
+    std::size_t i = 0;
+    while (i < head->k && head->data[i].upper() <= x)
+      ++i;
+    if (i < head->k && head->data[i].lower() <= x) {
+      return &head->data[i];
+    }
+    if (head->next[0] == nullptr)
+      return nullptr;
+    head = head->next[i];
+  }
+  return nullptr;
+}
+
+/// Get the interval with the smallest indices.
+template <typename Node> Data<Node> find_first(Pointer<Node> head) {
+  while (head->next[0] != nullptr)
+    head = head->next[0];
+  return head->data[0];
+}
+
+/// Find the first interval, in order, which holds at least n indices.
+template <typename Node>
+bool find_fit(Pointer<Node> head, std::size_t n, Data<Node> &out) {
+  if (head == nullptr)
+    return false;
+  const bool leaf = head->next[0] == nullptr;
+  for (std::size_t i = 0; i < head->k; ++i) {
+    if (!leaf && find_fit<Node>(head->next[i], n, out))
+      return true;
+    if (head->data[i].size() >= n) {
+      out = head->data[i];
+      return true;
+    }
+  }
+  return !leaf && find_fit<Node>(head->next[head->k], n, out);
+}
+
 template <typename Node>
 Data<Node> check_order(Pointer<Node> head, Data<Node> curr) {
   if (head != nullptr) {
@@ -736,6 +848,33 @@ public:
             0, std::numeric_limits<T>::max()))) {}
   ~index_tracker() { index_tracker_detail::destruct<Node>(head); }
 
+  /// Copy constructor duplicates the B-tree
+  index_tracker(const index_tracker &rhs)
+      : head(index_tracker_detail::copy<Node>(rhs.head)) {}
+
+  /// Copy assignment duplicates the B-tree
+  index_tracker &operator=(const index_tracker &rhs) {
+    if (this != &rhs) {
+      auto nn = index_tracker_detail::copy<Node>(rhs.head);
+      index_tracker_detail::destruct<Node>(head);
+      head = nn;
+    }
+    return *this;
+  }
+
+  /// Move constructor takes ownership of the B-tree
+  index_tracker(index_tracker &&rhs) : head(rhs.head) { rhs.head = nullptr; }
+
+  /// Move assignment takes ownership of the B-tree
+  index_tracker &operator=(index_tracker &&rhs) {
+    if (this != &rhs) {
+      index_tracker_detail::destruct<Node>(head);
+      head = rhs.head;
+      rhs.head = nullptr;
+    }
+    return *this;
+  }
+
   void insert(T x) {
     head = index_tracker_detail::insert_scalar<Node>(head, x);
   }
@@ -749,8 +888,179 @@ public:
     index_tracker_detail::remove_scalar<Node>(head, x);
   }
 
+  /**
+   * @brief      Mark all indices in [a,b) as used.
+   *
+   * Takes one tree update per tracked interval intersecting the range
+   * instead of one per index.
+   *
+   * @param[in]  a     Inclusive lower bound.
+   * @param[in]  b     Exclusive upper bound.
+   */
+  void remove_range(T a, T b) {
+    while (a < b) {
+      auto I = index_tracker_detail::find_overlap<Node>(head, a, b);
+      if (I == nullptr) {
+        return;
+      }
+      // Shrinking keeps the order of the intervals so it is done in place
+      if (I->lower() < a && b < I->upper()) {
+        const T upper = I->upper();
+        I->upper() = a;
+        head = index_tracker_detail::insert<Node>(
+            head, index_tracker_detail::Interval<T>(b, upper));
+        return;
+      } else if (I->lower() < a) {
+        I->upper() = a;
+      } else if (b < I->upper()) {
+        I->lower() = b;
+      } else {
+        head = index_tracker_detail::remove<Node>(head, *I);
+      }
+    }
+  }
+
+  /**
+   * @brief      Mark many indices as used.
+   *
+   * Consecutive runs of indices are removed with remove_range(), so sorted
+   * input such as the keys of a bulk load costs one update per run.
+   *
+   * @param[in]  first  Iterator to the first index.
+   * @param[in]  last   Past-the-end iterator.
+   *
+   * @tparam     Iter   Typename of the input iterator.
+   */
+  template <typename Iter> void remove(Iter first, Iter last) {
+    while (first != last) {
+      T a = *first++;
+      T b = a + 1;
+      while (first != last && *first == b) {
+        ++b;
+        ++first;
+      }
+      remove_range(a, b);
+    }
+  }
+
+  /**
+   * @brief      Mark all indices in [a,b) as available.
+   *
+   * Neighboring available intervals are merged with the range.
+   *
+   * @param[in]  a     Inclusive lower bound.
+   * @param[in]  b     Exclusive upper bound.
+   */
+  void insert_range(T a, T b) {
+    if (!(a < b))
+      return;
+    const T lo = (a > std::numeric_limits<T>::lowest()) ? a - 1 : a;
+    const T hi = (b < std::numeric_limits<T>::max()) ? b + 1 : b;
+    while (auto I = index_tracker_detail::find_overlap<Node>(head, lo, hi)) {
+      a = std::min(a, I->lower());
+      b = std::max(b, I->upper());
+      head = index_tracker_detail::remove<Node>(head, *I);
+    }
+    head = index_tracker_detail::insert<Node>(
+        head, index_tracker_detail::Interval<T>(a, b));
+  }
+
+  /**
+   * @brief      Mark many indices as available.
+   *
+   * @param[in]  first  Iterator to the first index.
+   * @param[in]  last   Past-the-end iterator.
+   *
+   * @tparam     Iter   Typename of the input iterator.
+   */
+  template <typename Iter> void insert(Iter first, Iter last) {
+    while (first != last) {
+      T a = *first++;
+      T b = a + 1;
+      while (first != last && *first == b) {
+        ++b;
+        ++first;
+      }
+      insert_range(a, b);
+    }
+  }
+
+  /**
+   * @brief      Take up to n consecutive indices from the smallest available
+   *             interval.
+   *
+   * @param[in]  n     Maximum number of indices to take.
+   *
+   * @return     The interval of indices taken, which holds at least one
+   *             index.
+   */
+  index_tracker_detail::Interval<T> pop_range(std::size_t n) {
+    if (head == nullptr) {
+      throw std::out_of_range("index_tracker: no available indices");
+    }
+    auto I = index_tracker_detail::find_first<Node>(head);
+    if (I.size() > n) {
+      I.upper() = I.lower() + static_cast<T>(n);
+    }
+    remove_range(I.lower(), I.upper());
+    return I;
+  }
+
+  /**
+   * @brief      Take n indices, smallest available first.
+   *
+   * @param[in]  n     Number of indices to take.
+   * @param[out] out   Output iterator receiving the indices.
+   *
+   * @tparam     OutputIt  Typename of the output iterator.
+   *
+   * @return     Iterator past the last index written.
+   */
+  template <typename OutputIt> OutputIt pop(std::size_t n, OutputIt out) {
+    while (n > 0) {
+      auto I = pop_range(n);
+      for (T x = I.lower(); x < I.upper(); ++x) {
+        *out++ = x;
+      }
+      n -= I.size();
+    }
+    return out;
+  }
+
+  /**
+   * @brief      Take a block of n consecutive indices.
+   *
+   * The first available interval which is large enough is used.
+   *
+   * @param[in]  n     Number of indices to take.
+   *
+   * @return     The interval of n indices taken.
+   */
+  index_tracker_detail::Interval<T> reserve(std::size_t n) {
+    index_tracker_detail::Interval<T> I;
+    if (!index_tracker_detail::find_fit<Node>(head, n, I)) {
+      throw std::out_of_range("index_tracker: no block of requested size");
+    }
+    I.upper() = I.lower() + static_cast<T>(n);
+    remove_range(I.lower(), I.upper());
+    return I;
+  }
+
+  /// Check if index x is available.
+  bool has(T x) const {
+    return index_tracker_detail::find_containing<Node>(head, x) != nullptr;
+  }
+
   bool empty() const { return head == nullptr; }
 
+  /// Number of B-tree nodes. Linear in the number of free intervals.
+  std::size_t node_count() const {
+    return index_tracker_detail::count_nodes<Node>(head);
+  }
+
+  /// Number of heap bytes used by the B-tree.
+  std::size_t bytes() const { return node_count() * sizeof(Node); }
+
   friend std::ostream &operator<<(std::ostream &out, const index_tracker &x) {
     out << x.head;
     return out;
@@ -759,4 +1069,167 @@ public:
 private:
   index_tracker_detail::Pointer<Node> head;
 };
+
+/**
+ * @brief      Index tracker which may be shared by many threads.
+ *
+ * Each thread takes indices through its own concurrent_index_tracker::local
+ * handle. A handle reserves a range of `block` consecutive indices under the
+ * lock and then hands them out without synchronization. Returned indices are
+ * kept by the handle for reuse and given back to the shared tree in sorted
+ * batches once more than `block` have accumulated, or when the handle is
+ * flushed or destroyed.
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * index_tracker::concurrent_index_tracker<int> ids;
+ * ids.remove_range(0, nVertices);
+ * parallel::for_chunks(n, grain, [&](std::size_t, std::size_t b,
+ *                                    std::size_t e) {
+ *     auto local = ids.make_local();
+ *     for (std::size_t i = b; i < e; ++i) keys[i] = local.pop();
+ * });
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     _T    Typename of the indices
+ * @tparam     _d    Max number of interval bins = 2*value+1
+ */
+template <typename _T, std::size_t _d = 16> class concurrent_index_tracker {
+public:
+  using T = _T; /// Typename of the type to store
+
+  /**
+   * @brief      Handle for taking and returning indices from one thread.
+   */
+  class local {
+  public:
+    /// Handles are bound to a tracker.
+    explicit local(concurrent_index_tracker &parent)
+        : _parent(&parent), _range(0, 0) {}
+    local(const local &) = delete;
+    local &operator=(const local &) = delete;
+    /// Move constructor takes over the reserved indices.
+    local(local &&rhs)
+        : _parent(rhs._parent), _range(rhs._range),
+          _returned(std::move(rhs._returned)) {
+      rhs._parent = nullptr;
+      rhs._returned.clear();
+    }
+    /// Give all held indices back to the tracker.
+    ~local() {
+      if (_parent) {
+        flush();
+      }
+    }
+
+    /**
+     * @brief      Take an available index.
+     *
+     * @return     The index, which is no longer available.
+     */
+    T pop() {
+      if (!_returned.empty()) {
+        T x = _returned.back();
+        _returned.pop_back();
+        return x;
+      }
+      if (!(_range.lower() < _range.upper())) {
+        std::lock_guard<std::mutex> lock(_parent->_mutex);
+        _range = _parent->_shared.pop_range(_parent->_block);
+      }
+      return _range.lower()++;
+    }
+
+    /**
+     * @brief      Give back an index.
+     *
+     * @param[in]  x     The index to make available.
+     */
+    void insert(T x) {
+      _returned.push_back(x);
+      if (_returned.size() > _parent->_block) {
+        flush_returned();
+      }
+    }
+
+    /// Give the reserved and returned indices back to the tracker.
+    void flush() {
+      flush_returned();
+      if (_range.lower() < _range.upper()) {
+        std::lock_guard<std::mutex> lock(_parent->_mutex);
+        _parent->_shared.insert_range(_range.lower(), _range.upper());
+      }
+      _range = index_tracker_detail::Interval<T>(0, 0);
+    }
+
+  private:
+    void flush_returned() {
+      if (_returned.empty()) {
+        return;
+      }
+      std::sort(_returned.begin(), _returned.end());
+      std::lock_guard<std::mutex> lock(_parent->_mutex);
+      _parent->_shared.insert(_returned.begin(), _returned.end());
+      _returned.clear();
+    }
+
+    concurrent_index_tracker *_parent;        ///< Owning tracker
+    index_tracker_detail::Interval<T> _range; ///< Reserved indices
+    std::vector<T> _returned;                 ///< Returned indices
+  };
+
+  /**
+   * @brief      Initialize with interval [0~max)
+   *
+   * @param[in]  block  Number of indices reserved by a handle at once.
+   */
+  explicit concurrent_index_tracker(std::size_t block = 1024)
+      : _block(block) {}
+
+  concurrent_index_tracker(const concurrent_index_tracker &) = delete;
+  concurrent_index_tracker &
+  operator=(const concurrent_index_tracker &) = delete;
+
+  /// Get a handle for the calling thread.
+  local make_local() { return local(*this); }
+
+  /// Mark index x as used.
+  void remove(T x) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shared.remove(x);
+  }
+
+  /// Mark all indices in [a,b) as used.
+  void remove_range(T a, T b) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shared.remove_range(a, b);
+  }
+
+  /// Mark index x as available.
+  void insert(T x) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shared.insert(x);
+  }
+
+  /// Mark all indices in [a,b) as available.
+  void insert_range(T a, T b) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shared.insert_range(a, b);
+  }
+
+  /// Take a block of n consecutive indices. See index_tracker::reserve().
+  index_tracker_detail::Interval<T> reserve(std::size_t n) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _shared.reserve(n);
+  }
+
+  /// Check if index x is available in the shared tree.
+  bool has(T x) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _shared.has(x);
+  }
+
+private:
+  std::size_t _block;           ///< Indices reserved by a handle at once
+  mutable std::mutex _mutex;    ///< Guards the shared tree
+  index_tracker<T, _d> _shared; ///< Indices not held by any handle
+};
 } // end namespace index_tracker
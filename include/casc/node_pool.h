@@ -0,0 +1,443 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  node_pool.h
+ * @brief Slab allocators used to store the nodes of a simplicial_complex and
+ *        a recycling allocator for short lived containers.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace casc {
+/**
+ * @brief      Per-type slab allocator with an intrusive free list.
+ *
+ * Objects are carved out of fixed size blocks of `BlockSize` slots. Destroyed
+ * objects return their slot to a free list which is reused by subsequent
+ * constructions, so steady state insertion and removal does not touch the
+ * global heap. All blocks are released at once when the pool is destroyed.
+ *
+ * This is the default node allocator of simplicial_complex. A different
+ * allocator may be selected by defining a `NodeAllocator` alias template in
+ * the complex traits:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * struct complex_traits{
+ *     using KeyType = int;
+ *     using NodeTypes = util::type_holder<int,int,int,int>;
+ *     using EdgeTypes = util::type_holder<int,int,int>;
+ *     template <typename T> using NodeAllocator = casc::new_delete_pool<T>;
+ * };
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     T          Typename of the objects to store.
+ * @tparam     BlockSize  Number of objects per allocated block.
+ */
+template <typename T, std::size_t BlockSize = 1024> class node_pool {
+  static_assert(BlockSize > 0, "node_pool requires a non-zero block size");
+
+public:
+  /// Typename of the stored objects.
+  using value_type = T;
+
+  /// Construct an empty pool. No memory is allocated until first use.
+  node_pool() : _free(nullptr), _next(BlockSize), _live(0) {}
+
+  node_pool(const node_pool &) = delete;
+  node_pool &operator=(const node_pool &) = delete;
+
+  /// Move constructor steals the blocks of another pool.
+  node_pool(node_pool &&rhs)
+      : _blocks(std::move(rhs._blocks)), _free(rhs._free), _next(rhs._next),
+        _live(rhs._live) {
+    rhs._blocks.clear();
+    rhs._free = nullptr;
+    rhs._next = BlockSize;
+    rhs._live = 0;
+  }
+
+  /// Move assignment steals the blocks of another pool.
+  node_pool &operator=(node_pool &&rhs) {
+    if (this != &rhs) {
+      release();
+      _blocks = std::move(rhs._blocks);
+      _free = rhs._free;
+      _next = rhs._next;
+      _live = rhs._live;
+      rhs._blocks.clear();
+      rhs._free = nullptr;
+      rhs._next = BlockSize;
+      rhs._live = 0;
+    }
+    return *this;
+  }
+
+  /**
+   * @brief      Release all blocks.
+   *
+   * Objects still alive in the pool are NOT destructed. The owner is
+   * responsible for destroying them before the pool goes away.
+   */
+  ~node_pool() { release(); }
+
+  /**
+   * @brief      Construct a new object in the pool.
+   *
+   * @param      args  Arguments forwarded to the constructor of T.
+   *
+   * @tparam     Args  Typenames of the constructor arguments.
+   *
+   * @return     Pointer to the new object.
+   */
+  template <typename... Args> T *construct(Args &&... args) {
+    slot *s = acquire();
+    try {
+      T *p = new (static_cast<void *>(s)) T(std::forward<Args>(args)...);
+      ++_live;
+      return p;
+    } catch (...) {
+      s->next = _free;
+      _free = s;
+      throw;
+    }
+  }
+
+  /**
+   * @brief      Destruct an object and recycle its slot.
+   *
+   * @param      p     Pointer to an object previously returned by
+   *                   construct().
+   */
+  void destroy(T *p) {
+    p->~T();
+    slot *s = reinterpret_cast<slot *>(p);
+    s->next = _free;
+    _free = s;
+    --_live;
+  }
+
+  /**
+   * @brief      Free all blocks held by the pool in O(blocks).
+   *
+   * Any objects which have not been destroyed are abandoned without running
+   * their destructors.
+   */
+  void release() {
+    for (auto b : _blocks) {
+      ::operator delete(static_cast<void *>(b));
+    }
+    _blocks.clear();
+    _free = nullptr;
+    _next = BlockSize;
+    _live = 0;
+  }
+
+  /// Number of objects currently alive in the pool.
+  std::size_t size() const { return _live; }
+  /// Number of objects the allocated blocks can hold.
+  std::size_t capacity() const { return _blocks.size() * BlockSize; }
+  /// Number of bytes reserved by the pool.
+  std::size_t bytes() const {
+    return _blocks.size() * BlockSize * sizeof(slot) +
+           _blocks.capacity() * sizeof(slot *);
+  }
+
+private:
+  /// Storage for one object or a link in the free list.
+  union slot {
+    slot *next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  /// Pop a slot from the free list or carve one out of the last block.
+  slot *acquire() {
+    if (_free) {
+      slot *s = _free;
+      _free = s->next;
+      return s;
+    }
+    if (_next == BlockSize) {
+      _blocks.push_back(
+          static_cast<slot *>(::operator new(BlockSize * sizeof(slot))));
+      _next = 0;
+    }
+    return _blocks.back() + _next++;
+  }
+
+  std::vector<slot *> _blocks; ///< Allocated blocks of slots
+  slot *_free;                 ///< Head of the free list
+  std::size_t _next;           ///< Next unused slot in the last block
+  std::size_t _live;           ///< Number of live objects
+};
+
+/**
+ * @brief      Allocator with the node_pool interface which defers to the
+ *             global new and delete.
+ *
+ * Useful for debugging with address sanitizers or to restore the historical
+ * one allocation per node behavior.
+ *
+ * @tparam     T     Typename of the objects to store.
+ */
+template <typename T> class new_delete_pool {
+public:
+  /// Typename of the stored objects.
+  using value_type = T;
+
+  new_delete_pool() : _live(0) {}
+  new_delete_pool(const new_delete_pool &) = delete;
+  new_delete_pool &operator=(const new_delete_pool &) = delete;
+  /// Move constructor
+  new_delete_pool(new_delete_pool &&rhs) : _live(rhs._live) { rhs._live = 0; }
+  /// Move assignment
+  new_delete_pool &operator=(new_delete_pool &&rhs) {
+    _live = rhs._live;
+    rhs._live = 0;
+    return *this;
+  }
+
+  /// Construct a new object with new.
+  template <typename... Args> T *construct(Args &&... args) {
+    T *p = new T(std::forward<Args>(args)...);
+    ++_live;
+    return p;
+  }
+
+  /// Destruct an object with delete.
+  void destroy(T *p) {
+    delete p;
+    --_live;
+  }
+
+  /// Nothing to release; all objects are freed individually.
+  void release() { _live = 0; }
+
+  /// Number of objects currently alive.
+  std::size_t size() const { return _live; }
+  /// Number of objects which may be stored without allocation.
+  std::size_t capacity() const { return _live; }
+  /// Number of bytes reserved by live objects.
+  std::size_t bytes() const { return _live * sizeof(T); }
+
+private:
+  std::size_t _live; ///< Number of live objects
+};
+/// @cond detail
+namespace node_pool_detail {
+/// Intrusive link stored in a cached block.
+struct cached_block {
+  cached_block *next;
+};
+
+/**
+ * @brief      Per-thread cache of freed blocks bucketed by exact size.
+ *
+ * The cache is trivially destructible so that it is still usable by
+ * containers destroyed after the thread local destructors of a thread have
+ * run. Once `dead` is set blocks go straight back to the global heap.
+ *
+ * Only blocks of up to `max_block_bytes` are cached, such as the elements
+ * of node based containers, and each size holds at most `max_class_bytes`.
+ * A thread therefore keeps at most classes * max_class_bytes = 1 MiB.
+ */
+struct block_cache {
+  /// Number of distinct block sizes cached at once.
+  static constexpr std::size_t classes = 16;
+  /// Larger blocks, e.g., hash table bucket arrays, are never cached.
+  static constexpr std::size_t max_block_bytes = 1024;
+  /// Maximum number of bytes cached per size.
+  static constexpr std::size_t max_class_bytes = 64 * 1024;
+
+  /// Maximum number of blocks of a given size cached.
+  static constexpr std::size_t max_blocks(std::size_t bytes) {
+    return max_class_bytes / bytes;
+  }
+
+  std::size_t size[classes];
+  cached_block *head[classes];
+  std::size_t count[classes];
+  bool dead;
+
+  /// Return all cached blocks to the global heap.
+  void flush() {
+    for (std::size_t i = 0; i < classes; ++i) {
+      while (head[i]) {
+        cached_block *b = head[i];
+        head[i] = b->next;
+        ::operator delete(static_cast<void *>(b));
+      }
+      count[i] = 0;
+      size[i] = 0;
+    }
+  }
+};
+
+/// Get the cache of the calling thread. Zero initialized on first use.
+inline block_cache &thread_cache() {
+  static thread_local block_cache cache;
+  return cache;
+}
+
+/// Flushes the cache of a thread when the thread exits.
+struct block_cache_guard {
+  ~block_cache_guard() {
+    block_cache &cache = thread_cache();
+    cache.flush();
+    cache.dead = true;
+  }
+};
+
+/// Make sure the cache of the calling thread is flushed on exit.
+inline void arm_thread_cache() { static thread_local block_cache_guard guard; }
+
+/// Get a block of at least `bytes` bytes, preferring cached blocks.
+inline void *allocate_block(std::size_t bytes) {
+  bytes = std::max(bytes, sizeof(cached_block));
+  block_cache &cache = thread_cache();
+  for (std::size_t i = 0; i < block_cache::classes; ++i) {
+    if (cache.size[i] == bytes && cache.head[i]) {
+      cached_block *b = cache.head[i];
+      cache.head[i] = b->next;
+      --cache.count[i];
+      return b;
+    }
+  }
+  return ::operator new(bytes);
+}
+
+/// Return a block obtained from allocate_block() to the cache.
+inline void deallocate_block(void *p, std::size_t bytes) noexcept {
+  bytes = std::max(bytes, sizeof(cached_block));
+  block_cache &cache = thread_cache();
+  if (!cache.dead && bytes <= block_cache::max_block_bytes) {
+    std::size_t slot = block_cache::classes;
+    for (std::size_t i = 0; i < block_cache::classes; ++i) {
+      if (cache.size[i] == bytes) {
+        slot = i;
+        break;
+      }
+      if (cache.count[i] == 0 && slot == block_cache::classes) {
+        slot = i;
+      }
+    }
+    if (slot < block_cache::classes &&
+        cache.count[slot] < block_cache::max_blocks(bytes)) {
+      arm_thread_cache();
+      cache.size[slot] = bytes;
+      cached_block *b = static_cast<cached_block *>(p);
+      b->next = cache.head[slot];
+      cache.head[slot] = b;
+      ++cache.count[slot];
+      return;
+    }
+  }
+  ::operator delete(p);
+}
+} // end namespace node_pool_detail
+/// @endcond
+
+/**
+ * @brief      Return the blocks cached by recycling_allocator on the
+ *             calling thread to the global heap.
+ *
+ * The cache is bounded, see recycling_allocator, so calling this is only
+ * needed to release memory promptly after a burst of set operations.
+ */
+inline void release_recycled_blocks() {
+  node_pool_detail::thread_cache().flush();
+}
+
+/**
+ * @brief      Standard allocator which keeps freed blocks in a per-thread
+ *             cache for reuse.
+ *
+ * Node based containers such as NodeSet allocate and free one block per
+ * element. Containers which are filled and emptied repeatedly, for example
+ * the scratch sets of a decimation, therefore serve their allocations from
+ * the cache once warmed up instead of going to the global heap. Blocks may
+ * be freed by a different thread than the one which allocated them.
+ *
+ * The cache is shared by all recycling allocators of a thread, including
+ * those of every NodeSet, flat_set and SimplexMap. It is bounded: blocks
+ * larger than 1 KiB bypass it and at most 64 KiB are kept per block size
+ * for 16 sizes, so a thread retains at most 1 MiB. Use
+ * release_recycled_blocks() to return it earlier.
+ *
+ * @tparam     T     Typename of the objects to allocate.
+ */
+template <typename T> class recycling_allocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "recycling_allocator does not support over-aligned types");
+
+public:
+  /// Typename of the allocated objects.
+  using value_type = T;
+
+  recycling_allocator() noexcept {}
+  /// Rebinding constructor.
+  template <typename U>
+  recycling_allocator(const recycling_allocator<U> &) noexcept {}
+
+  /// Largest number of objects which can be allocated at once.
+  std::size_t max_size() const noexcept {
+    return static_cast<std::size_t>(-1) / sizeof(T);
+  }
+
+  /**
+   * @brief      Allocate storage for n objects.
+   *
+   * @param[in]  n     Number of objects.
+   *
+   * @return     Pointer to the storage.
+   *
+   * @throws     std::bad_array_new_length if n exceeds max_size().
+   */
+  T *allocate(std::size_t n) {
+    if (n > max_size()) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(node_pool_detail::allocate_block(n * sizeof(T)));
+  }
+
+  /// Release storage for n objects.
+  void deallocate(T *p, std::size_t n) noexcept {
+    node_pool_detail::deallocate_block(p, n * sizeof(T));
+  }
+};
+
+/// All recycling allocators are interchangeable.
+template <typename T, typename U>
+bool operator==(const recycling_allocator<T> &,
+                const recycling_allocator<U> &) {
+  return true;
+}
+
+/// All recycling allocators are interchangeable.
+template <typename T, typename U>
+bool operator!=(const recycling_allocator<T> &,
+                const recycling_allocator<U> &) {
+  return false;
+}
+} // end namespace casc
@@ -0,0 +1,274 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  parallel.h
+ * @brief Minimal fork-join helpers used by the parallel code paths.
+ *
+ * Threads are only spawned when the library is built with the
+ * `CASC_ENABLE_PARALLEL` CMake option, which defines the macro of the same
+ * name. Otherwise every helper runs serially on the calling thread so that
+ * callers can use a single code path.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#ifdef CASC_ENABLE_PARALLEL
+#include <thread>
+#endif
+
+namespace casc {
+namespace parallel {
+/// @cond detail
+namespace parallel_detail {
+/// Number of worker threads requested by the user, 0 selects the default.
+inline std::atomic<std::size_t> &requested_threads() {
+  static std::atomic<std::size_t> n(0);
+  return n;
+}
+} // end namespace parallel_detail
+/// @endcond
+
+/**
+ * @brief      Set the number of threads used by the parallel helpers.
+ *
+ * @param[in]  n     Number of threads. Zero restores the default of
+ *                   std::thread::hardware_concurrency().
+ */
+inline void set_num_threads(std::size_t n) {
+  parallel_detail::requested_threads() = n;
+}
+
+/**
+ * @brief      Get the number of threads used by the parallel helpers.
+ *
+ * @return     Always 1 unless built with CASC_ENABLE_PARALLEL.
+ */
+inline std::size_t num_threads() {
+#ifdef CASC_ENABLE_PARALLEL
+  std::size_t n = parallel_detail::requested_threads();
+  if (n == 0) {
+    n = std::thread::hardware_concurrency();
+  }
+  return std::max<std::size_t>(n, 1);
+#else
+  return 1;
+#endif
+}
+
+/**
+ * @brief      Number of chunks for_chunks() will split a range into.
+ *
+ * @param[in]  n      Number of items.
+ * @param[in]  grain  Minimum number of items per chunk.
+ *
+ * @return     The number of chunks, at least 1.
+ */
+inline std::size_t chunk_count(std::size_t n, std::size_t grain) {
+  const std::size_t max_chunks = n / std::max<std::size_t>(grain, 1);
+  return std::min(num_threads(), std::max<std::size_t>(max_chunks, 1));
+}
+
+/**
+ * @brief      Split [0, n) into contiguous chunks and process them
+ *             concurrently.
+ *
+ * Ranges smaller than `grain` are processed serially by the calling thread.
+ * The first exception thrown by any chunk is rethrown after all threads have
+ * joined.
+ *
+ * @param[in]  n      Number of items.
+ * @param[in]  grain  Minimum number of items per chunk.
+ * @param[in]  fn     Functor called as fn(chunk, begin, end).
+ *
+ * @tparam     Fn     Typename of the functor.
+ *
+ * @return     Number of chunks used; chunk indices are in [0, rval).
+ */
+template <typename Fn>
+std::size_t for_chunks(std::size_t n, std::size_t grain, Fn &&fn) {
+  const std::size_t chunks = chunk_count(n, grain);
+  if (chunks <= 1) {
+    fn(std::size_t(0), std::size_t(0), n);
+    return 1;
+  }
+#ifdef CASC_ENABLE_PARALLEL
+  std::vector<std::thread> workers;
+  std::vector<std::exception_ptr> errors(chunks);
+  workers.reserve(chunks - 1);
+  auto run = [&](std::size_t c) {
+    try {
+      fn(c, n * c / chunks, n * (c + 1) / chunks);
+    } catch (...) {
+      errors[c] = std::current_exception();
+    }
+  };
+  for (std::size_t c = 1; c < chunks; ++c) {
+    workers.emplace_back(run, c);
+  }
+  run(0);
+  for (auto &w : workers) {
+    w.join();
+  }
+  for (auto &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+#endif
+  return chunks;
+}
+
+/**
+ * @brief      Process [0, n) in small blocks handed out dynamically.
+ *
+ * Every thread repeatedly claims the next block of `grain` items from a
+ * shared counter until the range is exhausted. Threads which finish early
+ * thereby take over blocks a slower thread would otherwise still have to
+ * process, which balances irregular per-item costs better than the fixed
+ * chunks of for_chunks(). The first exception thrown by any block stops
+ * the distribution of further blocks and is rethrown after all threads
+ * have joined.
+ *
+ * @param[in]  n      Number of items.
+ * @param[in]  grain  Number of items per block.
+ * @param[in]  fn     Functor called as fn(worker, begin, end) for each
+ *                    block.
+ *
+ * @tparam     Fn     Typename of the functor.
+ *
+ * @return     Number of workers used; worker indices are in [0, rval).
+ */
+template <typename Fn>
+std::size_t for_blocks(std::size_t n, std::size_t grain, Fn &&fn) {
+  grain = std::max<std::size_t>(grain, 1);
+  const std::size_t blocks = (n + grain - 1) / grain;
+  const std::size_t workers =
+      std::min(num_threads(), std::max<std::size_t>(blocks, 1));
+  if (workers <= 1) {
+    for (std::size_t b = 0; b < n; b += grain) {
+      fn(std::size_t(0), b, std::min(b + grain, n));
+    }
+    return 1;
+  }
+#ifdef CASC_ENABLE_PARALLEL
+  std::atomic<std::size_t> next(0);
+  std::vector<std::thread> threads;
+  std::vector<std::exception_ptr> errors(workers);
+  threads.reserve(workers - 1);
+  auto run = [&](std::size_t w) {
+    try {
+      std::size_t b;
+      while ((b = next.fetch_add(grain)) < n) {
+        fn(w, b, std::min(b + grain, n));
+      }
+    } catch (...) {
+      errors[w] = std::current_exception();
+      next = n;
+    }
+  };
+  for (std::size_t w = 1; w < workers; ++w) {
+    threads.emplace_back(run, w);
+  }
+  run(0);
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (auto &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+#endif
+  return workers;
+}
+
+/**
+ * @brief      Parallel version of std::sort.
+ *
+ * The range is split into one chunk per thread, the chunks are sorted
+ * concurrently and then merged pairwise.
+ *
+ * @param[in]  first  Begin of the range.
+ * @param[in]  last   End of the range.
+ * @param[in]  comp   Strict weak ordering.
+ * @param[in]  grain  Minimum number of items per chunk.
+ *
+ * @tparam     RandomIt  Random access iterator type.
+ * @tparam     Compare   Typename of the comparator.
+ */
+template <typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp,
+          std::size_t grain = 1 << 14) {
+  const std::size_t n = std::distance(first, last);
+  std::vector<std::size_t> bounds;
+  const std::size_t chunks = chunk_count(n, grain);
+  if (chunks <= 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+  for (std::size_t c = 0; c <= chunks; ++c) {
+    bounds.push_back(n * c / chunks);
+  }
+  for_chunks(chunks, 1, [&](std::size_t, std::size_t b, std::size_t e) {
+    for (std::size_t c = b; c < e; ++c) {
+      std::sort(first + bounds[c], first + bounds[c + 1], comp);
+    }
+  });
+  // Merge neighbouring runs until a single run remains
+  while (bounds.size() > 2) {
+    const std::size_t pairs = (bounds.size() - 1) / 2;
+    for_chunks(pairs, 1, [&](std::size_t, std::size_t b, std::size_t e) {
+      for (std::size_t p = b; p < e; ++p) {
+        std::inplace_merge(first + bounds[2 * p], first + bounds[2 * p + 1],
+                           first + bounds[2 * p + 2], comp);
+      }
+    });
+    std::vector<std::size_t> next;
+    for (std::size_t i = 0; i < bounds.size(); i += 2) {
+      next.push_back(bounds[i]);
+    }
+    if (next.back() != bounds.back()) {
+      next.push_back(bounds.back());
+    }
+    bounds.swap(next);
+  }
+}
+
+/**
+ * @brief      Parallel version of std::sort using operator<.
+ *
+ * @param[in]  first  Begin of the range.
+ * @param[in]  last   End of the range.
+ *
+ * @tparam     RandomIt  Random access iterator type.
+ */
+template <typename RandomIt> void sort(RandomIt first, RandomIt last) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  casc::parallel::sort(first, last, std::less<T>());
+}
+} // end namespace parallel
+} // end namespace casc
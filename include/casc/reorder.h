@@ -0,0 +1,583 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  reorder.h
+ * @brief Renumber the vertices of a complex to improve locality.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SimplicialComplex.h"
+#include "util.h"
+
+namespace casc {
+/// @cond detail
+/// Namespace for helpers of the vertex orderings
+namespace reorder_detail {
+/**
+ * @brief      Vertex adjacency of a complex in compressed sparse rows.
+ *
+ * Vertices are numbered densely in level order. The neighbors of vertex i
+ * are adj[offsets[i]] ... adj[offsets[i+1]-1].
+ *
+ * @tparam     Complex  Typename of the simplicial_complex
+ */
+template <typename Complex> struct vertex_graph {
+  /// Typename of the vertex keys
+  using KeyType = typename Complex::KeyType;
+
+  /// Key of each vertex
+  std::vector<KeyType> keys;
+  /// Start of the neighbors of each vertex, followed by the end
+  std::vector<std::size_t> offsets;
+  /// Concatenated neighbors of all vertices
+  std::vector<std::size_t> adj;
+
+  /// Build the graph of the vertices and edges of F.
+  explicit vertex_graph(const Complex &F) {
+    std::unordered_map<KeyType, std::size_t> index;
+    index.reserve(F.template size<1>());
+    for (auto v : F.template get_level_id<1>()) {
+      index.emplace(F.get_name(v)[0], keys.size());
+      keys.push_back(F.get_name(v)[0]);
+    }
+    offsets.reserve(keys.size() + 1);
+    offsets.push_back(0);
+    for (auto key : keys) {
+      for (auto w : F.cover_view(F.get_simplex_up({key}))) {
+        adj.push_back(index.at(w));
+      }
+      offsets.push_back(adj.size());
+    }
+  }
+
+  /// Number of vertices
+  std::size_t size() const { return keys.size(); }
+  /// Number of neighbors of vertex i
+  std::size_t degree(std::size_t i) const {
+    return offsets[i + 1] - offsets[i];
+  }
+};
+
+/**
+ * @brief      Breadth first search from one vertex.
+ *
+ * @param[in]  G          The graph.
+ * @param[in]  start      The vertex to start from.
+ * @param      visited    Marks of visited vertices, updated.
+ * @param      order      Visited vertices are appended in order.
+ * @param[in]  by_degree  Whether to visit the neighbors of each vertex in
+ *                        order of increasing degree.
+ * @param[out] last       The vertices of the last level of the search.
+ *
+ * @tparam     Graph      Typename of the vertex_graph.
+ *
+ * @return     The number of levels of the search.
+ */
+template <typename Graph>
+std::size_t bfs_sweep(const Graph &G, std::size_t start,
+                      std::vector<bool> &visited,
+                      std::vector<std::size_t> &order, bool by_degree,
+                      std::vector<std::size_t> &last) {
+  std::size_t head = order.size();
+  std::size_t level_begin = head;
+  std::size_t level_end = head + 1;
+  std::size_t height = 1;
+  order.push_back(start);
+  visited[start] = true;
+  while (head < order.size()) {
+    if (head == level_end) {
+      level_begin = level_end;
+      level_end = order.size();
+      ++height;
+    }
+    const std::size_t u = order[head++];
+    const std::size_t first = order.size();
+    for (auto i = G.offsets[u]; i < G.offsets[u + 1]; ++i) {
+      const std::size_t w = G.adj[i];
+      if (!visited[w]) {
+        visited[w] = true;
+        order.push_back(w);
+      }
+    }
+    if (by_degree) {
+      std::stable_sort(order.begin() + first, order.end(),
+                       [&](std::size_t a, std::size_t b) {
+                         return G.degree(a) < G.degree(b);
+                       });
+    }
+  }
+  last.assign(order.begin() + level_begin, order.begin() + level_end);
+  return height;
+}
+
+/**
+ * @brief      Find a vertex of large eccentricity in the component of
+ *             `start` following George and Liu.
+ *
+ * @param[in]  G        The graph.
+ * @param[in]  start    A vertex of the component.
+ * @param      visited  Scratch marks, all false before and after.
+ *
+ * @tparam     Graph  Typename of the vertex_graph.
+ *
+ * @return     A pseudo-peripheral vertex.
+ */
+template <typename Graph>
+std::size_t pseudo_peripheral(const Graph &G, std::size_t start,
+                              std::vector<bool> &visited) {
+  std::vector<std::size_t> order, last;
+  std::size_t height = bfs_sweep(G, start, visited, order, false, last);
+  for (;;) {
+    // Reset only the marks of this component
+    for (auto v : order) {
+      visited[v] = false;
+    }
+    const std::size_t next =
+        *std::min_element(last.begin(), last.end(),
+                          [&](std::size_t a, std::size_t b) {
+                            return G.degree(a) < G.degree(b);
+                          });
+    order.clear();
+    const std::size_t h = bfs_sweep(G, next, visited, order, false, last);
+    if (h <= height) {
+      for (auto v : order) {
+        visited[v] = false;
+      }
+      return start;
+    }
+    start = next;
+    height = h;
+  }
+}
+
+/**
+ * @brief      Order the vertices of a graph one component at a time.
+ *
+ * @param[in]  G          The graph.
+ * @param[in]  by_degree  Search in Cuthill-McKee order from a
+ *                        pseudo-peripheral vertex instead of plain breadth
+ *                        first from the first vertex of each component.
+ *
+ * @tparam     Graph      Typename of the vertex_graph.
+ *
+ * @return     The keys of the vertices in the new order.
+ */
+template <typename Graph>
+std::vector<typename Graph::KeyType> graph_order(const Graph &G,
+                                                 bool by_degree) {
+  std::vector<bool> visited(G.size(), false), scratch(G.size(), false);
+  std::vector<std::size_t> order, last;
+  order.reserve(G.size());
+  for (std::size_t i = 0; i < G.size(); ++i) {
+    if (!visited[i]) {
+      const std::size_t start =
+          by_degree ? pseudo_peripheral(G, i, scratch) : i;
+      bfs_sweep(G, start, visited, order, by_degree, last);
+    }
+  }
+  std::vector<typename Graph::KeyType> keys;
+  keys.reserve(order.size());
+  for (auto i : order) {
+    keys.push_back(G.keys[i]);
+  }
+  return keys;
+}
+
+/**
+ * @brief      Position of a point along a 3D Hilbert curve.
+ *
+ * Uses the transpose algorithm of Skilling, "Programming the Hilbert
+ * curve", AIP Conf. Proc. 707 (2004).
+ *
+ * @param      X     Integer coordinates below 2^bits, overwritten.
+ * @param[in]  bits  Number of bits per coordinate, at most 21.
+ *
+ * @return     The index along the curve.
+ */
+inline std::uint64_t hilbert_index(std::array<std::uint32_t, 3> X,
+                                   unsigned bits) {
+  const std::uint32_t M = 1u << (bits - 1);
+  // Inverse undo excess work
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1) {
+    const std::uint32_t P = Q - 1;
+    for (std::size_t i = 0; i < 3; ++i) {
+      if (X[i] & Q) {
+        X[0] ^= P;
+      } else {
+        const std::uint32_t t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+  // Gray encode
+  for (std::size_t i = 1; i < 3; ++i) {
+    X[i] ^= X[i - 1];
+  }
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1) {
+    if (X[2] & Q) {
+      t ^= Q - 1;
+    }
+  }
+  for (auto &x : X) {
+    x ^= t;
+  }
+  // Interleave the transposed bits
+  std::uint64_t h = 0;
+  for (unsigned b = bits; b-- > 0;) {
+    for (auto x : X) {
+      h = (h << 1) | ((x >> b) & 1u);
+    }
+  }
+  return h;
+}
+
+/**
+ * @brief      Functor to copy one level into a renumbered complex.
+ *
+ * @tparam     Complex  Typename of the simplicial_complex
+ */
+template <typename Complex> struct RenumberLevel {
+  /// Typename of the vertex keys
+  using KeyType = typename Complex::KeyType;
+  /// Typename of the map from old to new keys
+  using KeyMap = std::unordered_map<KeyType, KeyType>;
+
+  /**
+   * @brief      Insert the renamed simplices of level k in sorted order.
+   *
+   * @param[in]  F      The complex to copy.
+   * @param      G      The renumbered complex.
+   * @param[in]  remap  The new key of each old key.
+   *
+   * @tparam     k      The level to copy.
+   */
+  template <std::size_t k>
+  void apply(const Complex &F, Complex &G, const KeyMap &remap) {
+    copy<k>(F, G, remap, std::integral_constant<bool, (k > 0)>());
+  }
+
+  /// Copy the data of the root.
+  template <std::size_t k>
+  static void copy(const Complex &F, Complex &G, const KeyMap &,
+                   std::false_type) {
+    copy_data(F.get_simplex_up(), G.get_simplex_up(),
+              std::is_void<typename Complex::template NodeData<0>>());
+  }
+
+  /// Copy the simplices of level k.
+  template <std::size_t k>
+  static void copy(const Complex &F, Complex &G, const KeyMap &remap,
+                   std::true_type) {
+    using Name = std::array<KeyType, k>;
+    using SimplexID = typename Complex::template SimplexID<k>;
+    std::vector<std::pair<Name, SimplexID>> items;
+    items.reserve(F.template size<k>());
+    for (auto s : F.template get_level_id<k>()) {
+      Name name = F.get_name(s);
+      for (auto &key : name) {
+        key = remap.at(key);
+      }
+      std::sort(name.begin(), name.end());
+      items.emplace_back(name, s);
+    }
+    std::sort(items.begin(), items.end(),
+              [](const std::pair<Name, SimplexID> &a,
+                 const std::pair<Name, SimplexID> &b) {
+                return a.first < b.first;
+              });
+    std::vector<KeyType> keys;
+    keys.reserve(items.size() * k);
+    for (const auto &item : items) {
+      keys.insert(keys.end(), item.first.begin(), item.first.end());
+    }
+    insert<k>(F, G, items, keys,
+              std::is_void<typename Complex::template NodeData<k>>());
+    copy_edges<k>(F, G, items, remap,
+                  std::is_void<typename Complex::template EdgeData<k - 1>>());
+  }
+
+  /// Insert simplices with data.
+  template <std::size_t k, typename Items>
+  static void insert(const Complex &, Complex &G, const Items &items,
+                     const std::vector<KeyType> &keys, std::false_type) {
+    std::vector<typename Complex::template NodeData<k>> data;
+    data.reserve(items.size());
+    for (const auto &item : items) {
+      data.push_back(*item.second);
+    }
+    G.template bulk_insert<k>(keys.data(), items.size(), data.data());
+  }
+
+  /// Insert simplices without data.
+  template <std::size_t k, typename Items>
+  static void insert(const Complex &, Complex &G, const Items &items,
+                     const std::vector<KeyType> &keys, std::true_type) {
+    G.template bulk_insert<k>(keys.data(), items.size());
+  }
+
+  /// Copy the data of the edges down from level k.
+  template <std::size_t k, typename Items>
+  static void copy_edges(const Complex &F, Complex &G, const Items &items,
+                         const KeyMap &remap, std::false_type) {
+    for (const auto &item : items) {
+      auto t = G.get_simplex_up(item.first);
+      for (auto v : F.get_name(item.second)) {
+        *G.get_edge_down(t, remap.at(v)) =
+            *F.get_edge_down(item.second, v);
+      }
+    }
+  }
+
+  /// Levels without edge data.
+  template <std::size_t k, typename Items>
+  static void copy_edges(const Complex &, Complex &, const Items &,
+                         const KeyMap &, std::true_type) {}
+
+  /// Copy the data of a simplex.
+  template <typename From, typename To>
+  static void copy_data(From s, To t, std::false_type) {
+    *t = *s;
+  }
+
+  /// There is no data to copy.
+  template <typename From, typename To>
+  static void copy_data(From, To, std::true_type) {}
+};
+} // end namespace reorder_detail
+/// @endcond
+
+/**
+ * @brief      Order vertices by breadth first search.
+ *
+ * Each component is searched from its first vertex in level order and the
+ * neighbors of a vertex are visited in order of their keys.
+ */
+struct bfs_order {
+  /**
+   * @brief      Compute the order.
+   *
+   * @param[in]  F        The complex.
+   *
+   * @tparam     Complex  Typename of the simplicial_complex
+   *
+   * @return     The keys of all vertices in the new order.
+   */
+  template <typename Complex>
+  std::vector<typename Complex::KeyType> operator()(const Complex &F) const {
+    return reorder_detail::graph_order(reorder_detail::vertex_graph<Complex>(F),
+                                       false);
+  }
+};
+
+/**
+ * @brief      Order vertices by reverse Cuthill-McKee.
+ *
+ * Each component is searched from a pseudo-peripheral vertex, visiting the
+ * neighbors of each vertex in order of increasing degree, and the whole
+ * order is reversed. This keeps the bandwidth of matrices indexed by vertex
+ * small.
+ */
+struct rcm_order {
+  /**
+   * @brief      Compute the order.
+   *
+   * @param[in]  F        The complex.
+   *
+   * @tparam     Complex  Typename of the simplicial_complex
+   *
+   * @return     The keys of all vertices in the new order.
+   */
+  template <typename Complex>
+  std::vector<typename Complex::KeyType> operator()(const Complex &F) const {
+    auto keys = reorder_detail::graph_order(
+        reorder_detail::vertex_graph<Complex>(F), true);
+    std::reverse(keys.begin(), keys.end());
+    return keys;
+  }
+};
+
+/**
+ * @brief      Order vertices along a Hilbert curve through their positions.
+ *
+ * The bounding box of the vertices is divided into a grid of 2^21 cells per
+ * axis and the vertices are sorted by the position of their cell along the
+ * curve. Vertices in the same cell keep their level order.
+ *
+ * @tparam     Coord  Typename of a functor called as coord(F, SimplexID<1>)
+ *                    which returns the position of a vertex as any type
+ *                    whose elements 0, 1 and 2 convert to double. Use 0
+ *                    for the third coordinate of planar meshes.
+ */
+template <typename Coord> struct hilbert_order {
+  /// The position of each vertex
+  Coord coord;
+
+  /**
+   * @brief      Compute the order.
+   *
+   * @param[in]  F        The complex.
+   *
+   * @tparam     Complex  Typename of the simplicial_complex
+   *
+   * @return     The keys of all vertices in the new order.
+   */
+  template <typename Complex>
+  std::vector<typename Complex::KeyType> operator()(const Complex &F) const {
+    using KeyType = typename Complex::KeyType;
+    constexpr unsigned bits = 21;
+    std::vector<std::array<double, 3>> x;
+    std::vector<KeyType> keys;
+    x.reserve(F.template size<1>());
+    keys.reserve(F.template size<1>());
+    std::array<double, 3> lo, hi;
+    lo.fill(std::numeric_limits<double>::infinity());
+    hi.fill(-std::numeric_limits<double>::infinity());
+    for (auto v : F.template get_level_id<1>()) {
+      const auto &p = coord(F, v);
+      std::array<double, 3> q{{static_cast<double>(p[0]),
+                               static_cast<double>(p[1]),
+                               static_cast<double>(p[2])}};
+      for (std::size_t i = 0; i < 3; ++i) {
+        lo[i] = std::min(lo[i], q[i]);
+        hi[i] = std::max(hi[i], q[i]);
+      }
+      x.push_back(q);
+      keys.push_back(F.get_name(v)[0]);
+    }
+    const double cells = static_cast<double>((1u << bits) - 1);
+    std::vector<std::pair<std::uint64_t, KeyType>> order;
+    order.reserve(keys.size());
+    for (std::size_t j = 0; j < keys.size(); ++j) {
+      std::array<std::uint32_t, 3> cell;
+      for (std::size_t i = 0; i < 3; ++i) {
+        const double extent = hi[i] - lo[i];
+        cell[i] = extent > 0 ? static_cast<std::uint32_t>(
+                                   (x[j][i] - lo[i]) / extent * cells)
+                             : 0;
+      }
+      order.emplace_back(reorder_detail::hilbert_index(cell, bits), keys[j]);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const std::pair<std::uint64_t, KeyType> &a,
+                        const std::pair<std::uint64_t, KeyType> &b) {
+                       return a.first < b.first;
+                     });
+    for (std::size_t j = 0; j < keys.size(); ++j) {
+      keys[j] = order[j].second;
+    }
+    return keys;
+  }
+};
+
+/**
+ * @brief      Make a hilbert_order from a coordinate functor.
+ *
+ * @param[in]  coord  Functor called as coord(F, SimplexID<1>).
+ *
+ * @tparam     Coord  Typename of the functor.
+ *
+ * @return     The ordering.
+ */
+template <typename Coord> hilbert_order<Coord> make_hilbert_order(Coord coord) {
+  return hilbert_order<Coord>{coord};
+}
+
+/**
+ * @brief      Renumber the vertices of a complex in a given order.
+ *
+ * The i-th vertex of `order` gets the key i. The complex is rebuilt level
+ * by level with the simplices of each level inserted in order of their new
+ * names, so that simplices sharing vertices are close in memory and in
+ * get_level_id(). Node and edge data are kept. All SimplexIDs of the
+ * complex are invalidated.
+ *
+ * @param      F        The complex to renumber.
+ * @param[in]  order    The keys of all vertices of F, each exactly once.
+ *
+ * @tparam     Complex  Typename of the simplicial_complex
+ */
+template <typename Complex>
+void renumber(Complex &F, const std::vector<typename Complex::KeyType> &order) {
+  using KeyType = typename Complex::KeyType;
+  if (order.size() != F.template size<1>()) {
+    throw std::invalid_argument("renumber: order must list every vertex");
+  }
+  std::unordered_map<KeyType, KeyType> remap;
+  remap.reserve(order.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    if (!F.exists({order[i]}) ||
+        !remap.emplace(order[i], static_cast<KeyType>(i)).second) {
+      throw std::invalid_argument("renumber: order must list every vertex");
+    }
+  }
+  Complex G;
+  util::int_for_each<std::size_t, typename Complex::LevelIndex>(
+      reorder_detail::RenumberLevel<Complex>(), F, G, remap);
+  F = std::move(G);
+}
+
+/**
+ * @brief      Renumber the vertices of a complex to improve locality.
+ *
+ * Example -- renumber a mesh for a small matrix bandwidth:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * auto perm = casc::reorder(mesh, casc::rcm_order());
+ * // Vertex i of the renumbered mesh was vertex perm[i]
+ * ~~~~~~~~~~~~~~~
+ *
+ * Example -- renumber along a space filling curve:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::reorder(mesh, casc::make_hilbert_order(
+ *     [](const Mesh &F, Mesh::SimplexID<1> v) { return (*v).position; }));
+ * ~~~~~~~~~~~~~~~
+ *
+ * @param      F         The complex to renumber.
+ * @param[in]  strategy  Functor called as strategy(F) returning the keys of
+ *                       all vertices in the new order, e.g., bfs_order,
+ *                       rcm_order or hilbert_order.
+ *
+ * @tparam     Complex   Typename of the simplicial_complex
+ * @tparam     Strategy  Typename of the ordering functor
+ *
+ * @return     The old key of each new vertex key.
+ *
+ * @see        renumber()
+ */
+template <typename Complex, typename Strategy>
+std::vector<typename Complex::KeyType> reorder(Complex &F,
+                                               Strategy &&strategy) {
+  auto order = strategy(static_cast<const Complex &>(F));
+  renumber(F, order);
+  return order;
+}
+} // end namespace casc
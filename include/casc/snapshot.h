@@ -0,0 +1,173 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  snapshot.h
+ * @brief Publish read-only snapshots of a complex to concurrent readers.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "FrozenComplex.h"
+
+namespace casc {
+/**
+ * @brief      Single writer, multiple reader publication of snapshots.
+ *
+ * A simplicial_complex edits the `_up` and `_down` maps of its nodes in
+ * place, so readers cannot traverse it while a writer inserts, removes or
+ * decimates, even if freeing the nodes were deferred. Instead the writer
+ * publishes immutable snapshots, such as a frozen_complex, and readers pin
+ * the current one. A pinned snapshot stays valid and unchanged for as long
+ * as the reader holds it, however many newer snapshots are published.
+ *
+ * Pinning is an atomic load of a shared pointer, so readers never wait for
+ * the writer and their latency does not depend on what the writer is
+ * doing. Replaced snapshots are retired rather than dropped and are only
+ * destroyed by collect() or publish() on the writer thread once no reader
+ * pins them anymore, so readers never pay for reclamation either.
+ *
+ * publish() and collect() must be called from one writer thread at a
+ * time. pin() and epoch() may be called from any number of threads.
+ *
+ * Example -- query a mesh while it is being decimated:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::frozen_publisher<Mesh> snapshots(casc::freeze(mesh));
+ * std::thread reader([&] {
+ *   while (running) {
+ *     auto F = snapshots.pin();
+ *     casc::SimplexSet<casc::frozen_complex<Mesh>> star;
+ *     casc::getStar(*F, F->get_simplex_up({key}), star);
+ *   }
+ * });
+ * for (int round = 0; round < 10; ++round) {
+ *   casc::decimate_by_cost(mesh, mesh.size<3>() * 9 / 10, cost, callback);
+ *   snapshots.publish(casc::freeze(mesh));
+ * }
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     Snapshot  Typename of the immutable snapshots.
+ */
+template <typename Snapshot> class snapshot_publisher {
+public:
+  /// Typename of a pinned snapshot
+  using pointer = std::shared_ptr<const Snapshot>;
+
+  /// Construct a publisher without a snapshot. pin() returns nullptr.
+  snapshot_publisher() : _epoch(0) {}
+
+  /**
+   * @brief      Construct a publisher with a first snapshot.
+   *
+   * @param      snapshot  The snapshot to move from.
+   */
+  explicit snapshot_publisher(Snapshot &&snapshot) : _epoch(0) {
+    publish(std::move(snapshot));
+  }
+
+  snapshot_publisher(const snapshot_publisher &) = delete;
+  snapshot_publisher &operator=(const snapshot_publisher &) = delete;
+
+  /**
+   * @brief      Pin the current snapshot.
+   *
+   * @return     The snapshot, which stays valid while the pointer is held.
+   */
+  pointer pin() const { return std::atomic_load(&_current); }
+
+  /**
+   * @brief      Get the number of snapshots published so far.
+   *
+   * @return     The epoch, which increases with every publish().
+   */
+  std::size_t epoch() const { return _epoch.load(std::memory_order_acquire); }
+
+  /**
+   * @brief      Replace the current snapshot.
+   *
+   * Readers which pinned the previous snapshot keep it. It is retired and
+   * destroyed by a later collect() once they release it.
+   *
+   * @param      snapshot  The snapshot to move from.
+   *
+   * @return     The epoch of the new snapshot.
+   */
+  std::size_t publish(Snapshot &&snapshot) {
+    return publish(std::make_shared<const Snapshot>(std::move(snapshot)));
+  }
+
+  /**
+   * @brief      Replace the current snapshot.
+   *
+   * @param[in]  snapshot  The snapshot to share.
+   *
+   * @return     The epoch of the new snapshot.
+   */
+  std::size_t publish(pointer snapshot) {
+    pointer old = std::atomic_exchange(&_current, std::move(snapshot));
+    if (old) {
+      _retired.push_back(std::move(old));
+    }
+    const std::size_t e = _epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+    collect();
+    return e;
+  }
+
+  /**
+   * @brief      Destroy the retired snapshots no reader pins anymore.
+   *
+   * A retired snapshot can no longer be pinned, so once the publisher
+   * holds its only reference it is safe to destroy.
+   *
+   * @return     Number of retired snapshots still pinned by readers.
+   */
+  std::size_t collect() {
+    _retired.erase(std::remove_if(_retired.begin(), _retired.end(),
+                                  [](const pointer &p) {
+                                    return p.use_count() == 1;
+                                  }),
+                   _retired.end());
+    return _retired.size();
+  }
+
+  /// Number of retired snapshots which have not been destroyed yet.
+  std::size_t retired() const { return _retired.size(); }
+
+private:
+  pointer _current;
+  std::atomic<std::size_t> _epoch;
+  std::vector<pointer> _retired; ///< Written by the writer thread only
+};
+
+/**
+ * @brief      Publisher of frozen_complex snapshots of a complex.
+ *
+ * @tparam     Complex  Typename of the simplicial_complex.
+ * @tparam     Index    Integral type used to store simplex indices.
+ */
+template <typename Complex, typename Index = std::uint32_t>
+using frozen_publisher = snapshot_publisher<frozen_complex<Complex, Index>>;
+} // end namespace casc
@@ -0,0 +1,399 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  stats.h
+ * @brief Counters and timers of the hot paths of casc.
+ *
+ * The library only records events when it is built with the
+ * `CASC_ENABLE_STATS` CMake option, which defines the macro of the same
+ * name. Otherwise the CASC_STATS_RECORD() and CASC_STATS_SPAN() macros expand
+ * to nothing and the counters stay at zero. The functions to read the
+ * counters are always available so that callers can use a single code path.
+ *
+ * Example -- print where the time went and forward spans to a tracer:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::stats::set_span_callback(
+ *     [](casc::stats::event ev, std::uint64_t value, std::uint64_t ns,
+ *        void *) { tracer::span(casc::stats::name(ev), value, ns); });
+ * casc::decimate_by_cost(mesh, 1000, cost, Callback<Mesh>());
+ * std::cout << casc::stats::snapshot() << std::endl;
+ * ~~~~~~~~~~~~~~~
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace casc {
+namespace stats {
+/**
+ * @brief      Instrumented events.
+ *
+ * Each event accumulates how often it occurred, the sum and maximum of a
+ * value whose meaning depends on the event and, for timed events, the time
+ * spent.
+ */
+enum class event : std::size_t {
+  create_node,           ///< Timed, the value is the level of the node
+  remove_node,           ///< Timed, the value is the level of the node
+  insert,                ///< Step of insert, the value is its depth
+  get_recurse,           ///< One hop of a lookup by name
+  bfs_up,                ///< Frontier of visit_BFS_up, the value is its size
+  bfs_down,              ///< Frontier of visit_BFS_down, the value is its size
+  btree_split,           ///< index_tracker split of a full B-tree node
+  btree_merge,           ///< index_tracker rotation or merge of a node
+  decimate_neighborhood, ///< Timed, gathering the complete neighborhood
+  decimate_map,          ///< Timed, mapping the neighborhood onto the vertex
+  decimate_callback,     ///< Timed, running the user callback
+  decimate_removal,      ///< Timed, removing the doomed simplices
+  decimate_insertion     ///< Timed, inserting the new simplices
+};
+
+/// Number of instrumented events.
+constexpr std::size_t num_events = 13;
+
+/// Accumulated statistics of an event.
+struct event_stats {
+  std::uint64_t count = 0;       ///< Number of occurrences
+  std::uint64_t total = 0;       ///< Sum of the values
+  std::uint64_t max = 0;         ///< Largest value
+  std::uint64_t nanoseconds = 0; ///< Time spent in timed events
+
+  /// Mean value per occurrence.
+  double mean() const {
+    return count ? static_cast<double>(total) / count : 0.0;
+  }
+};
+
+/**
+ * @brief      Callback receiving every finished timed event.
+ *
+ * Called as fn(ev, value, nanoseconds, user) on the thread which ran the
+ * event, possibly from several threads at once.
+ */
+using span_callback = void (*)(event, std::uint64_t, std::uint64_t, void *);
+
+/// @cond detail
+namespace stats_detail {
+/**
+ * @brief      Accumulator of an event written by a single thread.
+ *
+ * The fields are atomic only so that other threads may read them. The
+ * owning thread updates them with plain loads and stores, avoiding locked
+ * read-modify-write instructions.
+ */
+struct counter {
+  std::atomic<std::uint64_t> count{0};
+  std::atomic<std::uint64_t> total{0};
+  std::atomic<std::uint64_t> max{0};
+  std::atomic<std::uint64_t> nanoseconds{0};
+};
+
+/// Add to a counter field owned by the calling thread.
+inline void bump(std::atomic<std::uint64_t> &field, std::uint64_t value) {
+  field.store(field.load(std::memory_order_relaxed) + value,
+              std::memory_order_relaxed);
+}
+
+/// Fold a counter into accumulated statistics.
+inline void accumulate(event_stats &e, const counter &c) {
+  e.count += c.count.load(std::memory_order_relaxed);
+  e.total += c.total.load(std::memory_order_relaxed);
+  e.max = std::max<std::uint64_t>(e.max, c.max.load(std::memory_order_relaxed));
+  e.nanoseconds += c.nanoseconds.load(std::memory_order_relaxed);
+}
+
+/// Zero a counter.
+inline void clear(counter &c) {
+  c.count.store(0, std::memory_order_relaxed);
+  c.total.store(0, std::memory_order_relaxed);
+  c.max.store(0, std::memory_order_relaxed);
+  c.nanoseconds.store(0, std::memory_order_relaxed);
+}
+
+struct thread_counters;
+
+/// Counters of the running threads and the totals of exited ones.
+struct counter_registry {
+  std::mutex mutex;
+  std::vector<thread_counters *> threads;
+  std::array<event_stats, num_events> retired;
+};
+
+inline counter_registry &registry() {
+  static counter_registry r;
+  return r;
+}
+
+/**
+ * @brief      Accumulators of all events of one thread.
+ *
+ * Registered while the thread runs and folded into the retired totals when
+ * it exits. Aligned to a cache line so that threads never share one.
+ */
+struct alignas(64) thread_counters {
+  std::array<counter, num_events> events;
+
+  thread_counters() {
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.threads.push_back(this);
+  }
+
+  ~thread_counters() {
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (std::size_t i = 0; i < num_events; ++i) {
+      accumulate(r.retired[i], events[i]);
+    }
+    r.threads.erase(std::find(r.threads.begin(), r.threads.end(), this));
+  }
+
+  thread_counters(const thread_counters &) = delete;
+  thread_counters &operator=(const thread_counters &) = delete;
+};
+
+/// Accumulators of the calling thread.
+inline std::array<counter, num_events> &counters() {
+  static thread_local thread_counters c;
+  return c.events;
+}
+
+/// Installed span callback and its user data.
+struct hook {
+  std::atomic<span_callback> fn{nullptr};
+  std::atomic<void *> user{nullptr};
+};
+
+inline hook &span_hook() {
+  static hook h;
+  return h;
+}
+} // end namespace stats_detail
+/// @endcond
+
+/**
+ * @brief      Whether the library records events.
+ *
+ * @return     True if built with CASC_ENABLE_STATS.
+ */
+constexpr bool enabled() {
+#ifdef CASC_ENABLE_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief      Get the name of an event.
+ *
+ * @param[in]  ev    The event.
+ *
+ * @return     Null terminated name.
+ */
+inline const char *name(event ev) {
+  static const char *const names[num_events] = {
+      "create_node",       "remove_node",      "insert",
+      "get_recurse",       "bfs_up",           "bfs_down",
+      "btree_split",       "btree_merge",      "decimate_neighborhood",
+      "decimate_map",      "decimate_callback", "decimate_removal",
+      "decimate_insertion"};
+  return names[static_cast<std::size_t>(ev)];
+}
+
+/**
+ * @brief      Accumulate an occurrence of an event.
+ *
+ * Safe to call from several threads at once. Each thread accumulates into
+ * its own counters, so recording does not contend between threads.
+ *
+ * @param[in]  ev           The event.
+ * @param[in]  value        Event specific value.
+ * @param[in]  nanoseconds  Time spent.
+ */
+inline void record(event ev, std::uint64_t value,
+                   std::uint64_t nanoseconds = 0) {
+  auto &c = stats_detail::counters()[static_cast<std::size_t>(ev)];
+  stats_detail::bump(c.count, 1);
+  stats_detail::bump(c.total, value);
+  stats_detail::bump(c.nanoseconds, nanoseconds);
+  if (value > c.max.load(std::memory_order_relaxed)) {
+    c.max.store(value, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief      Install a callback receiving every finished timed event.
+ *
+ * Should not be called while other threads are running casc operations.
+ *
+ * @param[in]  fn    The callback or nullptr to remove it.
+ * @param      user  Pointer passed through to the callback.
+ */
+inline void set_span_callback(span_callback fn, void *user = nullptr) {
+  auto &h = stats_detail::span_hook();
+  h.user.store(user, std::memory_order_relaxed);
+  h.fn.store(fn, std::memory_order_release);
+}
+
+/// Statistics of all events at one point in time.
+struct summary {
+  /// Statistics indexed by event
+  std::array<event_stats, num_events> events;
+
+  /// Get the statistics of an event.
+  const event_stats &operator[](event ev) const {
+    return events[static_cast<std::size_t>(ev)];
+  }
+
+  /**
+   * @brief      Print the non zero events as a table.
+   *
+   * @param      output  The output stream
+   * @param[in]  s       The statistics
+   *
+   * @return     The output stream
+   */
+  friend std::ostream &operator<<(std::ostream &output, const summary &s) {
+    output << std::left << std::setw(22) << "event" << std::right
+           << std::setw(12) << "count" << std::setw(12) << "mean"
+           << std::setw(12) << "max" << std::setw(14) << "ms";
+    for (std::size_t i = 0; i < num_events; ++i) {
+      const auto &e = s.events[i];
+      if (e.count == 0) {
+        continue;
+      }
+      output << "\n"
+             << std::left << std::setw(22) << name(static_cast<event>(i))
+             << std::right << std::setw(12) << e.count << std::setw(12)
+             << std::fixed << std::setprecision(2) << e.mean()
+             << std::setw(12) << e.max << std::setw(14)
+             << std::setprecision(3) << e.nanoseconds * 1e-6;
+    }
+    return output;
+  }
+};
+
+/**
+ * @brief      Read all counters.
+ *
+ * Sums the counters of all running threads and of the threads which have
+ * exited. Events recorded concurrently may or may not be included.
+ *
+ * @return     The accumulated statistics since the last reset().
+ */
+inline summary snapshot() {
+  summary s;
+  auto &r = stats_detail::registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  s.events = r.retired;
+  for (const auto *t : r.threads) {
+    for (std::size_t i = 0; i < num_events; ++i) {
+      stats_detail::accumulate(s.events[i], t->events[i]);
+    }
+  }
+  return s;
+}
+
+/**
+ * @brief      Set all counters to zero.
+ *
+ * Should not be called while other threads record events, whose updates
+ * could otherwise survive the reset.
+ */
+inline void reset() {
+  auto &r = stats_detail::registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.retired = std::array<event_stats, num_events>();
+  for (auto *t : r.threads) {
+    for (auto &c : t->events) {
+      stats_detail::clear(c);
+    }
+  }
+}
+
+/**
+ * @brief      Time the enclosing scope as an event.
+ *
+ * On destruction the event is recorded and passed to the span callback.
+ */
+class scoped_span {
+  using clock = std::chrono::steady_clock;
+
+public:
+  /**
+   * @brief      Start timing an event.
+   *
+   * @param[in]  ev     The event.
+   * @param[in]  value  Event specific value.
+   */
+  explicit scoped_span(event ev, std::uint64_t value = 0)
+      : _ev(ev), _value(value), _start(clock::now()) {}
+
+  scoped_span(const scoped_span &) = delete;
+  scoped_span &operator=(const scoped_span &) = delete;
+
+  /// Record the event and call the span callback.
+  ~scoped_span() {
+    const std::uint64_t ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                             _start)
+            .count();
+    record(_ev, _value, ns);
+    auto &h = stats_detail::span_hook();
+    if (auto fn = h.fn.load(std::memory_order_acquire)) {
+      fn(_ev, _value, ns, h.user.load(std::memory_order_relaxed));
+    }
+  }
+
+private:
+  event _ev;
+  std::uint64_t _value;
+  clock::time_point _start;
+};
+} // end namespace stats
+} // end namespace casc
+
+/// @cond detail
+#define CASC_STATS_CONCAT_(a, b) a##b
+#define CASC_STATS_CONCAT(a, b) CASC_STATS_CONCAT_(a, b)
+/// @endcond
+
+#ifdef CASC_ENABLE_STATS
+/// Record an occurrence of casc::stats::event::ev with the given value.
+#define CASC_STATS_RECORD(ev, value)                                           \
+  ::casc::stats::record(::casc::stats::event::ev, (value))
+/// Time the rest of the enclosing scope as casc::stats::event::ev.
+#define CASC_STATS_SPAN(ev, value)                                             \
+  ::casc::stats::scoped_span CASC_STATS_CONCAT(casc_stats_span_, __LINE__)(    \
+      ::casc::stats::event::ev, (value))
+#else
+#define CASC_STATS_RECORD(ev, value) static_cast<void>(0)
+#define CASC_STATS_SPAN(ev, value) static_cast<void>(0)
+#endif
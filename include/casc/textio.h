@@ -0,0 +1,880 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  textio.h
+ * @brief Buffered tokenizer and writer for large text mesh files.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef CASC_ENABLE_PARALLEL
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#include "parallel.h"
+
+namespace casc {
+namespace textio {
+/// @cond detail
+namespace textio_detail {
+/// Exact powers of ten representable by a double.
+inline const double *pow10_table() {
+  static const double table[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                 1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                 1e18, 1e19, 1e20, 1e21, 1e22};
+  return table;
+}
+
+inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// Pairs of decimal digits "00" to "99".
+inline const char *digit_pairs() {
+  static const char table[] =
+      "00010203040506070809101112131415161718192021222324"
+      "25262728293031323334353637383940414243444546474849"
+      "50515253545556575859606162636465666768697071727374"
+      "75767778798081828384858687888990919293949596979899";
+  return table;
+}
+
+/// Write the digits of v so that they end at end and return the first one.
+inline char *format_digits(char *end, std::uint64_t v) {
+  const char *pairs = digit_pairs();
+  while (v >= 100) {
+    const std::size_t i = static_cast<std::size_t>(v % 100) * 2;
+    v /= 100;
+    end -= 2;
+    end[0] = pairs[i];
+    end[1] = pairs[i + 1];
+  }
+  if (v >= 10) {
+    const std::size_t i = static_cast<std::size_t>(v) * 2;
+    end -= 2;
+    end[0] = pairs[i];
+    end[1] = pairs[i + 1];
+  } else {
+    *--end = static_cast<char>('0' + v);
+  }
+  return end;
+}
+
+/// Write an unsigned integer at out and return the end.
+template <typename Int>
+char *format_integer(char *out, Int v, std::false_type) {
+  char tmp[20];
+  char *first = format_digits(tmp + 20, static_cast<std::uint64_t>(v));
+  const std::size_t n = static_cast<std::size_t>(tmp + 20 - first);
+  std::memcpy(out, first, n);
+  return out + n;
+}
+
+/// Write a signed integer at out and return the end.
+template <typename Int> char *format_integer(char *out, Int v, std::true_type) {
+  std::uint64_t u = static_cast<std::uint64_t>(v);
+  if (v < 0) {
+    *out++ = '-';
+    u = 0 - u;
+  }
+  return format_integer(out, u, std::false_type());
+}
+
+/// Write a double with up to precision significant digits like "%.*g".
+inline char *format_real(char *out, std::size_t cap, double v,
+                         int precision) {
+  // Integral values below 10^precision print as integers with %g
+  const double a = std::fabs(v);
+  if (a < 1e15 && a < pow10_table()[precision] && v == std::floor(v) &&
+      !(v == 0 && std::signbit(v))) {
+    return format_integer(out, static_cast<std::int64_t>(v),
+                          std::true_type());
+  }
+  const int n = std::snprintf(out, cap, "%.*g", precision, v);
+  return out + std::max(n, 0);
+}
+} // end namespace textio_detail
+/// @endcond
+
+/**
+ * @brief      Chunked reader which tokenizes numbers directly out of a
+ *             fixed-size buffer.
+ *
+ * The stream is consumed in large blocks and numbers are parsed in place
+ * without constructing intermediate strings, so the cost per token does not
+ * depend on the line structure of the file. Whitespace skipping treats text
+ * from the comment character to the end of the line as whitespace.
+ *
+ * Example -- sum all numbers in a file:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * std::ifstream fin("numbers.txt", std::ios::binary);
+ * casc::textio::buffered_reader reader(fin);
+ * double x, sum = 0;
+ * while (reader.read_real(x)) {
+ *   sum += x;
+ * }
+ * ~~~~~~~~~~~~~~~
+ */
+class buffered_reader {
+public:
+  /// Default number of bytes read from the stream at once.
+  static constexpr std::size_t default_buffer_size = 1 << 20;
+  /// Longest token which is guaranteed to be parsed.
+  static constexpr std::size_t max_token = 128;
+
+  /**
+   * @brief      Construct a reader on top of a stream.
+   *
+   * @param      in           Stream to read from. It should be opened in
+   *                          binary mode for best performance.
+   * @param[in]  buffer_size  Size of the internal buffer in bytes.
+   * @param[in]  comment      Character starting a comment, or '\0' to
+   *                          disable comment handling.
+   */
+  explicit buffered_reader(std::istream &in,
+                           std::size_t buffer_size = default_buffer_size,
+                           char comment = '#')
+      : _in(in), _buf(std::max(buffer_size, 2 * max_token)), _cur(0),
+        _end(0), _offset(0), _eof(false), _comment(comment) {}
+
+  /**
+   * @brief      Look at the next character without consuming it.
+   *
+   * @return     The character, or -1 at the end of the stream.
+   */
+  int peek() {
+    ensure(1);
+    return _cur < _end ? static_cast<unsigned char>(_buf[_cur]) : -1;
+  }
+
+  /**
+   * @brief      Consume the next character.
+   *
+   * @return     The character, or -1 at the end of the stream.
+   */
+  int get() {
+    int c = peek();
+    if (c != -1) {
+      ++_cur;
+    }
+    return c;
+  }
+
+  /**
+   * @brief      Check whether all input has been consumed.
+   */
+  bool eof() { return peek() == -1; }
+
+  /**
+   * @brief      Skip blanks on the current line.
+   */
+  void skip_space() {
+    while (true) {
+      while (_cur < _end && textio_detail::is_space(_buf[_cur])) {
+        ++_cur;
+      }
+      if (_cur < _end || !fill()) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief      Skip blanks, line breaks and comments.
+   */
+  void skip_whitespace() {
+    while (true) {
+      skip_space();
+      int c = peek();
+      if (c == '\n') {
+        ++_cur;
+      } else if (c != -1 && _comment != '\0' && c == _comment) {
+        skip_line();
+      } else {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief      Consume the rest of the current line including the line
+   *             break.
+   */
+  void skip_line() {
+    while (true) {
+      const char *first = _buf.data() + _cur;
+      const void *nl = std::memchr(first, '\n', _end - _cur);
+      if (nl != nullptr) {
+        _cur += static_cast<const char *>(nl) - first + 1;
+        return;
+      }
+      _cur = _end;
+      if (!fill()) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief      Consume the rest of the current token.
+   */
+  void skip_token() {
+    int c;
+    while ((c = peek()) != -1 && c != '\n' &&
+           !textio_detail::is_space(static_cast<char>(c))) {
+      ++_cur;
+    }
+  }
+
+  /**
+   * @brief      Check whether the current line has no further tokens.
+   *
+   * Blanks are skipped. A line break, a comment or the end of the stream
+   * count as the end of the line; none of them are consumed.
+   */
+  bool at_eol() {
+    skip_space();
+    int c = peek();
+    return c == -1 || c == '\n' || (_comment != '\0' && c == _comment);
+  }
+
+  /**
+   * @brief      Read a whitespace delimited word.
+   *
+   * @param[out] out   Buffer receiving the NUL terminated word. Words longer
+   *                   than the buffer are truncated.
+   * @param[in]  cap   Size of the buffer, must be at least 1.
+   *
+   * @return     Length of the word, zero at the end of the stream.
+   */
+  std::size_t read_word(char *out, std::size_t cap) {
+    skip_whitespace();
+    std::size_t len = 0;
+    int c;
+    while ((c = peek()) != -1 && c != '\n' &&
+           !textio_detail::is_space(static_cast<char>(c))) {
+      if (len + 1 < cap) {
+        out[len++] = static_cast<char>(c);
+      }
+      ++_cur;
+    }
+    out[len] = '\0';
+    return len;
+  }
+
+  /**
+   * @brief      Read an integer.
+   *
+   * Leading whitespace and comments are skipped. Parsing stops at the first
+   * character which is not a digit, so `12/7` yields 12 and leaves `/7`.
+   *
+   * @param[out] v     The value read.
+   *
+   * @tparam     Int   Integral type of the value.
+   *
+   * @return     False if no integer could be read or the value overflows.
+   */
+  template <typename Int, typename = typename std::enable_if<
+                              std::is_integral<Int>::value>::type>
+  bool read_integer(Int &v) {
+    skip_whitespace();
+    ensure(max_token);
+    const char *p = _buf.data() + _cur;
+    const char *end = _buf.data() + _end;
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      neg = *p == '-';
+      ++p;
+    }
+    if (neg && !std::is_signed<Int>::value) {
+      return false;
+    }
+    const char *digits = p;
+    std::uint64_t value = 0;
+    const std::uint64_t limit =
+        neg ? std::uint64_t(std::numeric_limits<Int>::max()) + 1
+            : std::uint64_t(std::numeric_limits<Int>::max());
+    while (p < end && textio_detail::is_digit(*p)) {
+      const std::uint64_t d = *p - '0';
+      if (value > (limit - d) / 10) {
+        return false;
+      }
+      value = value * 10 + d;
+      ++p;
+    }
+    if (p == digits) {
+      return false;
+    }
+    _cur = p - _buf.data();
+    v = neg ? static_cast<Int>(0 - value) : static_cast<Int>(value);
+    return true;
+  }
+
+  /**
+   * @brief      Read a floating point number.
+   *
+   * Leading whitespace and comments are skipped. Decimal numbers with up to
+   * 19 significant digits and small exponents are converted exactly without
+   * leaving the buffer, anything else falls back to std::strtod.
+   *
+   * @param[out] v     The value read.
+   *
+   * @return     False if no number could be read.
+   */
+  bool read_real(double &v) {
+    skip_whitespace();
+    ensure(max_token);
+    const char *first = _buf.data() + _cur;
+    const char *end = _buf.data() + _end;
+    const char *p = first;
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      neg = *p == '-';
+      ++p;
+    }
+    std::uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool digits = false;
+    bool exact = true;
+    auto digit = [&](char c, bool fraction) {
+      digits = true;
+      if (mantissa == 0 && c == '0') {
+        exponent -= fraction;
+        return;
+      }
+      if (significant < 19) {
+        mantissa = mantissa * 10 + (c - '0');
+        ++significant;
+        exponent -= fraction;
+      } else {
+        exact = false;
+        exponent += !fraction;
+      }
+    };
+    while (p < end && textio_detail::is_digit(*p)) {
+      digit(*p++, false);
+    }
+    if (p < end && *p == '.') {
+      ++p;
+      while (p < end && textio_detail::is_digit(*p)) {
+        digit(*p++, true);
+      }
+    }
+    if (!digits) {
+      return fallback(first, v);
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+      const char *q = p + 1;
+      bool eneg = false;
+      if (q < end && (*q == '-' || *q == '+')) {
+        eneg = *q == '-';
+        ++q;
+      }
+      if (q < end && textio_detail::is_digit(*q)) {
+        int e = 0;
+        while (q < end && textio_detail::is_digit(*q)) {
+          e = std::min(e * 10 + (*q++ - '0'), 100000);
+        }
+        exponent += eneg ? -e : e;
+        p = q;
+      }
+    }
+    if (!exact || mantissa > (std::uint64_t(1) << 53) || exponent < -22 ||
+        exponent > 22) {
+      return fallback(first, v);
+    }
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0) {
+      value /= textio_detail::pow10_table()[-exponent];
+    } else {
+      value *= textio_detail::pow10_table()[exponent];
+    }
+    v = neg ? -value : value;
+    _cur = p - _buf.data();
+    return true;
+  }
+
+  /**
+   * @brief      Number of bytes consumed from the stream so far.
+   */
+  std::size_t bytes_read() const { return _offset + _cur; }
+
+private:
+  /// Refill the buffer, keeping unconsumed bytes. Returns false at the end.
+  bool fill() {
+    if (_eof) {
+      return false;
+    }
+    if (_cur > 0) {
+      std::memmove(_buf.data(), _buf.data() + _cur, _end - _cur);
+      _offset += _cur;
+      _end -= _cur;
+      _cur = 0;
+    }
+    if (_end == _buf.size()) {
+      return true;
+    }
+    _in.read(_buf.data() + _end, _buf.size() - _end);
+    const std::size_t n = static_cast<std::size_t>(_in.gcount());
+    _end += n;
+    if (n == 0) {
+      _eof = true;
+    }
+    return n > 0;
+  }
+
+  /// Make at least n bytes available unless the stream ends first.
+  void ensure(std::size_t n) {
+    while (_end - _cur < n && fill()) {
+    }
+  }
+
+  /// Convert the token at first with std::strtod.
+  bool fallback(const char *first, double &v) {
+    char token[max_token + 1];
+    const char *end = _buf.data() + _end;
+    std::size_t len = 0;
+    while (first + len < end && len < max_token && first[len] != '\n' &&
+           !textio_detail::is_space(first[len])) {
+      token[len] = first[len];
+      ++len;
+    }
+    token[len] = '\0';
+    char *stop;
+    v = std::strtod(token, &stop);
+    if (stop == token) {
+      return false;
+    }
+    _cur += stop - token;
+    return true;
+  }
+
+  std::istream &_in;
+  std::vector<char> _buf;
+  std::size_t _cur;
+  std::size_t _end;
+  std::size_t _offset;
+  bool _eof;
+  char _comment;
+};
+
+/**
+ * @brief      Number formatting shared by the text writers.
+ *
+ * Integers are converted with a table of digit pairs and doubles are
+ * printed like `"%.*g"`, i.e., like an ostream in the default float format,
+ * without going through the locale machinery of iostreams.
+ *
+ * @tparam     Derived  The writer, which provides room(n) returning space
+ *                      for at least n <= max_token characters, advance(end)
+ *                      to commit the characters up to end and
+ *                      write_bytes(s, n).
+ */
+template <typename Derived> class basic_formatter {
+public:
+  /// Longest number which may be formatted.
+  static constexpr std::size_t max_token = 64;
+
+  /// Write a character.
+  Derived &put(char c) {
+    char *p = self().room(1);
+    *p = c;
+    self().advance(p + 1);
+    return self();
+  }
+
+  /// Write n characters.
+  Derived &write(const char *s, std::size_t n) {
+    self().write_bytes(s, n);
+    return self();
+  }
+
+  /// Write a null terminated string.
+  Derived &write(const char *s) { return write(s, std::strlen(s)); }
+
+  /// Write a string.
+  Derived &write(const std::string &s) { return write(s.data(), s.size()); }
+
+  /**
+   * @brief      Write an integer in decimal.
+   *
+   * @param[in]  v     The value.
+   *
+   * @tparam     Int   Integral typename.
+   *
+   * @return     The writer.
+   */
+  template <typename Int> Derived &write_integer(Int v) {
+    static_assert(std::is_integral<Int>::value,
+                  "write_integer requires an integral type");
+    char *p = self().room(max_token);
+    self().advance(textio_detail::format_integer(
+        p, v, std::integral_constant<bool, std::is_signed<Int>::value>()));
+    return self();
+  }
+
+  /**
+   * @brief      Write a double with precision() significant digits.
+   *
+   * @param[in]  v     The value.
+   *
+   * @return     The writer.
+   */
+  Derived &write_real(double v) {
+    char *p = self().room(max_token);
+    self().advance(textio_detail::format_real(p, max_token, v, _precision));
+    return self();
+  }
+
+  /**
+   * @brief      Set the number of significant digits of write_real().
+   *
+   * @param[in]  precision  Digits between 1 and 17, the default is 10.
+   */
+  void set_precision(int precision) {
+    _precision = std::min(std::max(precision, 1), 17);
+  }
+
+  /// Number of significant digits of write_real().
+  int precision() const { return _precision; }
+
+private:
+  Derived &self() { return static_cast<Derived &>(*this); }
+
+  int _precision = 10;
+};
+
+/**
+ * @brief      Growable in-memory text buffer.
+ *
+ * Used to format parts of a file independently, such as the chunks of
+ * write_parallel().
+ */
+class text_buffer : public basic_formatter<text_buffer> {
+public:
+  /// Pointer to the text.
+  const char *data() const { return _buf.data(); }
+  /// Number of characters written.
+  std::size_t size() const { return _size; }
+  /// Discard the text, keeping the storage.
+  void clear() { _size = 0; }
+  /// The text as a string.
+  std::string str() const { return std::string(_buf.data(), _size); }
+
+  /// @cond detail
+  char *room(std::size_t n) {
+    if (_size + n > _buf.size()) {
+      _buf.resize(std::max(2 * _buf.size(), _size + n));
+    }
+    return _buf.data() + _size;
+  }
+
+  void advance(const char *end) {
+    _size = static_cast<std::size_t>(end - _buf.data());
+  }
+
+  void write_bytes(const char *s, std::size_t n) {
+    if (n > 0) {
+      std::memcpy(room(n), s, n);
+      _size += n;
+    }
+  }
+  /// @endcond
+
+private:
+  std::vector<char> _buf;
+  std::size_t _size = 0;
+};
+
+/**
+ * @brief      Writer which formats numbers directly into a large buffer.
+ *
+ * The buffer is handed to the stream only when it is full, so the cost per
+ * token does not depend on the stream. With `background` set, full buffers
+ * are written out by a second thread while the next one is filled. The
+ * background thread is only started when the library is built with
+ * `CASC_ENABLE_PARALLEL`, otherwise the flag is ignored.
+ *
+ * Example -- write one number per line:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * std::ofstream fout("numbers.txt", std::ios::binary);
+ * casc::textio::buffered_writer writer(fout);
+ * for (int i = 0; i < 100; ++i) {
+ *   writer.write_integer(i).put(' ').write_real(i * 0.5).put('\n');
+ * }
+ * writer.flush();
+ * ~~~~~~~~~~~~~~~
+ */
+class buffered_writer : public basic_formatter<buffered_writer> {
+public:
+  /// Default number of bytes written to the stream at once.
+  static constexpr std::size_t default_buffer_size = 1 << 20;
+
+  /**
+   * @brief      Construct a writer on top of a stream.
+   *
+   * @param      out          Stream to write to. It should be opened in
+   *                          binary mode for best performance.
+   * @param[in]  buffer_size  Size of the internal buffer in bytes.
+   * @param[in]  background   Write full buffers on a second thread.
+   */
+  explicit buffered_writer(std::ostream &out,
+                           std::size_t buffer_size = default_buffer_size,
+                           bool background = false)
+      : _out(out), _buf(std::max(buffer_size, 2 * max_token)), _cur(0),
+        _offset(0), _failed(false) {
+#ifdef CASC_ENABLE_PARALLEL
+    if (background) {
+      _back.resize(_buf.size());
+      _thread = std::thread(&buffered_writer::run, this);
+    }
+#else
+    static_cast<void>(background);
+#endif
+  }
+
+  buffered_writer(const buffered_writer &) = delete;
+  buffered_writer &operator=(const buffered_writer &) = delete;
+
+  /// Flush the remaining text. Errors are ignored, call flush() to check.
+  ~buffered_writer() {
+    try {
+      flush();
+    } catch (...) {
+    }
+#ifdef CASC_ENABLE_PARALLEL
+    if (_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+      }
+      _cv.notify_all();
+      _thread.join();
+    }
+#endif
+  }
+
+  /**
+   * @brief      Write all buffered text to the stream and flush it.
+   *
+   * @return     False if any write to the stream failed.
+   */
+  bool flush() {
+    hand_off();
+    wait_idle();
+    _out.flush();
+    if (!_out) {
+      _failed = true;
+    }
+    return !_failed;
+  }
+
+  /// False if any write to the stream failed so far.
+  bool good() const { return !_failed; }
+
+  /// Number of bytes written including those still buffered.
+  std::size_t bytes_written() const { return _offset + _cur; }
+
+  /// @cond detail
+  char *room(std::size_t n) {
+    if (_cur + n > _buf.size()) {
+      hand_off();
+    }
+    return _buf.data() + _cur;
+  }
+
+  void advance(const char *end) {
+    _cur = static_cast<std::size_t>(end - _buf.data());
+  }
+
+  void write_bytes(const char *s, std::size_t n) {
+    if (_cur + n > _buf.size()) {
+      hand_off();
+      if (n >= _buf.size()) {
+        // Large blocks bypass the buffer
+        wait_idle();
+        _out.write(s, static_cast<std::streamsize>(n));
+        _offset += n;
+        if (!_out) {
+          _failed = true;
+        }
+        return;
+      }
+    }
+    std::memcpy(_buf.data() + _cur, s, n);
+    _cur += n;
+  }
+  /// @endcond
+
+private:
+  /// Pass the buffered text to the stream or the background thread.
+  void hand_off() {
+    if (_cur == 0) {
+      return;
+    }
+    _offset += _cur;
+#ifdef CASC_ENABLE_PARALLEL
+    if (_thread.joinable()) {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this] { return !_pending; });
+      _buf.swap(_back);
+      _back_size = _cur;
+      _pending = true;
+      _cur = 0;
+      lock.unlock();
+      _cv.notify_all();
+      return;
+    }
+#endif
+    _out.write(_buf.data(), static_cast<std::streamsize>(_cur));
+    _cur = 0;
+    if (!_out) {
+      _failed = true;
+    }
+  }
+
+  /// Wait until the background thread has written its buffer.
+  void wait_idle() {
+#ifdef CASC_ENABLE_PARALLEL
+    if (_thread.joinable()) {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this] { return !_pending; });
+    }
+#endif
+  }
+
+#ifdef CASC_ENABLE_PARALLEL
+  /// Body of the background thread.
+  void run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+      _cv.wait(lock, [this] { return _pending || _stop; });
+      if (!_pending) {
+        return;
+      }
+      lock.unlock();
+      _out.write(_back.data(), static_cast<std::streamsize>(_back_size));
+      if (!_out) {
+        _failed = true;
+      }
+      lock.lock();
+      _pending = false;
+      _cv.notify_all();
+    }
+  }
+#endif
+
+  std::ostream &_out;
+  std::vector<char> _buf;
+  std::size_t _cur;
+  std::size_t _offset;
+  std::atomic<bool> _failed;
+#ifdef CASC_ENABLE_PARALLEL
+  std::vector<char> _back;
+  std::size_t _back_size = 0;
+  bool _pending = false;
+  bool _stop = false;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::thread _thread;
+#endif
+};
+
+/**
+ * @brief      Format n items in parallel chunks and write them in order.
+ *
+ * Items are formatted in rounds of `grain` items per thread into separate
+ * text_buffer objects which are then appended to `out` in order, so the
+ * output is identical to formatting the items one after another. With a
+ * single thread the items are formatted directly into `out`.
+ *
+ * Example -- write the vertices of a mesh:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * auto vertices = mesh.get_level<1>();
+ * casc::textio::write_parallel(writer, mesh.size<1>(), 1 << 14,
+ *     [&](auto &w, std::size_t i) {
+ *       const auto &v = vertices.begin()[i];
+ *       w.write_real(v[0]).put(' ').write_real(v[1]).put('\n');
+ *     });
+ * ~~~~~~~~~~~~~~~
+ *
+ * @param      out     The writer.
+ * @param[in]  n       Number of items.
+ * @param[in]  grain   Number of items formatted by a thread at once.
+ * @param[in]  fn      Functor called as fn(w, i) to format item i into w,
+ *                     which is either `out` or a text_buffer with the same
+ *                     precision. Use a generic lambda.
+ *
+ * @tparam     Writer  Typename of the writer.
+ * @tparam     Fn      Typename of the functor.
+ */
+template <typename Writer, typename Fn>
+void write_parallel(Writer &out, std::size_t n, std::size_t grain, Fn &&fn) {
+  grain = std::max<std::size_t>(grain, 1);
+  const std::size_t threads = parallel::num_threads();
+  if (threads <= 1 || n <= grain) {
+    for (std::size_t i = 0; i < n; ++i) {
+      fn(out, i);
+    }
+    return;
+  }
+  std::vector<text_buffer> buffers(threads);
+  for (auto &buffer : buffers) {
+    buffer.set_precision(out.precision());
+  }
+  const std::size_t round = threads * grain;
+  for (std::size_t first = 0; first < n; first += round) {
+    const std::size_t count = std::min(round, n - first);
+    const std::size_t chunks = parallel::for_chunks(
+        count, grain, [&](std::size_t c, std::size_t begin, std::size_t end) {
+          buffers[c].clear();
+          for (std::size_t i = begin; i < end; ++i) {
+            fn(buffers[c], first + i);
+          }
+        });
+    for (std::size_t c = 0; c < chunks; ++c) {
+      out.write(buffers[c].data(), buffers[c].size());
+    }
+  }
+}
+
+} // end namespace textio
+} // end namespace casc
@@ -23,11 +23,31 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <utility>
+#include <vector>
 
 /// Metatemplate programming utilities namespace
 namespace util {
+/// @cond detail
+namespace detail {
+/// Helper for void_t which works around CWG 1558.
+template <typename... Ts> struct make_void { using type = void; };
+} // end namespace detail
+/// @endcond
+
+/**
+ * @brief      Map any sequence of types to void.
+ *
+ * Backport of C++17 `std::void_t` for use in SFINAE based detection of
+ * optional members of traits structs.
+ *
+ * @tparam     Ts    Types to check for well-formedness.
+ */
+template <typename... Ts> using void_t = typename detail::make_void<Ts...>::type;
+
 /**
  * @brief      A range object to support range based for loops.
  *
@@ -62,14 +82,14 @@ template <typename T> struct range {
    *
    * @return     Returns an iterator to the beginning.
    */
-  T begin() { return _begin; }
+  T begin() const { return _begin; }
 
   /**
    * @brief      Get the end iterator.
    *
    * @return     Returns an iterator to the end.
    */
-  T end() { return _end; }
+  T end() const { return _end; }
 
 private:
   /// Iterator to the beginning.
@@ -105,6 +125,114 @@ template <typename T> range<T> make_range(std::pair<T, T> p) {
   return range<T>(std::move(p.first), std::move(p.second));
 }
 
+/**
+ * @brief      Sorted set of unique values which stays on the stack while it
+ *             is small.
+ *
+ * Up to N values are stored inline in a sorted array. Larger sets move to a
+ * heap allocated vector which is kept by clear(). This is meant for
+ * accumulating the handful of simplices adjacent to one or a few simplices
+ * where a std::set would allocate a node per element. Insertion is linear in
+ * the size of the set.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * util::small_set<Mesh::SimplexID<2>> edges;
+ * for (auto v : vertices)
+ *   mesh.up(v, std::inserter(edges, edges.end()));
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     T     Typename of the values, must be default constructible
+ *                   and less than comparable.
+ * @tparam     N     Number of values stored inline.
+ */
+template <typename T, std::size_t N = 16> class small_set {
+public:
+  /// Typename of the values
+  using value_type = T;
+  /// Values are immutable through iterators to keep the set sorted
+  using iterator = const T *;
+  /// Const iterator
+  using const_iterator = const T *;
+  /// Typename of the size
+  using size_type = std::size_t;
+
+  /// Construct an empty set.
+  small_set() : _size(0), _spilled(false) {}
+
+  /**
+   * @brief      Insert a value.
+   *
+   * @param[in]  value  The value to insert.
+   *
+   * @return     Iterator to the value and whether it was inserted.
+   */
+  std::pair<iterator, bool> insert(const T &value) {
+    T *first = data();
+    T *last = first + _size;
+    T *pos = std::lower_bound(first, last, value);
+    if (pos != last && !(value < *pos)) {
+      return std::make_pair(pos, false);
+    }
+    const std::size_t idx = pos - first;
+    if (!_spilled) {
+      if (_size < N) {
+        std::move_backward(pos, last, last + 1);
+        *pos = value;
+        ++_size;
+        return std::make_pair(pos, true);
+      }
+      _heap.reserve(2 * N);
+      _heap.assign(first, last);
+      _spilled = true;
+    }
+    _heap.insert(_heap.begin() + idx, value);
+    ++_size;
+    return std::make_pair(_heap.data() + idx, true);
+  }
+
+  /**
+   * @brief      Insert a value ignoring the hint. Allows std::inserter.
+   *
+   * @param[in]  value  The value to insert.
+   *
+   * @return     Iterator to the value.
+   */
+  iterator insert(const_iterator, const T &value) {
+    return insert(value).first;
+  }
+
+  /// Check whether a value is in the set.
+  std::size_t count(const T &value) const {
+    return std::binary_search(begin(), end(), value);
+  }
+
+  /// Remove all values keeping any heap storage.
+  void clear() {
+    _size = 0;
+    _heap.clear();
+  }
+
+  /// Number of values.
+  std::size_t size() const { return _size; }
+  /// Check whether the set is empty.
+  bool empty() const { return _size == 0; }
+
+  /// Iterator to the smallest value.
+  const_iterator begin() const { return data(); }
+  /// Iterator past the largest value.
+  const_iterator end() const { return data() + _size; }
+
+private:
+  T *data() { return _spilled ? _heap.data() : _inline.data(); }
+  const T *data() const { return _spilled ? _heap.data() : _inline.data(); }
+
+  std::array<T, N> _inline;
+  std::vector<T> _heap;
+  std::size_t _size;
+  bool _spilled;
+};
+
 /**
  * @brief      Queue based data structure to hold list of types.
  *
@@ -0,0 +1,324 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+/**
+ * @file  visited_set.h
+ * @brief Generation stamped visited sets for traversals.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "node_pool.h"
+
+namespace casc {
+/// @cond detail
+namespace visited_detail {
+/**
+ * @brief      Stamp storage shared by consecutive visited_sets of a thread.
+ *
+ * Small sets live in an open addressing table of (stamp, index) pairs.
+ * Once a set outgrows the table, or the dense array would not be larger
+ * than the table, it switches to a stamp array indexed directly by
+ * SimplexID::index(). Entries of both are valid only if their stamp equals
+ * `epoch`, so clearing either takes O(1) time.
+ */
+struct stamp_buffer {
+  /// Number of entries above which a set switches to the dense array.
+  static constexpr std::size_t sparse_limit = 1024;
+
+  std::vector<std::uint32_t> stamps; ///< Dense stamps, used if `dense`
+  std::vector<std::pair<std::uint32_t, std::size_t>> table; ///< Sparse
+  std::uint32_t epoch = 0;
+  std::size_t size = 0;      ///< Entries of the current epoch in the table
+  std::size_t max_index = 0; ///< Largest index in the table
+  bool dense = false;
+
+  /// Slot of index i in the table.
+  std::size_t home(std::size_t i) const {
+    return static_cast<std::size_t>(
+               (static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull) >>
+               32) &
+           (table.size() - 1);
+  }
+
+  /// Find index i in the table, or the empty slot where it belongs.
+  std::size_t probe(std::size_t i) const {
+    std::size_t h = home(i);
+    while (table[h].first == epoch && table[h].second != i) {
+      h = (h + 1) & (table.size() - 1);
+    }
+    return h;
+  }
+
+  /// Make room for one more entry, possibly switching to the dense array.
+  void grow(std::size_t i) {
+    const std::size_t cap = std::max<std::size_t>(16, 2 * table.size());
+    const std::size_t bound = std::max(max_index, i) + 1;
+    if (size >= sparse_limit || bound <= cap) {
+      if (stamps.size() < bound) {
+        stamps.resize(bound, 0);
+      }
+      for (const auto &e : table) {
+        if (e.first == epoch) {
+          stamps[e.second] = epoch;
+        }
+      }
+      dense = true;
+      return;
+    }
+    std::vector<std::pair<std::uint32_t, std::size_t>> old(cap);
+    old.swap(table);
+    for (const auto &e : old) {
+      if (e.first == epoch) {
+        table[probe(e.second)] = e;
+      }
+    }
+  }
+};
+
+/// Free list of stamp buffers, one per thread.
+class stamp_pool {
+public:
+  /// Number of buffers kept for nested traversals.
+  static constexpr std::size_t max_buffers = 4;
+  /// Buffers with larger dense arrays are freed instead of kept.
+  static constexpr std::size_t max_buffer_bytes = 16 << 20;
+
+  std::unique_ptr<stamp_buffer> acquire() {
+    if (_free.empty()) {
+      return std::unique_ptr<stamp_buffer>(new stamp_buffer());
+    }
+    auto rval = std::move(_free.back());
+    _free.pop_back();
+    return rval;
+  }
+
+  void release(std::unique_ptr<stamp_buffer> buf) {
+    if (_free.size() < max_buffers &&
+        buf->stamps.size() * sizeof(std::uint32_t) <= max_buffer_bytes) {
+      _free.push_back(std::move(buf));
+    }
+  }
+
+private:
+  std::vector<std::unique_ptr<stamp_buffer>> _free;
+};
+
+inline stamp_pool &thread_stamp_pool() {
+  static thread_local stamp_pool pool;
+  return pool;
+}
+} // end namespace visited_detail
+/// @endcond
+
+/**
+ * @brief      Set of visited simplices indexed by SimplexID::index().
+ *
+ * Small sets are kept in a hash table of indices, so a query touching a
+ * few simplices of a large complex costs memory proportional to the
+ * query. Sets of more than a thousand simplices switch to a flat stamp
+ * array where membership is a single lookup at SimplexID::index().
+ * clear() bumps a generation counter, so resetting takes O(1) time
+ * regardless of how many simplices were visited, and returns the set to
+ * the hash table until it grows large again. The storage is recycled
+ * through a per-thread pool of up to four buffers, which makes repeated
+ * traversals allocation free once warmed up. Nested traversals each draw
+ * their own buffer, and buffers whose stamp array exceeds 16 MiB are
+ * freed rather than kept.
+ *
+ * A visited_set is only valid while the topology of the complex is not
+ * modified. Inserting or removing simplices may compact a registry, which
+ * renumbers SimplexID::index(), so a traversal using a visited_set must
+ * not modify the complex it traverses.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~{.cpp}
+ * casc::visited_set<Mesh::SimplexID<1>> seen;
+ * for (auto v : mesh.get_level_id<1>()) {
+ *   if (seen.insert(v)) {
+ *     // First visit of v
+ *   }
+ * }
+ * ~~~~~~~~~~~~~~~
+ *
+ * @tparam     SimplexID  Typename of the simplices, must provide index().
+ */
+template <typename SimplexID> class visited_set {
+public:
+  /// Construct an empty set.
+  visited_set() : _buf(visited_detail::thread_stamp_pool().acquire()) {
+    clear();
+  }
+
+  visited_set(const visited_set &) = delete;
+  visited_set &operator=(const visited_set &) = delete;
+
+  /// Move constructor
+  visited_set(visited_set &&rhs) = default;
+
+  /// Return the stamp storage to the pool.
+  ~visited_set() {
+    if (_buf) {
+      visited_detail::thread_stamp_pool().release(std::move(_buf));
+    }
+  }
+
+  /**
+   * @brief      Mark a simplex as visited.
+   *
+   * @param[in]  s     The simplex.
+   *
+   * @return     True if `s` was not visited before.
+   */
+  bool insert(SimplexID s) {
+    const std::size_t i = s.index();
+    auto &buf = *_buf;
+    if (!buf.dense) {
+      if (!buf.table.empty() && buf.table[buf.probe(i)].first == buf.epoch) {
+        return false;
+      }
+      if (2 * (buf.size + 1) > buf.table.size()) {
+        buf.grow(i);
+      }
+    }
+    if (buf.dense) {
+      auto &stamps = buf.stamps;
+      if (i >= stamps.size()) {
+        stamps.resize(std::max(2 * stamps.size(), i + 1), 0);
+      }
+      if (stamps[i] == buf.epoch) {
+        return false;
+      }
+      stamps[i] = buf.epoch;
+      return true;
+    }
+    buf.table[buf.probe(i)] = std::make_pair(buf.epoch, i);
+    buf.max_index = std::max(buf.max_index, i);
+    ++buf.size;
+    return true;
+  }
+
+  /**
+   * @brief      Check whether a simplex has been visited.
+   *
+   * @param[in]  s     The simplex.
+   *
+   * @return     1 if visited, 0 otherwise.
+   */
+  std::size_t count(SimplexID s) const {
+    const std::size_t i = s.index();
+    const auto &buf = *_buf;
+    if (buf.dense) {
+      return i < buf.stamps.size() && buf.stamps[i] == buf.epoch;
+    }
+    return !buf.table.empty() && buf.table[buf.probe(i)].first == buf.epoch;
+  }
+
+  /// Forget all visited simplices in O(1).
+  void clear() {
+    auto &buf = *_buf;
+    buf.size = 0;
+    buf.max_index = 0;
+    // Start over in the table, whose old entries are invalid by the epoch
+    buf.dense = false;
+    if (++buf.epoch == 0) {
+      // The counter wrapped around, old stamps could match again
+      std::fill(buf.stamps.begin(), buf.stamps.end(), 0);
+      for (auto &e : buf.table) {
+        e.first = 0;
+      }
+      buf.epoch = 1;
+    }
+  }
+
+private:
+  std::unique_ptr<visited_detail::stamp_buffer> _buf;
+};
+
+/**
+ * @brief      Vector of unique simplices in order of first insertion.
+ *
+ * Provides the insert() interface of a set on top of a visited_set, so it
+ * can replace a NodeSet as the frontier of a traversal while iterating in
+ * a deterministic order. Storage comes from recycling_allocator.
+ *
+ * @tparam     SimplexID  Typename of the simplices, must provide index().
+ */
+template <typename SimplexID> class visited_list {
+public:
+  /// Typename of the values
+  using value_type = SimplexID;
+  /// Typename of the underlying vector
+  using vector_t = std::vector<SimplexID, recycling_allocator<SimplexID>>;
+  /// Iterator over the simplices
+  using iterator = typename vector_t::const_iterator;
+  /// Iterator over the simplices
+  using const_iterator = iterator;
+
+  /**
+   * @brief      Append a simplex if it is not present yet.
+   *
+   * @param[in]  s     The simplex.
+   *
+   * @return     True if `s` was appended.
+   */
+  bool insert(SimplexID s) {
+    if (_seen.insert(s)) {
+      _items.push_back(s);
+      return true;
+    }
+    return false;
+  }
+
+  /// Append a simplex ignoring the hint. Allows std::inserter.
+  iterator insert(const_iterator, SimplexID s) {
+    insert(s);
+    return _items.begin();
+  }
+
+  /// Check whether a simplex is present.
+  std::size_t count(SimplexID s) const { return _seen.count(s); }
+
+  /// Remove all simplices in O(1) keeping the storage.
+  void clear() {
+    _items.clear();
+    _seen.clear();
+  }
+
+  /// Number of simplices.
+  std::size_t size() const { return _items.size(); }
+  /// Check whether the list is empty.
+  bool empty() const { return _items.empty(); }
+
+  /// Iterator to the first simplex.
+  const_iterator begin() const { return _items.begin(); }
+  /// Iterator past the last simplex.
+  const_iterator end() const { return _items.end(); }
+
+private:
+  vector_t _items;
+  visited_set<SimplexID> _seen;
+};
+} // end namespace casc
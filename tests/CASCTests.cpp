@@ -16,12 +16,19 @@
 // or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
 // Floor, Boston, MA 02110-1301 USA
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
+
+#ifdef CASC_ENABLE_PARALLEL
+#include <thread>
+#endif
 
 #include <casc/casc>
 
@@ -230,6 +237,68 @@ TEST(CASCTest, Remove) {
 
 // Insert `trials` number of vertices with random integer data. Then check if
 // the inserted data is indeed correct.
+// Batched removal must match removing each simplex in turn
+TEST(CASCTest, RemoveBatch) {
+  const int n = 8;
+  SurfaceMeshType ref, batch;
+  for (auto F : {&ref, &batch}) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        int a = i * (n + 1) + j;
+        F->insert<3>({a, a + 1, a + n + 2});
+        F->insert<3>({a, a + n + 1, a + n + 2});
+      }
+    }
+  }
+  auto vertices = {10, 11, 40};
+  auto edges = {std::array<int, 2>{{11, 12}}, std::array<int, 2>{{0, 1}}};
+  auto faces = {std::array<int, 3>{{50, 51, 60}}};
+
+  casc::SimplexSet<SurfaceMeshType> S;
+  for (int v : vertices) {
+    S.insert(batch.get_simplex_up({v}));
+  }
+  for (auto e : edges) {
+    S.insert(batch.get_simplex_up(e));
+  }
+  for (auto f : faces) {
+    S.insert(batch.get_simplex_up(f));
+  }
+  // Cofaces of removed vertices are removed only once
+  S.insert(batch.get_simplex_up({10, 11}));
+
+  std::size_t expected = 0;
+  for (auto f : faces) {
+    expected += ref.remove(f);
+  }
+  for (auto e : edges) {
+    expected += ref.remove(e);
+  }
+  for (int v : vertices) {
+    expected += ref.remove<1>({v});
+  }
+  EXPECT_EQ(batch.remove_batch(S), expected);
+  EXPECT_EQ(batch.size<1>(), ref.size<1>());
+  EXPECT_EQ(batch.size<2>(), ref.size<2>());
+  EXPECT_EQ(batch.size<3>(), ref.size<3>());
+  for (auto s : ref.get_level_id<2>()) {
+    auto t = batch.get_simplex_up(ref.get_name(s));
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(ref.get_cover(s), batch.get_cover(t));
+  }
+  for (auto s : ref.get_level_id<1>()) {
+    auto t = batch.get_simplex_up(ref.get_name(s));
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(ref.get_cover(s), batch.get_cover(t));
+  }
+  EXPECT_FALSE(batch.exists({11}));
+  EXPECT_FALSE(batch.exists({50, 51, 60}));
+  // Keys of removed vertices are reused in order
+  EXPECT_EQ(batch.add_vertex(), 10);
+  EXPECT_EQ(batch.add_vertex(), 11);
+  EXPECT_EQ(batch.add_vertex(), 40);
+}
+
 TEST(CASCTest, InsertRandomVals) {
   int trials = 100;
 
@@ -265,3 +334,727 @@ TEST(CASCTest, InsertRandomVals) {
   // Ensure that all vertices were removed...
   EXPECT_EQ(0, pairs.size()) << "All vertices should have been checked.";
 }
+
+// Removed simplices should give their storage back to the pool to be reused
+TEST(CASCTest, NodePoolReuse) {
+  casc::node_pool<std::array<int, 4>, 4> pool;
+  auto a = pool.construct();
+  auto b = pool.construct();
+  EXPECT_EQ(pool.size(), 2);
+  EXPECT_EQ(pool.capacity(), 4);
+
+  pool.destroy(a);
+  auto c = pool.construct();
+  EXPECT_EQ(a, c) << "Freed slot should be recycled.";
+
+  for (int i = 0; i < 6; ++i) {
+    pool.construct();
+  }
+  EXPECT_EQ(pool.size(), 8);
+  EXPECT_EQ(pool.capacity(), 8);
+  pool.destroy(b);
+  pool.destroy(c);
+  EXPECT_EQ(pool.size(), 6);
+}
+
+// Split key/value maps must keep their keys sorted through edits
+TEST(CASCTest, AdjacencyMaps) {
+  casc::detail::asc_arraymap<int, int *, 4> down;
+  int vals[8];
+  const int order[] = {7, 3, 9, 1};
+  for (int i = 0; i < 4; ++i) {
+    down[order[i]] = &vals[i];
+  }
+  EXPECT_THROW(down[5], std::out_of_range);
+  std::vector<int> keys;
+  for (auto p : down) {
+    keys.push_back(p.first);
+  }
+  EXPECT_EQ(keys, std::vector<int>({1, 3, 7, 9}));
+  EXPECT_EQ(down.find(7)->second, &vals[0]);
+  EXPECT_EQ(down.index(9), 3);
+  down.erase(3);
+  EXPECT_EQ(down.size(), 3);
+  EXPECT_EQ(down.find(3), down.end());
+  EXPECT_EQ(down.index(9), 2);
+  EXPECT_EQ(down[9], &vals[2]);
+
+  casc::detail::asc_vectormap<int, int *> up;
+  for (int i = 0; i < 200; ++i) {
+    up[(i * 37) % 200] = &vals[i % 8];
+  }
+  EXPECT_EQ(up.size(), 200);
+  EXPECT_GE(up.capacity(), 200);
+  int prev = -1;
+  for (auto it = up.cbegin(); it != up.cend(); ++it) {
+    EXPECT_LT(prev, it->first);
+    prev = it->first;
+  }
+  for (int i = 0; i < 200; i += 2) {
+    up.erase(i);
+  }
+  EXPECT_EQ(up.size(), 100);
+  EXPECT_EQ(up.find(10), up.end());
+  EXPECT_EQ(up.at(11), &vals[103 % 8]);
+  EXPECT_THROW(up.at(12), std::out_of_range);
+  auto copy = up;
+  EXPECT_EQ(copy.size(), 100);
+  EXPECT_EQ(copy.find(199)->second, up.find(199)->second);
+
+  // Keys which cannot be packed after the Values are kept in a vector
+  casc::detail::asc_vectormap<std::string, int *> named;
+  for (const char *key : {"d", "b", "a", "c"}) {
+    named[key] = &vals[0];
+  }
+  named.erase("b");
+  named["c"] = &vals[1];
+  std::vector<std::string> names;
+  for (auto p : named) {
+    names.push_back(p.first);
+  }
+  EXPECT_EQ(names, std::vector<std::string>({"a", "c", "d"}));
+  EXPECT_EQ(named.at("c"), &vals[1]);
+  EXPECT_EQ(named.find("b"), named.end());
+  EXPECT_THROW(named.at("b"), std::out_of_range);
+}
+
+struct new_delete_traits {
+  using KeyType = int;
+  using NodeTypes = util::type_holder<int, int, int, int>;
+  using EdgeTypes = util::type_holder<int, int, int>;
+  template <typename T> using NodeAllocator = casc::new_delete_pool<T>;
+};
+
+// The node allocator can be switched out through the complex traits
+TEST(CASCTest, CustomNodeAllocator) {
+  casc::simplicial_complex<new_delete_traits> mesh;
+  mesh.insert<3>({1, 2, 3});
+  mesh.insert<3>({2, 3, 4});
+  EXPECT_EQ(mesh.size<1>(), 4);
+  EXPECT_EQ(mesh.size<2>(), 5);
+  EXPECT_EQ(mesh.size<3>(), 2);
+
+  mesh.remove<1>({4});
+  EXPECT_EQ(mesh.size<1>(), 3);
+  EXPECT_EQ(mesh.size<2>(), 3);
+  EXPECT_EQ(mesh.size<3>(), 1);
+}
+
+struct name_index_traits {
+  using KeyType = int;
+  using NodeTypes = util::type_holder<int, int, int, int, int>;
+  using EdgeTypes = util::type_holder<int, int, int, int>;
+  template <typename Name, typename T>
+  using NameIndex = casc::NameMap<Name, T>;
+};
+
+// The name index must agree with the coface walk through inserts and removals
+TEST(CASCTest, NameIndex) {
+  std::vector<int> tets = {1, 2, 3, 4, 2, 3, 4, 5, 5, 4, 3, 6,
+                           9, 8, 7, 6, 1, 2, 3, 4, 3, 5, 7, 9};
+  TetMeshType ref;
+  casc::simplicial_complex<name_index_traits> mesh;
+  casc::simplicial_complex<name_index_traits> bulk;
+  for (std::size_t i = 0; i < tets.size() / 4; ++i) {
+    ref.insert<4>({tets[4 * i], tets[4 * i + 1], tets[4 * i + 2],
+                   tets[4 * i + 3]});
+    mesh.insert<4>({tets[4 * i], tets[4 * i + 1], tets[4 * i + 2],
+                    tets[4 * i + 3]});
+  }
+  bulk.bulk_insert<4>(tets.data(), tets.size() / 4);
+  EXPECT_GT(mesh.memory_stats(false).levels[3].index_bytes, 0);
+
+  auto check = [&](auto &F) {
+    for (auto s : ref.get_level_id<2>()) {
+      auto name = ref.get_name(s);
+      auto t = F.get_simplex_up(name);
+      EXPECT_EQ(t != nullptr, F.exists({name[1], name[0]}));
+      if (t != nullptr) {
+        EXPECT_EQ(F.get_name(t), name);
+      }
+    }
+    for (auto s : ref.get_level_id<4>()) {
+      auto name = ref.get_name(s);
+      auto t = F.get_simplex_up({name[3], name[1], name[0], name[2]});
+      EXPECT_EQ(t, F.get_simplex_up(name));
+      if (t != nullptr) {
+        EXPECT_EQ(F.get_name(t), name);
+      }
+    }
+  };
+  for (auto F : {&mesh, &bulk}) {
+    check(*F);
+    EXPECT_NE(F->get_simplex_up({6, 7, 8, 9}), nullptr);
+    EXPECT_EQ(F->get_simplex_up({1, 2, 3, 5}), nullptr);
+
+    F->remove<1>({4});
+    F->remove<2>({7, 9});
+    EXPECT_FALSE(F->exists({4}));
+    EXPECT_FALSE(F->exists({2, 4}));
+    EXPECT_FALSE(F->exists({7, 9}));
+    EXPECT_EQ(F->get_simplex_up({6, 7, 8, 9}), nullptr);
+    EXPECT_NE(F->get_simplex_up({3, 5, 7}), nullptr);
+    check(*F);
+
+    F->insert<4>({2, 3, 4, 5});
+    EXPECT_TRUE(F->exists({4, 5}));
+    EXPECT_NE(F->get_simplex_up({5, 4, 3, 2}), nullptr);
+    check(*F);
+  }
+}
+
+// Moving a complex transfers all simplices and leaves an empty complex
+TEST(CASCTest, MoveConstructor) {
+  SurfaceMeshType mesh;
+  mesh.insert<3>({1, 2, 3}, 7);
+  mesh.insert<3>({2, 3, 4}, 8);
+
+  SurfaceMeshType moved(std::move(mesh));
+  EXPECT_EQ(moved.size<3>(), 2);
+  EXPECT_EQ(*moved.get_simplex_up({2, 3, 4}), 8);
+  EXPECT_EQ(mesh.size<0>(), 1);
+  EXPECT_EQ(mesh.size<1>(), 0);
+
+  mesh = std::move(moved);
+  EXPECT_EQ(mesh.size<3>(), 2);
+  EXPECT_EQ(*mesh.get_simplex_up({1, 2, 3}), 7);
+  EXPECT_EQ(mesh.add_vertex(), 0);
+}
+
+// Level iteration should skip removed simplices and keep insertion order
+TEST(CASCTest, LevelRegistry) {
+  SurfaceMeshType mesh;
+  for (int i = 0; i < 200; ++i) {
+    mesh.insert<1>({i}, i);
+  }
+  for (int i = 0; i < 200; i += 3) {
+    mesh.remove<1>({i});
+  }
+  for (int i = 1; i < 200; i += 3) {
+    mesh.remove<1>({i});
+  }
+
+  std::vector<int> expected;
+  for (int i = 2; i < 200; i += 3) {
+    expected.push_back(i);
+  }
+  EXPECT_EQ(mesh.size<1>(), expected.size());
+
+  std::vector<int> names, data;
+  for (auto s : mesh.get_level_id<1>()) {
+    names.push_back(mesh.get_name(s)[0]);
+  }
+  for (auto d : mesh.get_level<1>()) {
+    data.push_back(d);
+  }
+  EXPECT_EQ(names, expected);
+  EXPECT_EQ(data, expected);
+
+  {
+    // Reverse iteration
+    auto range = mesh.get_level_id<1>();
+    auto it = range.end();
+    std::vector<int> reversed;
+    while (it != range.begin()) {
+      --it;
+      reversed.push_back(mesh.get_name(*it)[0]);
+    }
+    std::reverse(reversed.begin(), reversed.end());
+    EXPECT_EQ(reversed, expected);
+  }
+
+  // Inserting while iterating defers the compaction due to the tombstones
+  const std::size_t slots = mesh.slots<1>();
+  std::vector<int> visited;
+  for (auto s : mesh.get_level_id<1>()) {
+    const int name = mesh.get_name(s)[0];
+    visited.push_back(name);
+    if (name < 1000) {
+      mesh.insert({name + 1000});
+    }
+  }
+  EXPECT_EQ(visited, expected);
+  EXPECT_EQ(mesh.slots<1>(), slots + 66);
+  {
+    // A stored range keeps the tombstones as well
+    auto stored = mesh.get_level_id<1>();
+    mesh.remove<1>({1002});
+    mesh.insert({2000});
+    EXPECT_EQ(mesh.slots<1>(), slots + 67);
+  }
+  // and the first insertion afterwards compacts
+  mesh.insert({2001});
+  EXPECT_EQ(mesh.slots<1>(), mesh.size<1>());
+
+  // Removing while iterating is safe
+  for (auto s : mesh.get_level_id<1>()) {
+    mesh.remove(s);
+  }
+  EXPECT_EQ(mesh.size<1>(), 0);
+  EXPECT_EQ(mesh.get_level_id<1>().begin(), mesh.get_level_id<1>().end());
+}
+
+// Bulk insertion should produce the same complex as repeated insertion
+TEST(CASCTest, BulkInsert) {
+  std::vector<int> tets = {1, 2, 3, 4, 2, 3, 4, 5, 5, 4, 3, 6,
+                           9, 8, 7, 6, 1, 2, 3, 4, 3, 5, 7, 9};
+  std::vector<int> data = {10, 11, 12, 13, 14, 15};
+
+  TetMeshType ref;
+  ref.insert<2>({7, 10});
+  TetMeshType bulk;
+  bulk.insert<2>({7, 10});
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    ref.insert<4>({tets[4 * i], tets[4 * i + 1], tets[4 * i + 2],
+                   tets[4 * i + 3]},
+                  data[i]);
+  }
+  bulk.bulk_insert<4>(tets.data(), data.size(), data.data());
+
+  EXPECT_EQ(ref.size<1>(), bulk.size<1>());
+  EXPECT_EQ(ref.size<2>(), bulk.size<2>());
+  EXPECT_EQ(ref.size<3>(), bulk.size<3>());
+  EXPECT_EQ(ref.size<4>(), bulk.size<4>());
+
+  for (auto s : ref.get_level_id<2>()) {
+    auto t = bulk.get_simplex_up(ref.get_name(s));
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(ref.get_cover(s), bulk.get_cover(t));
+  }
+  for (auto s : ref.get_level_id<3>()) {
+    auto t = bulk.get_simplex_up(ref.get_name(s));
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(ref.get_cover(s), bulk.get_cover(t));
+    EXPECT_EQ(ref.get_name(s), bulk.get_name(t));
+  }
+  for (auto s : ref.get_level_id<4>()) {
+    auto t = bulk.get_simplex_up(ref.get_name(s));
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(*s, *t);
+  }
+
+  // New vertices must be marked as used
+  int v = bulk.add_vertex();
+  EXPECT_EQ(v, 0);
+  v = bulk.add_vertex();
+  EXPECT_EQ(v, 11);
+
+  // Vertices only
+  SurfaceMeshType mesh;
+  int verts[] = {3, 1, 2, 1};
+  int vdata[] = {30, 10, 20, 11};
+  mesh.bulk_insert<1>(verts, 4, vdata);
+  EXPECT_EQ(mesh.size<1>(), 3);
+  EXPECT_EQ(*mesh.get_simplex_up({1}), 11);
+  EXPECT_EQ(*mesh.get_simplex_up({3}), 30);
+}
+
+TEST(CASCTest, BulkInsertParallel) {
+  // Tetrahedralized grid large enough to be split across threads
+  const int n = 12;
+  auto id = [n](int i, int j, int k) {
+    return (i * (n + 1) + j) * (n + 1) + k;
+  };
+  const int tt[6][4] = {{0, 1, 3, 7}, {0, 1, 5, 7}, {0, 2, 3, 7},
+                        {0, 2, 6, 7}, {0, 4, 5, 7}, {0, 4, 6, 7}};
+  std::vector<int> tets;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      for (int k = 0; k < n; ++k) {
+        int c[8] = {id(i, j, k),         id(i + 1, j, k),
+                    id(i, j + 1, k),     id(i + 1, j + 1, k),
+                    id(i, j, k + 1),     id(i + 1, j, k + 1),
+                    id(i, j + 1, k + 1), id(i + 1, j + 1, k + 1)};
+        for (auto &t : tt) {
+          for (int x : t) {
+            tets.push_back(c[x]);
+          }
+        }
+      }
+    }
+  }
+  const std::size_t count = tets.size() / 4;
+
+  TetMeshType ref;
+  for (std::size_t i = 0; i < count; ++i) {
+    ref.insert<4>({tets[4 * i], tets[4 * i + 1], tets[4 * i + 2],
+                   tets[4 * i + 3]});
+  }
+
+  casc::parallel::set_num_threads(4);
+  TetMeshType bulk;
+  bulk.bulk_insert<4>(tets.data(), count);
+  casc::parallel::set_num_threads(0);
+
+  EXPECT_EQ(ref.size<1>(), bulk.size<1>());
+  EXPECT_EQ(ref.size<2>(), bulk.size<2>());
+  EXPECT_EQ(ref.size<3>(), bulk.size<3>());
+  EXPECT_EQ(ref.size<4>(), bulk.size<4>());
+  for (auto s : ref.get_level_id<2>()) {
+    auto t = bulk.get_simplex_up(ref.get_name(s));
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(ref.get_cover(s), bulk.get_cover(t));
+  }
+  for (auto s : ref.get_level_id<3>()) {
+    auto t = bulk.get_simplex_up(ref.get_name(s));
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(ref.get_cover(s), bulk.get_cover(t));
+  }
+}
+
+// Edge data is stored per face and survives changes to the rest of the complex
+TEST_F(CASCTestFix, EdgeData) {
+  for (auto s : mesh.get_level_id<3>()) {
+    auto name = mesh.get_name(s);
+    for (auto v : name) {
+      *mesh.get_edge_down(s, v) = 10 * s.index() + v;
+    }
+  }
+  for (auto s : mesh.get_level_id<2>()) {
+    auto name = mesh.get_name(s);
+    *mesh.get_edge_down(s, name[0]) = -name[1];
+    EXPECT_EQ(*mesh.get_edge_down(s, name[1]), 0);
+  }
+
+  mesh.insert<3>({4, 5, 6});
+  mesh.remove<1>({1});
+  for (auto s : mesh.get_level_id<3>()) {
+    if (s.index() == 4)
+      continue;
+    for (auto v : mesh.get_name(s)) {
+      EXPECT_EQ(*mesh.get_edge_down(s, v), 10 * s.index() + v);
+    }
+  }
+  auto e = mesh.get_simplex_up({3, 4});
+  EXPECT_EQ(*mesh.get_edge_down(e, 3), -4);
+  EXPECT_EQ(*mesh.get_edge_up(mesh.get_simplex_up({4}), 3), -4);
+}
+
+// A clone is an independent copy with the same data and keys
+TEST_F(CASCTestFix, Clone) {
+  for (auto s : mesh.get_level_id<3>()) {
+    *s = s.index();
+    for (auto v : mesh.get_name(s)) {
+      *mesh.get_edge_down(s, v) = 10 * s.index() + v;
+    }
+  }
+  // Leave tombstones in the registries and a hole in the vertex keys
+  mesh.insert<3>({4, 5, 6});
+  mesh.remove<1>({1});
+
+  auto copy = mesh.clone();
+  for (std::size_t k = 0; k < 4; ++k) {
+    EXPECT_EQ(copy.memory_stats(false).levels[k].nodes,
+              mesh.memory_stats(false).levels[k].nodes);
+  }
+  std::vector<std::array<int, 3>> names, copied;
+  for (auto s : mesh.get_level_id<3>()) {
+    names.push_back(mesh.get_name(s));
+  }
+  for (auto s : copy.get_level_id<3>()) {
+    copied.push_back(copy.get_name(s));
+  }
+  EXPECT_EQ(copied, names);
+  for (auto name : names) {
+    auto s = mesh.get_simplex_up(name);
+    auto t = copy.get_simplex_up(name);
+    ASSERT_TRUE(copy.exists({name[0], name[1], name[2]}));
+    EXPECT_NE(&*s, &*t);
+    EXPECT_EQ(*t, *s);
+    // The registries of the copy have no tombstones
+    EXPECT_LT(t.index(), copy.size<3>());
+    for (auto v : name) {
+      EXPECT_EQ(*copy.get_edge_down(t, v), *mesh.get_edge_down(s, v));
+      EXPECT_EQ(copy.get_name(copy.get_simplex_down(t, v)),
+                mesh.get_name(mesh.get_simplex_down(s, v)));
+    }
+  }
+  EXPECT_EQ(*copy.get_simplex_up({2}), 2);
+  EXPECT_EQ(copy.get_cover(copy.get_simplex_up({4})),
+            mesh.get_cover(mesh.get_simplex_up({4})));
+
+  // The copies evolve independently
+  EXPECT_EQ(copy.add_vertex(), mesh.add_vertex());
+  copy.remove<1>({4});
+  *copy.get_simplex_up({2}) = 20;
+  EXPECT_EQ(mesh.size<3>(), 2);
+  EXPECT_EQ(copy.size<3>(), 0);
+  EXPECT_EQ(*mesh.get_simplex_up({2}), 2);
+  EXPECT_TRUE(mesh.exists({2, 4}));
+
+  // Name indexed lookups resolve to the copy
+  casc::simplicial_complex<name_index_traits> indexed;
+  indexed.insert<3>({1, 2, 3});
+  indexed.insert<3>({1, 3, 4});
+  auto indexed_copy = indexed.clone();
+  auto f = indexed_copy.get_simplex_up({3, 1, 4});
+  EXPECT_EQ(indexed_copy.get_simplex_up({1, 3}), f.get_simplex_down(4));
+  indexed_copy.remove<1>({2});
+  EXPECT_FALSE(indexed_copy.exists({1, 2, 3}));
+  EXPECT_TRUE(indexed.exists({1, 2, 3}));
+}
+
+// Forks share the complex until they are written
+TEST(CASCTest, CopyOnWrite) {
+  SurfaceMeshType F;
+  F.insert<3>({1, 2, 3});
+  casc::copy_on_write<SurfaceMeshType> base(std::move(F));
+  auto fork = base;
+  EXPECT_TRUE(base.shared());
+  EXPECT_EQ(&*fork, &*base);
+
+  fork.write().insert<3>({2, 3, 4});
+  EXPECT_FALSE(base.shared());
+  EXPECT_NE(&*fork, &*base);
+  EXPECT_EQ(base->size<3>(), 1);
+  EXPECT_EQ(fork.read().size<3>(), 2);
+
+  // Writing an unshared complex does not copy it
+  auto p = &fork.write();
+  EXPECT_EQ(p, &*fork);
+}
+
+struct columnar_traits {
+  using KeyType = int;
+  using NodeTypes = util::type_holder<int, double, void, int>;
+  using EdgeTypes = util::type_holder<int, int, int>;
+  using ColumnarNodeData = std::true_type;
+};
+
+// Columnar data is reached through SimplexIDs and streamed as an array
+TEST(CASCTest, ColumnarData) {
+  casc::simplicial_complex<columnar_traits> mesh;
+  const int n = 40;
+  for (int i = 0; i < n; ++i) {
+    mesh.insert<1>({i}, 0.5 * i);
+  }
+  // Growing the columns must keep every Node pointing at its data
+  for (int i = 0; i + 2 < n; ++i) {
+    mesh.insert<3>({i, i + 1, i + 2}, i);
+  }
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(*mesh.get_simplex_up({i}), 0.5 * i);
+  }
+  EXPECT_EQ(*mesh.get_simplex_up({3, 4, 5}), 3);
+
+  for (int i = 0; i < n; i += 4) {
+    mesh.remove<1>({i});
+  }
+  auto column = mesh.get_data_column<1>();
+  ASSERT_EQ(static_cast<std::size_t>(column.end() - column.begin()),
+            mesh.size<1>());
+  std::size_t i = 0;
+  for (auto s : mesh.get_level_id<1>()) {
+    EXPECT_EQ(s.index(), i);
+    EXPECT_EQ(&*s, column.begin() + i);
+    EXPECT_EQ(*s, 0.5 * mesh.get_name(s)[0]);
+    ++i;
+  }
+  for (auto &x : column) {
+    x *= 2;
+  }
+  EXPECT_EQ(*mesh.get_simplex_up({5}), 5.0);
+
+  auto copy = mesh.clone();
+  *copy.get_simplex_up({5}) = -1;
+  EXPECT_EQ(*mesh.get_simplex_up({5}), 5.0);
+  EXPECT_EQ(*copy.get_simplex_up({5, 6, 7}), 5);
+
+  auto faces = mesh.get_data_column<3>();
+  EXPECT_EQ(static_cast<std::size_t>(faces.end() - faces.begin()),
+            mesh.size<3>());
+  EXPECT_GT(mesh.memory_stats(false).levels[1].registry_bytes,
+            mesh.size<1>() * sizeof(double));
+
+  // Data of a simplex of the same level may be inserted while the column
+  // grows
+  casc::simplicial_complex<columnar_traits> G;
+  G.insert<1>({0}, 1.5);
+  for (int i = 1; i < 100; ++i) {
+    G.insert<1>({i}, *G.get_simplex_up({i - 1}));
+  }
+  EXPECT_EQ(*G.get_simplex_up({99}), 1.5);
+
+  // Squeezing the column renumbers the vertices and outdates derived views
+  casc::simplicial_complex<columnar_traits> H;
+  for (int i = 0; i < 4; ++i) {
+    H.insert<3>({i, i + 1, i + 2}, i);
+  }
+  for (int i = 10; i < 20; ++i) {
+    H.insert<1>({i}, i);
+  }
+  H.remove<1>({0});
+  casc::halfedge_view<decltype(H)> he(H);
+  {
+    // Not while the level is iterated
+    auto range = H.get_level_id<1>();
+    EXPECT_THROW(H.get_data_column<1>(), std::logic_error);
+    EXPECT_FALSE(he.stale());
+  }
+  H.get_data_column<1>();
+  EXPECT_TRUE(he.stale());
+  he.sync();
+  EXPECT_EQ(he.key(he.vertex(H.get_simplex_up({5}))), 5);
+  EXPECT_EQ(H.get_simplex_up({5}).index(), 4);
+}
+
+// The footprint report should account for every level
+TEST_F(CASCTestFix, MemoryStats) {
+  auto stats = mesh.memory_stats();
+  const std::size_t expected[] = {1, 4, 6, 4};
+  for (std::size_t k = 0; k < 4; ++k) {
+    const auto &l = stats.levels[k];
+    EXPECT_EQ(l.nodes, expected[k]);
+    EXPECT_GT(l.node_bytes, 0);
+    EXPECT_GE(l.pool_bytes, l.node_bytes);
+    EXPECT_GE(l.registry_bytes, l.nodes * sizeof(void *));
+    EXPECT_LE(l.up_slack, l.up_bytes);
+    // Every face map of a closed surface is full
+    EXPECT_EQ(l.down_slack, 0);
+  }
+  EXPECT_GT(stats.levels[0].up_bytes, 0);
+  EXPECT_EQ(stats.levels[3].up_bytes, 0);
+  EXPECT_GT(stats.tracker_bytes, 0);
+  EXPECT_GT(stats.total(), stats.tracker_bytes);
+
+  auto quick = mesh.memory_stats(false);
+  for (std::size_t k = 0; k < 4; ++k) {
+    EXPECT_EQ(quick.levels[k].nodes, stats.levels[k].nodes);
+    EXPECT_EQ(quick.levels[k].pool_bytes, stats.levels[k].pool_bytes);
+    EXPECT_EQ(quick.levels[k].up_bytes,
+              stats.levels[k].up_bytes - stats.levels[k].up_slack);
+    EXPECT_EQ(quick.levels[k].up_slack, 0);
+  }
+
+  mesh.remove<1>({4});
+  stats = mesh.memory_stats();
+  EXPECT_EQ(stats.levels[1].nodes, 3);
+  EXPECT_EQ(stats.levels[3].nodes, 1);
+}
+
+namespace {
+std::size_t spans = 0;
+void count_span(casc::stats::event, std::uint64_t, std::uint64_t,
+                void *user) {
+  ++*static_cast<std::size_t *>(user);
+}
+} // namespace
+
+// Counters only move when built with CASC_ENABLE_STATS
+TEST(CASCTest, Stats) {
+  using casc::stats::event;
+  casc::stats::reset();
+  casc::stats::set_span_callback(count_span, &spans);
+  spans = 0;
+
+  SurfaceMeshType mesh;
+  mesh.insert<3>({1, 2, 3});
+  mesh.insert<3>({2, 3, 4});
+  auto s = mesh.get_simplex_up({2, 3});
+  casc::SimplexSet<SurfaceMeshType> star;
+  casc::getStar(mesh, s, star);
+  mesh.remove<1>({4});
+
+  auto stats = casc::stats::snapshot();
+  if (casc::stats::enabled()) {
+    // The root, 4 vertices, 5 edges and 2 faces
+    EXPECT_EQ(stats[event::create_node].count, 12);
+    EXPECT_EQ(stats[event::create_node].max, 3);
+    // The vertex, two edges and a face
+    EXPECT_EQ(stats[event::remove_node].count, 4);
+    EXPECT_EQ(stats[event::insert].max, 3);
+    EXPECT_GE(stats[event::get_recurse].count, 2);
+    // Two faces above the edge
+    EXPECT_EQ(stats[event::bfs_up].max, 2);
+    EXPECT_EQ(spans, stats[event::create_node].count +
+                         stats[event::remove_node].count);
+  } else {
+    for (const auto &e : stats.events) {
+      EXPECT_EQ(e.count, 0);
+    }
+    EXPECT_EQ(spans, 0);
+  }
+
+  casc::stats::record(event::btree_split, 7);
+  casc::stats::record(event::btree_split, 3);
+  stats = casc::stats::snapshot();
+  EXPECT_EQ(stats[event::btree_split].count, 2);
+  EXPECT_EQ(stats[event::btree_split].max, 7);
+  EXPECT_DOUBLE_EQ(stats[event::btree_split].mean(), 5.0);
+  EXPECT_STREQ(casc::stats::name(event::decimate_insertion),
+               "decimate_insertion");
+
+#ifdef CASC_ENABLE_PARALLEL
+  // Counters of other threads are summed, also after the threads exit
+  std::vector<std::thread> threads;
+  for (std::uint64_t t = 1; t <= 4; ++t) {
+    threads.emplace_back([t] {
+      for (int i = 0; i < 1000; ++i) {
+        casc::stats::record(event::btree_merge, t);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  stats = casc::stats::snapshot();
+  EXPECT_EQ(stats[event::btree_merge].count, 4000);
+  EXPECT_EQ(stats[event::btree_merge].total, 10000);
+  EXPECT_EQ(stats[event::btree_merge].max, 4);
+#endif
+
+  casc::stats::set_span_callback(nullptr);
+  casc::stats::reset();
+  EXPECT_EQ(casc::stats::snapshot()[event::btree_split].count, 0);
+  EXPECT_EQ(casc::stats::snapshot()[event::btree_merge].count, 0);
+}
+
+TEST(CASCTest, ParallelSort) {
+  std::vector<int> v(100000);
+  std::srand(7);
+  for (auto &x : v) {
+    x = std::rand();
+  }
+  auto expected = v;
+  std::sort(expected.begin(), expected.end());
+  casc::parallel::set_num_threads(3);
+  casc::parallel::sort(v.begin(), v.end(), std::less<int>(), 1000);
+  casc::parallel::set_num_threads(0);
+  EXPECT_EQ(expected, v);
+}
+
+// The per-thread cache of recycling_allocator is bounded
+TEST(CASCTest, RecyclingAllocatorBound) {
+  using cache = casc::node_pool_detail::block_cache;
+  casc::recycling_allocator<std::array<char, 64>> small;
+  std::vector<std::array<char, 64> *> blocks;
+  for (int i = 0; i < 10000; ++i) {
+    blocks.push_back(small.allocate(1));
+  }
+  for (auto p : blocks) {
+    small.deallocate(p, 1);
+  }
+  casc::recycling_allocator<char> large;
+  large.deallocate(large.allocate(4096), 4096);
+
+  const std::size_t limit = cache::max_class_bytes;
+  std::size_t bytes = 0;
+  auto &c = casc::node_pool_detail::thread_cache();
+  for (std::size_t i = 0; i < cache::classes; ++i) {
+    EXPECT_LE(c.size[i] * c.count[i], limit);
+    EXPECT_NE(c.size[i] * (c.count[i] > 0), 4096u);
+    bytes += c.size[i] * c.count[i];
+  }
+  EXPECT_GT(bytes, 0u);
+  casc::release_recycled_blocks();
+  for (std::size_t i = 0; i < cache::classes; ++i) {
+    EXPECT_EQ(c.count[i], 0u);
+  }
+}
+
+TEST(CASCTest, RecyclingAllocatorOverflow) {
+  casc::recycling_allocator<std::array<char, 64>> small;
+  const std::size_t n = small.max_size() + 1;
+  EXPECT_THROW(small.allocate(n), std::bad_array_new_length);
+  EXPECT_THROW(small.allocate(std::size_t(-1)), std::bad_alloc);
+}
@@ -20,8 +20,10 @@
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
+#include <limits>
 #include <map>
 #include <set>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -52,6 +54,17 @@ protected:
   using SimplexSet = typename casc::SimplexSet<SurfaceMeshType>;
 };
 
+/// Triangulated grid of (n-1)x(n-1) quads, vertex i*n + j at row i.
+template <typename Complex> void insert_grid(Complex &mesh, int n) {
+  for (int i = 0; i + 1 < n; ++i) {
+    for (int j = 0; j + 1 < n; ++j) {
+      int a = i * n + j;
+      mesh.insert({a, a + 1, a + n + 1});
+      mesh.insert({a, a + n, a + n + 1});
+    }
+  }
+}
+
 // template <typename T, std::size_t k>
 // std::ostream& operator<<(std::ostream& out, const std::array<T,k>& A)
 // {
@@ -217,3 +230,254 @@ TEST_F(DecimationTest, BoundaryCheck) {
   EXPECT_EQ(mesh.onBoundary(mesh.get_simplex_up({0, 1, 6})), true);
   EXPECT_EQ(mesh.nearBoundary(mesh.get_simplex_up({0, 1, 6})), true);
 }
+
+/// Store the sum of the merged vertex data on the new vertex.
+template <typename Complex> struct SumCallback {
+  using SimplexSet = typename casc::SimplexSet<Complex>;
+  using KeyType = typename Complex::KeyType;
+
+  int operator()(Complex &, const std::array<KeyType, 1> &,
+                 const SimplexSet &merged) {
+    int sum = 0;
+    for (auto v : casc::get<1>(merged)) {
+      sum += *v;
+    }
+    return sum;
+  }
+
+  template <std::size_t k>
+  int operator()(Complex &, const std::array<KeyType, k> &,
+                 const SimplexSet &) {
+    return 0;
+  }
+};
+
+TEST(DecimationBatchTest, MatchesSequential) {
+  // Triangulated 8x8 grid of quads
+  const int n = 9;
+  auto build = [n](SurfaceMeshType &mesh) {
+    insert_grid(mesh, n);
+    for (auto v : mesh.get_level_id<1>()) {
+      *v = mesh.get_name(v)[0];
+    }
+  };
+  SurfaceMeshType batch, sequential;
+  build(batch);
+  build(sequential);
+
+  std::vector<SurfaceMeshType::SimplexID<2>> edges;
+  for (auto e : batch.get_level_id<2>()) {
+    edges.push_back(e);
+  }
+  casc::parallel::set_num_threads(4);
+  auto count =
+      casc::decimate_batch(batch, edges, SumCallback<SurfaceMeshType>());
+  casc::parallel::set_num_threads(0);
+  EXPECT_GT(count, 0);
+
+  // Vertices of different chosen edges are never adjacent
+  std::vector<std::array<int, 2>> chosen;
+  for (auto e : sequential.get_level_id<2>()) {
+    auto name = sequential.get_name(e);
+    if (!batch.exists({name[0]}) && !batch.exists({name[1]})) {
+      chosen.push_back(name);
+    }
+  }
+  EXPECT_EQ(chosen.size(), count);
+
+  for (auto name : chosen) {
+    casc::decimate(sequential, sequential.get_simplex_up(name),
+                   SumCallback<SurfaceMeshType>());
+  }
+  EXPECT_EQ(batch.size<1>(), sequential.size<1>());
+  EXPECT_EQ(batch.size<2>(), sequential.size<2>());
+  EXPECT_EQ(batch.size<3>(), sequential.size<3>());
+
+  std::multiset<int> batchData, sequentialData;
+  for (auto v : batch.get_level<1>()) {
+    batchData.insert(v);
+  }
+  for (auto v : sequential.get_level<1>()) {
+    sequentialData.insert(v);
+  }
+  EXPECT_EQ(batchData, sequentialData);
+
+  // Collapsing edges of a disk keeps it a disk
+  EXPECT_EQ(int(batch.size<1>()) - int(batch.size<2>()) +
+                int(batch.size<3>()),
+            1);
+}
+
+/// Keep the boundary flag of the merged vertices.
+template <typename Complex> struct MaxCallback {
+  using SimplexSet = typename casc::SimplexSet<Complex>;
+  using KeyType = typename Complex::KeyType;
+
+  int operator()(Complex &, const std::array<KeyType, 1> &,
+                 const SimplexSet &merged) {
+    int rval = 0;
+    for (auto v : casc::get<1>(merged)) {
+      rval = std::max(rval, *v);
+    }
+    return rval;
+  }
+
+  template <std::size_t k>
+  int operator()(Complex &, const std::array<KeyType, k> &,
+                 const SimplexSet &) {
+    return 0;
+  }
+};
+
+TEST(DecimationByCostTest, StopsAtTarget) {
+  // Triangulated 8x8 grid of quads, boundary vertices store 1
+  const int n = 9;
+  SurfaceMeshType mesh;
+  insert_grid(mesh, n);
+  for (auto v : mesh.get_level_id<1>()) {
+    int k = mesh.get_name(v)[0];
+    *v = k < n || k >= n * (n - 1) || k % n == 0 || k % n == n - 1;
+  }
+
+  // Prefer edges between nearby keys, never touch the boundary
+  auto cost = [](SurfaceMeshType &F, SurfaceMeshType::SimplexID<2> e) {
+    auto name = F.get_name(e);
+    if (*F.get_simplex_up({name[0]}) || *F.get_simplex_up({name[1]})) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return double(std::abs(name[0] - name[1]));
+  };
+  const std::size_t faces = mesh.size<3>();
+  auto collapsed = casc::decimate_by_cost(mesh, faces / 2, cost,
+                                          MaxCallback<SurfaceMeshType>());
+  EXPECT_EQ(faces - mesh.size<3>(), 2 * collapsed);
+  EXPECT_LE(mesh.size<3>(), faces / 2);
+
+  // The boundary is untouched
+  std::size_t boundary = 0;
+  for (auto v : mesh.get_level<1>()) {
+    boundary += v;
+  }
+  EXPECT_EQ(boundary, 4 * (n - 1));
+  EXPECT_EQ(mesh.size<1>() + collapsed, n * n);
+}
+
+TEST(DecimationContextTest, MatchesDecimate) {
+  // Triangulated 6x6 grid of quads
+  const int n = 7;
+  auto build = [n](SurfaceMeshType &mesh) {
+    insert_grid(mesh, n);
+    for (auto v : mesh.get_level_id<1>()) {
+      *v = mesh.get_name(v)[0];
+    }
+  };
+  SurfaceMeshType reused, fresh;
+  build(reused);
+  build(fresh);
+
+  // Collapse the interior edges along the middle row one at a time
+  casc::decimation_context<SurfaceMeshType> ctx;
+  const int row = n / 2;
+  for (int j = 1; j + 2 < n; j += 2) {
+    std::array<int, 2> name = {row * n + j, row * n + j + 1};
+    ASSERT_NE(reused.get_simplex_up(name), nullptr);
+    casc::decimate(reused, reused.get_simplex_up(name),
+                   SumCallback<SurfaceMeshType>(), ctx);
+    casc::decimate(fresh, fresh.get_simplex_up(name),
+                   SumCallback<SurfaceMeshType>());
+    EXPECT_GT(casc::get<2>(ctx.simplexMap).size(), 0);
+  }
+  EXPECT_EQ(reused.size<1>(), fresh.size<1>());
+  EXPECT_EQ(reused.size<2>(), fresh.size<2>());
+  EXPECT_EQ(reused.size<3>(), fresh.size<3>());
+  std::multiset<int> reusedData, freshData;
+  for (auto v : reused.get_level<1>()) {
+    reusedData.insert(v);
+  }
+  for (auto v : fresh.get_level<1>()) {
+    freshData.insert(v);
+  }
+  EXPECT_EQ(reusedData, freshData);
+
+  // The two halves of a decimation share the context
+  auto s = reused.get_simplex_up({1, 2});
+  auto np = casc::decimateFirstHalf(reused, s, ctx);
+  EXPECT_EQ(casc::get<1>(ctx.simplexMap).size(), 1);
+  EXPECT_EQ(casc::get<1>(ctx.simplexMap).begin()->first[0], np);
+  casc::run_user_callback(reused, ctx.simplexMap,
+                          SumCallback<SurfaceMeshType>(), ctx.rv);
+  casc::decimateBackHalf(reused, ctx);
+  EXPECT_EQ(*reused.get_simplex_up({np}), 3);
+  EXPECT_FALSE(reused.exists({1}));
+
+  ctx.clear();
+  EXPECT_EQ(casc::get<1>(ctx.doomed).size(), 0);
+  EXPECT_EQ(casc::get<2>(ctx.simplexMap).size(), 0);
+  EXPECT_EQ(std::get<1>(ctx.rv).size(), 0);
+}
+
+struct OrientedTraits {
+  using KeyType = int;
+  using NodeTypes = util::type_holder<int, int, int, casc::Orientable>;
+  using EdgeTypes =
+      util::type_holder<casc::Orientable, casc::Orientable, casc::Orientable>;
+};
+using OrientedMesh = casc::simplicial_complex<OrientedTraits>;
+
+template <typename Complex> struct DefaultCallback {
+  using SimplexSet = typename casc::SimplexSet<Complex>;
+  using KeyType = typename Complex::KeyType;
+
+  template <std::size_t k>
+  typename Complex::template NodeData<k>
+  operator()(Complex &, const std::array<KeyType, k> &, const SimplexSet &) {
+    return typename Complex::template NodeData<k>();
+  }
+};
+
+TEST(ReorientRegionTest, MatchesFullSweep) {
+  OrientedMesh mesh;
+  const int n = 12;
+  insert_grid(mesh, n);
+  casc::compute_orientation(mesh);
+
+  casc::decimation_context<OrientedMesh> ctx;
+  for (int a : {13, 40, 77, 100}) {
+    auto s = mesh.get_simplex_up({a, a + 1});
+    ASSERT_NE(nullptr, s);
+    auto np = casc::decimateFirstHalf(mesh, s, ctx);
+    casc::run_user_callback(mesh, ctx.simplexMap,
+                            DefaultCallback<OrientedMesh>(), ctx.rv);
+    casc::decimateBackHalf(mesh, ctx);
+
+    casc::SimplexSet<OrientedMesh> region;
+    auto v = mesh.get_simplex_up({np});
+    casc::getStar(mesh, v, region);
+    auto rval = casc::reorient_region(mesh, region);
+    EXPECT_TRUE(std::get<0>(rval));
+    EXPECT_TRUE(std::get<1>(rval));
+
+    // A full sweep agrees up to the sign, the grid is a single component
+    auto swept = mesh.clone();
+    casc::compute_orientation(swept);
+    int flip = 0;
+    for (auto f : mesh.get_level_id<3>()) {
+      auto g = swept.get_simplex_up(mesh.get_name(f));
+      ASSERT_NE(nullptr, g);
+      const int sign = (*f).orientation * (*g).orientation;
+      if (flip == 0) {
+        flip = sign;
+      }
+      EXPECT_NE(0, sign);
+      EXPECT_EQ(flip, sign);
+    }
+  }
+
+  // Every facet is oriented and consistent with its neighbors
+  for (auto f : mesh.get_level_id<3>()) {
+    EXPECT_NE(0, (*f).orientation);
+  }
+  auto check = casc::check_orientation(mesh);
+  EXPECT_TRUE(std::get<1>(check));
+  EXPECT_TRUE(std::get<2>(check));
+}
@@ -0,0 +1,329 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef CASC_ENABLE_PARALLEL
+#include <thread>
+#endif
+
+#include <casc/casc>
+
+#include "gtest/gtest.h"
+
+using SurfaceMeshType = casc::AbstractSimplicialComplex<int, // KEYTYPE
+                                                        int, // Root data
+                                                        int, // Vertex data
+                                                        int, // Edge data
+                                                        int  // Face data
+                                                        >;
+
+class FrozenComplexTest : public testing::Test {
+protected:
+  FrozenComplexTest() {}
+  ~FrozenComplexTest() {}
+  virtual void SetUp() {
+    mesh.insert({0, 1, 3}, 1);
+    mesh.insert({0, 3, 5}, 2);
+    mesh.insert({1, 3, 4}, 3);
+    mesh.insert({3, 4, 5}, 4);
+    mesh.insert({1, 2, 4}, 5);
+    mesh.insert({2, 4, 5}, 6);
+    for (auto v : mesh.get_level_id<1>()) {
+      *v = 10 * mesh.get_name(v)[0];
+    }
+    // Remove and reinsert to leave holes in the registries
+    mesh.remove({3, 4, 5});
+    mesh.insert({3, 4, 5}, 4);
+    *mesh.get_edge_up(mesh.get_simplex_up({3}), 4) = 34;
+  }
+  virtual void TearDown() {}
+
+  /// Collect the names of all simplices of a SimplexSet.
+  template <typename Complex, std::size_t k>
+  static std::set<std::array<int, k>>
+  names(const Complex &F, const casc::SimplexSet<Complex> &S) {
+    std::set<std::array<int, k>> rval;
+    for (auto s : casc::get<k>(S)) {
+      rval.insert(F.get_name(s));
+    }
+    return rval;
+  }
+
+  SurfaceMeshType mesh;
+};
+
+TEST_F(FrozenComplexTest, Structure) {
+  auto frozen = casc::freeze(mesh);
+  EXPECT_EQ(frozen.size<0>(), 1);
+  EXPECT_EQ(frozen.size<1>(), mesh.size<1>());
+  EXPECT_EQ(frozen.size<2>(), mesh.size<2>());
+  EXPECT_EQ(frozen.size<3>(), mesh.size<3>());
+
+  // Levels are numbered in the iteration order of the source
+  auto fit = frozen.get_level_id<2>().begin();
+  for (auto s : mesh.get_level_id<2>()) {
+    auto f = *fit++;
+    EXPECT_EQ(mesh.get_name(s), frozen.get_name(f));
+    EXPECT_EQ(mesh.get_cover(s), frozen.get_cover(f));
+    EXPECT_EQ(*s, *f);
+    EXPECT_EQ(f, frozen.get_simplex_up(mesh.get_name(s)));
+  }
+  for (auto s : mesh.get_level_id<3>()) {
+    auto f = frozen.get_simplex_up(mesh.get_name(s));
+    ASSERT_NE(f, nullptr);
+    EXPECT_EQ(*s, *f);
+    for (auto a : mesh.get_name(s)) {
+      EXPECT_EQ(mesh.get_name(mesh.get_simplex_down(s, a)),
+                frozen.get_name(frozen.get_simplex_down(f, a)));
+    }
+  }
+  EXPECT_EQ(*frozen.get_simplex_up({4}), 40);
+  EXPECT_EQ(frozen.get_simplex_up({0, 4}), nullptr);
+  EXPECT_TRUE(frozen.exists({1, 2}));
+  EXPECT_FALSE(frozen.exists({0, 2}));
+
+  auto edge = frozen.get_edge_up(frozen.get_simplex_up({3}), 4);
+  EXPECT_EQ(edge.key(), 4);
+  EXPECT_EQ(*edge, 34);
+  EXPECT_EQ(edge.up(), frozen.get_simplex_up({3, 4}));
+  EXPECT_EQ(edge.down(), frozen.get_simplex_up({3}));
+
+  std::vector<int> data;
+  for (auto d : frozen.get_level<3>()) {
+    data.push_back(d);
+  }
+  std::vector<int> expected;
+  for (auto d : mesh.get_level<3>()) {
+    expected.push_back(d);
+  }
+  EXPECT_EQ(data, expected);
+}
+
+TEST_F(FrozenComplexTest, Traversals) {
+  auto frozen = casc::freeze(mesh);
+  using Frozen = decltype(frozen);
+
+  casc::SimplexSet<SurfaceMeshType> star, link, closure;
+  casc::SimplexSet<Frozen> fstar, flink, fclosure;
+  auto s = mesh.get_simplex_up({3});
+  auto f = frozen.get_simplex_up({3});
+  casc::getStar(mesh, s, star);
+  casc::getStar(frozen, f, fstar);
+  EXPECT_EQ((names<SurfaceMeshType, 2>(mesh, star)),
+            (names<Frozen, 2>(frozen, fstar)));
+  EXPECT_EQ((names<SurfaceMeshType, 3>(mesh, star)),
+            (names<Frozen, 3>(frozen, fstar)));
+
+  casc::getLink(mesh, s, link);
+  casc::getLink(frozen, f, flink);
+  EXPECT_EQ((names<SurfaceMeshType, 1>(mesh, link)),
+            (names<Frozen, 1>(frozen, flink)));
+  EXPECT_EQ((names<SurfaceMeshType, 2>(mesh, link)),
+            (names<Frozen, 2>(frozen, flink)));
+
+  auto t = mesh.get_simplex_up({1, 2, 4});
+  auto ft = frozen.get_simplex_up({1, 2, 4});
+  casc::getClosure(mesh, t, closure);
+  casc::getClosure(frozen, ft, fclosure);
+  EXPECT_EQ((names<SurfaceMeshType, 1>(mesh, closure)),
+            (names<Frozen, 1>(frozen, fclosure)));
+  EXPECT_EQ((names<SurfaceMeshType, 2>(mesh, closure)),
+            (names<Frozen, 2>(frozen, fclosure)));
+
+  std::set<Frozen::SimplexID<1>> nbors;
+  casc::kneighbors_up(frozen, f, 1, nbors);
+  std::set<int> keys;
+  for (auto v : nbors) {
+    keys.insert(frozen.get_name(v)[0]);
+  }
+  EXPECT_EQ(keys, (std::set<int>{0, 1, 4, 5}));
+}
+
+TEST_F(FrozenComplexTest, Copy) {
+  auto frozen = casc::freeze(mesh);
+  auto copy = frozen;
+  EXPECT_EQ(copy.size<2>(), frozen.size<2>());
+  EXPECT_EQ(*copy.get_simplex_up({2, 4, 5}), 6);
+  EXPECT_GT(frozen.bytes(), 0);
+}
+
+TEST_F(FrozenComplexTest, BinaryRoundTrip) {
+  const std::string filename = "frozen_complex_test.casc";
+  *mesh.get_simplex_up() = 7;
+  casc::writeBinary(filename, mesh);
+
+  auto mapped = casc::mapBinary<SurfaceMeshType>(filename);
+  std::ifstream in(filename, std::ios::binary);
+  auto read = decltype(mapped)::read(in);
+  for (const auto *F : {&mapped, &read}) {
+    EXPECT_EQ(F->size<1>(), mesh.size<1>());
+    EXPECT_EQ(F->size<2>(), mesh.size<2>());
+    EXPECT_EQ(F->size<3>(), mesh.size<3>());
+    EXPECT_EQ(*F->get_simplex_up(), 7);
+    for (auto s : mesh.get_level_id<3>()) {
+      auto f = F->get_simplex_up(mesh.get_name(s));
+      ASSERT_NE(f, nullptr);
+      EXPECT_EQ(*s, *f);
+    }
+    EXPECT_EQ(*F->get_edge_up(F->get_simplex_up({3}), 4), 34);
+  }
+  // Mapped snapshots do not own their arrays
+  EXPECT_LT(mapped.bytes(), read.bytes());
+
+  auto restored = casc::readBinary<SurfaceMeshType>(filename);
+  EXPECT_EQ(restored.size<1>(), mesh.size<1>());
+  EXPECT_EQ(restored.size<2>(), mesh.size<2>());
+  EXPECT_EQ(restored.size<3>(), mesh.size<3>());
+  EXPECT_EQ(*restored.get_simplex_up(), 7);
+  for (auto s : mesh.get_level_id<1>()) {
+    EXPECT_EQ(*s, *restored.get_simplex_up(mesh.get_name(s)));
+  }
+  for (auto s : mesh.get_level_id<2>()) {
+    auto r = restored.get_simplex_up(mesh.get_name(s));
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(mesh.get_cover(s), restored.get_cover(r));
+  }
+  EXPECT_EQ(*restored.get_edge_up(restored.get_simplex_up({3}), 4), 34);
+  std::remove(filename.c_str());
+}
+
+TEST_F(FrozenComplexTest, BinaryErrors) {
+  const std::string filename = "frozen_complex_errors.casc";
+  casc::writeBinary(filename, mesh);
+
+  // The stored types must match
+  using OtherType = casc::AbstractSimplicialComplex<int, int, double, int, int>;
+  EXPECT_THROW(casc::mapBinary<OtherType>(filename), std::runtime_error);
+  // Even if they have the same size
+  using FloatType = casc::AbstractSimplicialComplex<int, int, float, int, int>;
+  EXPECT_THROW(casc::mapBinary<FloatType>(filename), std::runtime_error);
+
+  std::string contents;
+  {
+    std::ifstream in(filename, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+  }
+  using Frozen = casc::frozen_complex<SurfaceMeshType>;
+  {
+    std::istringstream truncated(contents.substr(0, contents.size() / 2));
+    EXPECT_THROW(Frozen::read(truncated), std::runtime_error);
+  }
+  {
+    std::string bad = contents;
+    bad[0] = 'X';
+    std::istringstream in(bad);
+    EXPECT_THROW(Frozen::read(in), std::runtime_error);
+  }
+  // Locate the arrays of the edges
+  casc::frozen_detail::binary_level edges;
+  std::memcpy(&edges,
+              contents.data() + sizeof(casc::frozen_detail::binary_header) +
+                  2 * sizeof(edges),
+              sizeof(edges));
+  const auto corrupt = [&](std::size_t array, std::size_t i,
+                           std::uint32_t value) {
+    std::string bad = contents;
+    std::memcpy(&bad[edges.sections[array].offset + i * sizeof(value)],
+                &value, sizeof(value));
+    std::istringstream in(bad);
+    EXPECT_THROW(Frozen::read(in), std::runtime_error);
+  };
+  // Face index past the vertices
+  corrupt(1, 0, 1000);
+  // Decreasing coface offsets
+  corrupt(2, 1, 1000);
+  // Coface index past the faces
+  corrupt(4, 0, 1000);
+  std::remove(filename.c_str());
+}
+
+TEST_F(FrozenComplexTest, Snapshots) {
+  casc::frozen_publisher<SurfaceMeshType> snapshots;
+  EXPECT_EQ(snapshots.pin(), nullptr);
+  EXPECT_EQ(snapshots.publish(casc::freeze(mesh)), 1u);
+  auto first = snapshots.pin();
+  ASSERT_NE(first, nullptr);
+
+  // The pinned snapshot is unaffected by later changes and publications
+  mesh.remove({5});
+  EXPECT_EQ(snapshots.publish(casc::freeze(mesh)), 2u);
+  EXPECT_EQ(snapshots.epoch(), 2u);
+  EXPECT_EQ(first->size<1>(), 6u);
+  EXPECT_EQ(*first->get_simplex_up({3, 4, 5}), 4);
+  EXPECT_EQ(snapshots.pin()->size<1>(), 5u);
+  EXPECT_FALSE(snapshots.pin()->exists({3, 4, 5}));
+
+  // Retired snapshots are destroyed once no reader pins them
+  EXPECT_EQ(snapshots.retired(), 1u);
+  EXPECT_EQ(snapshots.collect(), 1u);
+  std::weak_ptr<const casc::frozen_complex<SurfaceMeshType>> watch = first;
+  first.reset();
+  EXPECT_FALSE(watch.expired());
+  EXPECT_EQ(snapshots.collect(), 0u);
+  EXPECT_TRUE(watch.expired());
+}
+
+#ifdef CASC_ENABLE_PARALLEL
+TEST_F(FrozenComplexTest, ConcurrentSnapshots) {
+  casc::frozen_publisher<SurfaceMeshType> snapshots(casc::freeze(mesh));
+  std::atomic<bool> running(true);
+  std::atomic<bool> consistent(true);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      while (running) {
+        auto F = snapshots.pin();
+        // Every face of a snapshot has its three edges
+        for (auto f : F->get_level_id<3>()) {
+          auto name = F->get_name(f);
+          const int e[2] = {name[0], name[2]};
+          if (!F->exists(e)) {
+            consistent = false;
+          }
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 200; ++i) {
+    const int v = 6 + i;
+    mesh.insert({v, v + 1, v + 2});
+    if (i % 3 == 0) {
+      mesh.remove({v});
+    }
+    snapshots.publish(casc::freeze(mesh));
+  }
+  running = false;
+  for (auto &t : readers) {
+    t.join();
+  }
+  EXPECT_TRUE(consistent);
+  EXPECT_EQ(snapshots.collect(), 0u);
+}
+#endif
@@ -0,0 +1,190 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <casc/casc>
+
+struct oriented_traits {
+  using KeyType = int;
+  using NodeTypes = util::type_holder<int, int, int, casc::Orientable>;
+  using EdgeTypes =
+      util::type_holder<casc::Orientable, casc::Orientable, casc::Orientable>;
+};
+using OrientedMesh = casc::simplicial_complex<oriented_traits>;
+using PlainMesh = casc::AbstractSimplicialComplex<int, int, int, int, int>;
+
+/// Insert a closed octahedron and a disk of six triangles around vertex 10.
+template <typename Complex> void make_mesh(Complex &F) {
+  F.insert({0, 1, 2});
+  F.insert({0, 2, 3});
+  F.insert({0, 3, 4});
+  F.insert({0, 4, 1});
+  F.insert({5, 1, 2});
+  F.insert({5, 2, 3});
+  F.insert({5, 3, 4});
+  F.insert({5, 4, 1});
+  for (int i = 0; i < 6; ++i) {
+    F.insert({10, 11 + i, 11 + (i + 1) % 6});
+  }
+  F.insert({11, 12, 20});
+}
+
+/// Check the connectivity of a view against its complex.
+template <typename Complex>
+void check_view(const Complex &F, const casc::halfedge_view<Complex> &he) {
+  using View = casc::halfedge_view<Complex>;
+  ASSERT_EQ(he.vertex_count(), F.template size<1>());
+  ASSERT_EQ(he.face_count(), F.template size<3>());
+  ASSERT_EQ(he.halfedge_count(), 3 * F.template size<3>());
+  for (std::uint32_t f = 0; f < he.face_count(); ++f) {
+    EXPECT_EQ(he.face(he.face_id(f)), f);
+    for (auto h = View::halfedge(f); h < View::halfedge(f) + 3; ++h) {
+      EXPECT_EQ(View::face(h), f);
+      EXPECT_EQ(View::prev(View::next(h)), h);
+      const auto t = he.twin(h);
+      if (t != View::npos) {
+        // Neighbors traverse their shared edge in opposite directions
+        EXPECT_EQ(he.twin(t), h);
+        EXPECT_EQ(he.origin(t), he.target(h));
+        EXPECT_EQ(he.target(t), he.origin(h));
+      }
+    }
+  }
+  for (std::uint32_t v = 0; v < he.vertex_count(); ++v) {
+    EXPECT_EQ(he.vertex(he.vertex_id(v)), v);
+    EXPECT_EQ(he.key(v), F.get_name(he.vertex_id(v))[0]);
+    auto ring = he.one_ring(v);
+    auto cover = F.get_cover(he.vertex_id(v));
+    ASSERT_EQ(ring.size(), cover.size());
+    // Consecutive neighbors span a face with v
+    const std::size_t n = he.is_boundary_vertex(v) ? ring.size() - 1
+                                                   : ring.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      const int s[3] = {he.key(v), he.key(ring[i]),
+                        he.key(ring[(i + 1) % ring.size()])};
+      EXPECT_TRUE(F.exists(s));
+    }
+  }
+}
+
+TEST(HalfedgeTest, OrientedByView) {
+  PlainMesh F;
+  make_mesh(F);
+  casc::halfedge_view<PlainMesh> he(F);
+  check_view(F, he);
+
+  // Only the disk and the extra triangle are on the boundary
+  for (std::uint32_t v = 0; v < he.vertex_count(); ++v) {
+    EXPECT_EQ(he.is_boundary_vertex(v), he.key(v) > 10) << he.key(v);
+  }
+  const int apex[1] = {10};
+  auto ring = he.one_ring(he.vertex(F.get_simplex_up(apex)));
+  ASSERT_EQ(ring.size(), 6u);
+  // The ring is a rotation of 11..16 in one of the two directions
+  auto first = std::find_if(ring.begin(), ring.end(), [&](std::uint32_t w) {
+    return he.key(w) == 11;
+  });
+  std::rotate(ring.begin(), first, ring.end());
+  const int step = he.key(ring[1]) == 12 ? 1 : 5;
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(he.key(ring[i]), 11 + (i * step) % 6);
+  }
+
+  const int f[3] = {11, 12, 20};
+  auto nbors = he.face_neighbors(he.face(F.get_simplex_up(f)));
+  EXPECT_EQ(std::count(nbors.begin(), nbors.end(),
+                       casc::halfedge_view<PlainMesh>::npos),
+            2);
+}
+
+TEST(HalfedgeTest, StoredOrientation) {
+  OrientedMesh F;
+  make_mesh(F);
+  casc::compute_orientation(F);
+  casc::halfedge_view<OrientedMesh> he(F);
+  check_view(F, he);
+  for (std::uint32_t f = 0; f < he.face_count(); ++f) {
+    EXPECT_EQ(he.orientation(f), (*he.face_id(f)).orientation);
+    // Orientation -1 walks the sorted name
+    auto name = F.get_name(he.face_id(f));
+    const auto h = decltype(he)::halfedge(f);
+    if (he.orientation(f) == 1) {
+      std::reverse(name.begin(), name.end());
+    }
+    for (std::uint32_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(he.key(he.origin(h + i)), name[i]);
+    }
+  }
+}
+
+TEST(HalfedgeTest, Sync) {
+  PlainMesh F;
+  make_mesh(F);
+  casc::halfedge_view<PlainMesh> he(F);
+  EXPECT_FALSE(he.stale());
+  EXPECT_FALSE(he.sync());
+  F.insert({12, 13, 21});
+  EXPECT_TRUE(he.stale());
+  EXPECT_TRUE(he.sync());
+  EXPECT_FALSE(he.stale());
+  check_view(F, he);
+  F.remove({21});
+  EXPECT_TRUE(he.sync());
+  check_view(F, he);
+  EXPECT_EQ(he.face_count(), 15u);
+
+  // Batched removal also makes the view stale
+  casc::SimplexSet<PlainMesh> doomed;
+  doomed.insert(F.get_simplex_up({20}));
+  EXPECT_EQ(F.remove_batch(doomed), 4u);
+  EXPECT_TRUE(he.stale());
+  EXPECT_TRUE(he.sync());
+  check_view(F, he);
+  EXPECT_EQ(he.face_count(), 14u);
+}
+
+TEST(HalfedgeTest, NonManifold) {
+  PlainMesh F;
+  make_mesh(F);
+  F.insert({0, 1, 30});
+  EXPECT_THROW(casc::halfedge_view<PlainMesh> he(F), std::invalid_argument);
+
+  // Two triangles touching at a vertex
+  PlainMesh G;
+  G.insert({0, 1, 2});
+  G.insert({0, 3, 4});
+  EXPECT_THROW(casc::halfedge_view<PlainMesh> he(G), std::invalid_argument);
+
+  // Faces stored with inconsistent orientations
+  OrientedMesh H;
+  H.insert({0, 1, 2}, casc::Orientable{1});
+  H.insert({1, 2, 3}, casc::Orientable{1});
+  EXPECT_THROW(casc::halfedge_view<OrientedMesh> he(H),
+               std::invalid_argument);
+  (*H.get_simplex_up({1, 2, 3})).orientation = -1;
+  casc::halfedge_view<OrientedMesh> he(H);
+  check_view(H, he);
+}
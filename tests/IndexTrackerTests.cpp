@@ -17,6 +17,12 @@
 // Floor, Boston, MA 02110-1301 USA
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <vector>
+
 #include <casc/casc>
 
 // Tests factorial of positive numbers.
@@ -29,3 +35,141 @@ TEST(IntervalTest, GeneralOperation) {
     idx.insert(2 * i);
   }
 }
+
+TEST(IntervalTest, RangeOperations) {
+  index_tracker::index_tracker<int> idx;
+  std::set<int> used;
+  std::srand(7);
+  for (int round = 0; round < 2000; ++round) {
+    int a = std::rand() % 5000;
+    int b = a + std::rand() % 40;
+    switch (std::rand() % 4) {
+    case 0:
+      idx.remove_range(a, b);
+      for (int x = a; x < b; ++x)
+        used.insert(x);
+      break;
+    case 1:
+      idx.insert_range(a, b);
+      for (int x = a; x < b; ++x)
+        used.erase(x);
+      break;
+    case 2:
+      idx.remove(a);
+      used.insert(a);
+      break;
+    default:
+      idx.insert(a);
+      used.erase(a);
+    }
+  }
+  for (int x = 0; x < 5100; ++x) {
+    ASSERT_EQ(used.count(x) == 0, idx.has(x)) << x;
+  }
+
+  // Taking indices returns the smallest available ones first
+  std::vector<int> keys;
+  idx.pop(100, std::back_inserter(keys));
+  ASSERT_EQ(100, keys.size());
+  for (int x : keys) {
+    EXPECT_FALSE(idx.has(x));
+    EXPECT_EQ(0, used.count(x));
+    used.insert(x);
+  }
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+  auto block = idx.reserve(64);
+  EXPECT_EQ(64, block.size());
+  for (int x = block.lower(); x < block.upper(); ++x) {
+    EXPECT_EQ(0, used.count(x));
+    EXPECT_FALSE(idx.has(x));
+  }
+}
+
+TEST(IntervalTest, BatchRemoval) {
+  index_tracker::index_tracker<int> idx;
+  std::vector<int> keys = {0, 1, 2, 3, 7, 8, 9, 20};
+  idx.remove(keys.begin(), keys.end());
+  for (int x = 0; x < 25; ++x) {
+    bool used = std::find(keys.begin(), keys.end(), x) != keys.end();
+    EXPECT_EQ(!used, idx.has(x));
+  }
+  idx.insert(keys.begin() + 4, keys.end());
+  EXPECT_TRUE(idx.has(8));
+  EXPECT_FALSE(idx.has(3));
+}
+
+TEST(IntervalTest, LargestIndex) {
+  // The largest index is the exclusive bound and never available
+  const int max = std::numeric_limits<int>::max();
+  index_tracker::index_tracker<int> idx;
+  EXPECT_TRUE(idx.has(max - 1));
+  EXPECT_FALSE(idx.has(max));
+  idx.remove_range(max - 2, max);
+  EXPECT_TRUE(idx.has(max - 3));
+  EXPECT_FALSE(idx.has(max - 1));
+  EXPECT_FALSE(idx.has(max));
+}
+
+TEST(IntervalTest, Copy) {
+  index_tracker::index_tracker<int, 2> idx;
+  // Enough disjoint intervals to split the B-tree several times
+  for (int x = 0; x < 200; x += 2) {
+    idx.remove(x);
+  }
+  auto copy = idx;
+  copy.insert(10);
+  idx.remove(11);
+  for (int x = 0; x < 200; ++x) {
+    EXPECT_EQ(x % 2 == 1 && x != 11, idx.has(x));
+    EXPECT_EQ(x % 2 == 1 || x == 10, copy.has(x));
+  }
+  copy = idx;
+  EXPECT_FALSE(copy.has(10));
+  EXPECT_FALSE(copy.has(11));
+}
+
+TEST(IntervalTest, Concurrent) {
+  index_tracker::concurrent_index_tracker<int> ids(32);
+  ids.remove_range(0, 1000);
+  const std::size_t n = 10000;
+  std::vector<int> keys(n);
+  casc::parallel::for_chunks(
+      n, 500, [&](std::size_t, std::size_t b, std::size_t e) {
+        auto local = ids.make_local();
+        for (std::size_t i = b; i < e; ++i) {
+          keys[i] = local.pop();
+          // Return and retake some keys
+          if (i % 3 == 0) {
+            local.insert(keys[i]);
+            keys[i] = local.pop();
+          }
+        }
+      });
+  std::set<int> unique(keys.begin(), keys.end());
+  EXPECT_EQ(n, unique.size());
+  EXPECT_GE(*unique.begin(), 1000);
+  for (int x : keys) {
+    EXPECT_FALSE(ids.has(x));
+  }
+
+  // Unused reservations went back to the shared tracker
+  auto local = ids.make_local();
+  for (int x : keys)
+    local.insert(x);
+  local.flush();
+  for (int x = 1000; x < 1000 + static_cast<int>(n); ++x) {
+    EXPECT_TRUE(ids.has(x));
+  }
+}
+
+TEST(IntervalTest, AddVertices) {
+  casc::AbstractSimplicialComplex<int, int, int, int, int> mesh;
+  int faces[] = {0, 1, 2, 1, 2, 3, 5, 6, 7};
+  mesh.bulk_insert<3>(faces, 3);
+  std::vector<int> keys;
+  mesh.add_vertices(3, std::back_inserter(keys));
+  EXPECT_EQ((std::vector<int>{4, 8, 9}), keys);
+  EXPECT_EQ(10, mesh.size<1>());
+  EXPECT_EQ(10, mesh.add_vertex());
+}
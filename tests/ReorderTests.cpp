@@ -0,0 +1,181 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <casc/casc>
+
+using GridType = casc::AbstractSimplicialComplex<int, // KEYTYPE
+                                                 int, // Root data
+                                                 int, // Vertex data
+                                                 int, // Edge data
+                                                 int  // Face data
+                                                 >;
+
+class ReorderTest : public testing::Test {
+protected:
+  static constexpr int n = 12;
+
+  ReorderTest() {}
+  ~ReorderTest() {}
+  virtual void SetUp() {
+    // Triangulated n x n grid of points with shuffled keys
+    key.resize(n * n);
+    std::iota(key.begin(), key.end(), 0);
+    std::shuffle(key.begin(), key.end(), std::mt19937(7));
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        mesh.insert({key[i * n + j]}, i * n + j);
+      }
+    }
+    for (int i = 0; i + 1 < n; ++i) {
+      for (int j = 0; j + 1 < n; ++j) {
+        const int a = key[i * n + j], b = key[i * n + j + 1];
+        const int c = key[(i + 1) * n + j], d = key[(i + 1) * n + j + 1];
+        mesh.insert({a, b, d}, i * n + j + 1);
+        mesh.insert({a, c, d}, -(i * n + j + 1));
+      }
+    }
+    for (auto e : mesh.get_level_id<2>()) {
+      auto name = mesh.get_name(e);
+      *e = name[0] + name[1];
+      *mesh.get_edge_down(e, name[0]) = name[1];
+    }
+    *mesh.get_simplex_up() = 42;
+  }
+  virtual void TearDown() {}
+
+  /// Largest difference of the keys of the endpoints of any edge
+  int bandwidth() const {
+    int bw = 0;
+    for (auto e : mesh.get_level_id<2>()) {
+      auto name = mesh.get_name(e);
+      bw = std::max(bw, std::abs(name[1] - name[0]));
+    }
+    return bw;
+  }
+
+  /// Check that the renumbered mesh matches the original through perm
+  void check(const std::vector<int> &perm) {
+    ASSERT_EQ(perm.size(), static_cast<std::size_t>(n * n));
+    std::vector<int> sorted(perm);
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < n * n; ++i) {
+      EXPECT_EQ(sorted[i], i);
+    }
+    // Position in the grid of each old key
+    std::vector<int> pos(n * n);
+    for (int i = 0; i < n * n; ++i) {
+      pos[key[i]] = i;
+    }
+    EXPECT_EQ(mesh.size<1>(), static_cast<std::size_t>(n * n));
+    EXPECT_EQ(mesh.size<3>(), static_cast<std::size_t>(2 * (n - 1) * (n - 1)));
+    EXPECT_EQ(*mesh.get_simplex_up(), 42);
+    for (int v = 0; v < n * n; ++v) {
+      EXPECT_EQ(*mesh.get_simplex_up({v}), pos[perm[v]]);
+    }
+    for (auto e : mesh.get_level_id<2>()) {
+      auto name = mesh.get_name(e);
+      const int a = perm[name[0]], b = perm[name[1]];
+      EXPECT_EQ(*e, a + b);
+      // The edge data was set on the edge down from the smaller old key
+      if (a < b) {
+        EXPECT_EQ(*mesh.get_edge_down(e, name[0]), b);
+      } else {
+        EXPECT_EQ(*mesh.get_edge_down(e, name[1]), a);
+      }
+    }
+    for (auto f : mesh.get_level_id<3>()) {
+      auto name = mesh.get_name(f);
+      std::array<int, 3> p;
+      for (int i = 0; i < 3; ++i) {
+        p[i] = pos[perm[name[i]]];
+      }
+      std::sort(p.begin(), p.end());
+      const int cell = (p[0] / n) * n + p[0] % n;
+      EXPECT_EQ(std::abs(*f), cell + 1);
+      EXPECT_EQ(*f >= 0, p[1] == p[0] + 1);
+    }
+  }
+
+  std::vector<int> key;
+  GridType mesh;
+};
+
+constexpr int ReorderTest::n;
+
+TEST_F(ReorderTest, ReverseCuthillMcKee) {
+  const int before = bandwidth();
+  auto perm = casc::reorder(mesh, casc::rcm_order());
+  check(perm);
+  // The bandwidth of a grid is one row and a diagonal
+  EXPECT_LE(bandwidth(), n + 1);
+  EXPECT_LT(bandwidth(), before);
+}
+
+TEST_F(ReorderTest, BreadthFirst) {
+  auto perm = casc::reorder(mesh, casc::bfs_order());
+  check(perm);
+  EXPECT_LE(bandwidth(), 2 * n);
+  // Neighbors of the first vertex come next
+  auto nbors = mesh.get_cover(mesh.get_simplex_up({0}));
+  std::sort(nbors.begin(), nbors.end());
+  for (std::size_t i = 0; i < nbors.size(); ++i) {
+    EXPECT_EQ(nbors[i], static_cast<int>(i + 1));
+  }
+}
+
+TEST_F(ReorderTest, Hilbert) {
+  auto perm = casc::reorder(
+      mesh, casc::make_hilbert_order(
+                [](const GridType &, GridType::SimplexID<1> v) {
+                  const int i = *v;
+                  return std::array<double, 3>{
+                      {static_cast<double>(i / n),
+                       static_cast<double>(i % n), 0.0}};
+                }));
+  check(perm);
+  // Consecutive points along a Hilbert curve are mostly close in the grid
+  int jumps = 0;
+  for (int v = 0; v + 1 < n * n; ++v) {
+    const int a = *mesh.get_simplex_up({v}), b = *mesh.get_simplex_up({v + 1});
+    jumps += std::abs(a / n - b / n) + std::abs(a % n - b % n);
+  }
+  EXPECT_LT(jumps, 2 * n * n);
+}
+
+TEST_F(ReorderTest, InvalidOrder) {
+  std::vector<int> order(n * n - 1);
+  std::iota(order.begin(), order.end(), 0);
+  EXPECT_THROW(casc::renumber(mesh, order), std::invalid_argument);
+  order.push_back(0);
+  EXPECT_THROW(casc::renumber(mesh, order), std::invalid_argument);
+  order.back() = n * n;
+  EXPECT_THROW(casc::renumber(mesh, order), std::invalid_argument);
+  // The complex is unchanged
+  EXPECT_EQ(mesh.size<1>(), static_cast<std::size_t>(n * n));
+  EXPECT_EQ(*mesh.get_simplex_up({key[0]}), 0);
+}
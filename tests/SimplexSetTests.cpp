@@ -139,3 +139,66 @@ TEST_F(SimplexSetTest, SimplexSetComparisons) {
   EXPECT_TRUE(S != S2);
   EXPECT_TRUE(S2 != S);
 }
+
+struct FlatTraits
+    : casc::detail::simplicial_complex_traits_default<int, int, int, int, int,
+                                                      int> {
+  template <typename T> using SimplexSetContainer = casc::flat_set<T>;
+};
+using FlatMeshType = casc::simplicial_complex<FlatTraits>;
+
+/// Collect the names of a SimplexSet level to compare across complexes.
+template <std::size_t k, typename Complex>
+std::set<std::array<int, k>> level_names(Complex &F,
+                                         casc::SimplexSet<Complex> &S) {
+  std::set<std::array<int, k>> rval;
+  for (auto s : casc::get<k>(S))
+    rval.insert(F.get_name(s));
+  return rval;
+}
+
+TEST(FlatSimplexSetTest, MatchesNodeSet) {
+  TetMeshType hashed;
+  FlatMeshType flat;
+  for (int i = 3; i < 9; ++i) {
+    hashed.insert({1, 2, i, i + 1});
+    flat.insert({1, 2, i, i + 1});
+  }
+
+  casc::SimplexSet<TetMeshType> hStar, hLink, hClosure;
+  casc::SimplexSet<FlatMeshType> fStar, fLink, fClosure;
+  auto hs = hashed.get_simplex_up({1, 2});
+  auto fs = flat.get_simplex_up({1, 2});
+  casc::getStar(hashed, hs, hStar);
+  casc::getStar(flat, fs, fStar);
+  casc::getLink(hashed, hs, hLink);
+  casc::getLink(flat, fs, fLink);
+  casc::getClosure(hashed, hStar, hClosure);
+  casc::getClosure(flat, fStar, fClosure);
+
+  EXPECT_TRUE(std::is_sorted(fStar.begin<3>(), fStar.end<3>()));
+  EXPECT_EQ(6, fStar.size<4>());
+  EXPECT_EQ(7, fLink.size<1>());
+  EXPECT_EQ(6, fLink.size<2>());
+  EXPECT_EQ((level_names<1>(hashed, hLink)), (level_names<1>(flat, fLink)));
+  EXPECT_EQ((level_names<2>(hashed, hLink)), (level_names<2>(flat, fLink)));
+  EXPECT_EQ((level_names<3>(hashed, hStar)), (level_names<3>(flat, fStar)));
+  EXPECT_EQ((level_names<2>(hashed, hClosure)),
+            (level_names<2>(flat, fClosure)));
+
+  // Set algebra on the sorted levels, including writing into an operand
+  casc::SimplexSet<FlatMeshType> both, diff;
+  casc::set_intersection(fClosure, fLink, both);
+  EXPECT_TRUE(both == fLink);
+  casc::set_difference(fClosure, fLink, diff);
+  EXPECT_EQ(fClosure.size<1>() - fLink.size<1>(), diff.size<1>());
+  casc::set_union(diff, fLink, diff);
+  EXPECT_TRUE(diff == fClosure);
+  casc::set_difference(fLink, diff, diff);
+  EXPECT_TRUE(diff == fClosure);
+
+  EXPECT_FALSE(fLink.insert(flat.get_simplex_up({3})));
+  fLink.erase(flat.get_simplex_up({3}));
+  EXPECT_EQ(6, fLink.size<1>());
+  EXPECT_EQ(fLink.find(flat.get_simplex_up({3})), fLink.end<1>());
+}
@@ -0,0 +1,199 @@
+// This file is part of the Colored Abstract Simplicial Complex library.
+// Copyright (C) 2016-2021
+// by Christopher T. Lee, John Moody, Rommie Amaro, J. Andrew McCammon,
+//    and Michael Holst
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see <http://www.gnu.org/licenses/>
+// or write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+// Floor, Boston, MA 02110-1301 USA
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <casc/casc>
+
+#include "gtest/gtest.h"
+
+using casc::textio::buffered_reader;
+
+TEST(TextIOTest, Integers) {
+  std::istringstream in("12 -7\t+3\n# comment 99\n42/5 abc");
+  buffered_reader reader(in);
+  int v;
+  ASSERT_TRUE(reader.read_integer(v));
+  EXPECT_EQ(v, 12);
+  ASSERT_TRUE(reader.read_integer(v));
+  EXPECT_EQ(v, -7);
+  ASSERT_TRUE(reader.read_integer(v));
+  EXPECT_EQ(v, 3);
+  EXPECT_TRUE(reader.at_eol());
+  ASSERT_TRUE(reader.read_integer(v));
+  EXPECT_EQ(v, 42);
+  EXPECT_EQ(reader.get(), '/');
+  ASSERT_TRUE(reader.read_integer(v));
+  EXPECT_EQ(v, 5);
+  EXPECT_FALSE(reader.read_integer(v));
+  reader.skip_token();
+  EXPECT_TRUE(reader.eof());
+  EXPECT_EQ(reader.bytes_read(), in.str().size());
+
+  std::istringstream overflow("2147483648 -2147483648 -1");
+  buffered_reader r2(overflow);
+  EXPECT_FALSE(r2.read_integer(v));
+  std::int64_t w;
+  ASSERT_TRUE(r2.read_integer(w));
+  EXPECT_EQ(w, 2147483648);
+  ASSERT_TRUE(r2.read_integer(v));
+  EXPECT_EQ(v, -2147483647 - 1);
+  unsigned int u;
+  EXPECT_FALSE(r2.read_integer(u));
+}
+
+TEST(TextIOTest, Reals) {
+  const std::vector<std::string> tokens = {
+      "0",
+      "-0.5",
+      "3.14159265358979",
+      "1e10",
+      "2.5E-3",
+      ".125",
+      "7.",
+      "-1.0e+2",
+      "1e-30",
+      "123456789012345678901234",
+      "0.1000000000000000055511151231257827",
+      "1e400",
+      "nan",
+      "4.9e-324"};
+  std::string text;
+  for (const auto &t : tokens) {
+    text += t + "  \n";
+  }
+  std::istringstream in(text);
+  buffered_reader reader(in);
+  for (const auto &t : tokens) {
+    double v;
+    ASSERT_TRUE(reader.read_real(v)) << t;
+    const double expected = std::strtod(t.c_str(), nullptr);
+    if (expected != expected) {
+      EXPECT_NE(v, v) << t;
+    } else {
+      EXPECT_EQ(v, expected) << t;
+    }
+  }
+  double v;
+  EXPECT_FALSE(reader.read_real(v));
+  EXPECT_TRUE(reader.eof());
+}
+
+TEST(TextIOTest, SmallBuffer) {
+  // Tokens straddle buffer refills
+  std::string text = "OFF\n";
+  for (int i = 0; i < 2000; ++i) {
+    text += std::to_string(i) + " " + std::to_string(i) + ".25 # c\n";
+  }
+  std::istringstream in(text);
+  buffered_reader reader(in, 1);
+  char word[8];
+  EXPECT_EQ(reader.read_word(word, sizeof(word)), 3);
+  EXPECT_EQ(std::string(word), "OFF");
+  for (int i = 0; i < 2000; ++i) {
+    int k;
+    double x;
+    ASSERT_TRUE(reader.read_integer(k));
+    ASSERT_TRUE(reader.read_real(x));
+    EXPECT_EQ(k, i);
+    EXPECT_EQ(x, i + 0.25);
+    EXPECT_TRUE(reader.at_eol());
+    reader.skip_line();
+  }
+  EXPECT_TRUE(reader.eof());
+  EXPECT_EQ(reader.bytes_read(), text.size());
+}
+
+TEST(TextIOTest, WriteNumbers) {
+  std::ostringstream out;
+  {
+    casc::textio::buffered_writer writer(out);
+    writer.write_integer(0).put(' ').write_integer(-7).put(' ');
+    writer.write_integer(std::numeric_limits<std::int64_t>::min()).put(' ');
+    writer.write_integer(std::numeric_limits<std::uint64_t>::max());
+    writer.put('\n').write("x").write(std::string("yz"));
+  }
+  EXPECT_EQ(out.str(), "0 -7 -9223372036854775808 18446744073709551615\nxyz");
+
+  // Reals match an ostream with the same precision
+  const double values[] = {0.0,    -0.0,     1.0,     -3.0,   0.1,
+                           1.0 / 3, 123.456, 1e-300, 6.02e23, 1234567890.0,
+                           12345678901.0, -2.5e-5, 1e15, 4503599627370497.0};
+  for (int precision : {1, 6, 10, 17}) {
+    std::ostringstream expected, actual;
+    expected.precision(precision);
+    casc::textio::buffered_writer writer(actual);
+    writer.set_precision(precision);
+    for (double x : values) {
+      expected << x << ' ';
+      writer.write_real(x).put(' ');
+    }
+    writer.flush();
+    EXPECT_EQ(actual.str(), expected.str());
+  }
+}
+
+TEST(TextIOTest, WriteSmallBuffer) {
+  std::string expected;
+  for (int i = 0; i < 2000; ++i) {
+    expected += std::to_string(i) + " " + std::to_string(i) + ".25\n";
+  }
+  expected += std::string(300, 'a');
+  for (bool background : {false, true}) {
+    std::ostringstream out;
+    casc::textio::buffered_writer writer(out, 1, background);
+    for (int i = 0; i < 2000; ++i) {
+      writer.write_integer(i).put(' ').write_real(i + 0.25).put('\n');
+    }
+    writer.write(std::string(300, 'a'));
+    EXPECT_EQ(writer.bytes_written(), expected.size());
+    EXPECT_TRUE(writer.flush());
+    EXPECT_EQ(out.str(), expected);
+  }
+}
+
+TEST(TextIOTest, WriteParallel) {
+  std::ostringstream serial, chunked;
+  {
+    casc::textio::buffered_writer writer(serial);
+    writer.set_precision(6);
+    for (int i = 0; i < 10000; ++i) {
+      writer.write_integer(i).put(' ').write_real(i / 7.0).put('\n');
+    }
+  }
+  for (std::size_t threads : {1, 3}) {
+    casc::parallel::set_num_threads(threads);
+    std::ostringstream out;
+    {
+      casc::textio::buffered_writer writer(out, 4096, true);
+      writer.set_precision(6);
+      casc::textio::write_parallel(writer, 10000, 100,
+                                   [](auto &w, std::size_t i) {
+                                     w.write_integer(i).put(' ');
+                                     w.write_real(i / 7.0).put('\n');
+                                   });
+    }
+    EXPECT_EQ(out.str(), serial.str());
+  }
+  casc::parallel::set_num_threads(0);
+}
@@ -17,14 +17,19 @@
 // Floor, Boston, MA 02110-1301 USA
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <casc/casc>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <queue>
 #include <set>
+#include <vector>
 
 using SurfaceMeshType = casc::AbstractSimplicialComplex<int, // KEYTYPE
                                                         int, // Root data
@@ -176,3 +181,282 @@ TEST_F(CASCTraversalTest, kNeighbors) {
   EXPECT_EQ(nbors.size(), total);
   nbors.clear();
 }
+
+TEST_F(CASCTraversalTest, AdjacencyViews) {
+  auto v = mesh.get_simplex_up({0});
+  std::vector<int> keys;
+  for (auto a : mesh.cover_view(v)) {
+    keys.push_back(a);
+  }
+  EXPECT_EQ(keys, mesh.get_cover(v));
+  keys.clear();
+  for (auto a : v.cover_view()) {
+    keys.push_back(a);
+  }
+  EXPECT_EQ(keys, v.cover());
+
+  std::set<SurfaceMeshType::SimplexID<2>> edges;
+  for (auto e : mesh.up_view(v)) {
+    edges.insert(e);
+  }
+  EXPECT_EQ(edges, mesh.up(v));
+
+  auto f = mesh.get_simplex_up({0, 1, 2});
+  std::set<SurfaceMeshType::SimplexID<2>> faces;
+  for (auto e : mesh.down_view(f)) {
+    faces.insert(e);
+  }
+  EXPECT_EQ(faces, mesh.down(f));
+
+  // Multi-simplex up and down through inline sets
+  util::small_set<SurfaceMeshType::SimplexID<1>> verts;
+  mesh.down(mesh.down(f), std::inserter(verts, verts.end()));
+  EXPECT_EQ(verts.size(), 3);
+  auto star = mesh.up(mesh.up(verts));
+  std::set<SurfaceMeshType::SimplexID<3>> expected;
+  for (auto s : verts) {
+    for (auto e : mesh.up(s)) {
+      mesh.up(e, std::inserter(expected, expected.end()));
+    }
+  }
+  EXPECT_TRUE(std::equal(star.begin(), star.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST_F(CASCTraversalTest, kNeighborsDown) {
+  // Edges sharing a vertex are neighbors
+  auto e = mesh.get_simplex_up({0, 1});
+  std::set<SurfaceMeshType::SimplexID<2>> ring, expected;
+  casc::neighbors(mesh, e, std::inserter(expected, expected.end()));
+  casc::kneighbors(mesh, e, 1, ring);
+  EXPECT_EQ(ring, expected);
+}
+
+TEST(SmallSetTest, Spill) {
+  util::small_set<int, 4> s;
+  for (int v : {5, 3, 5, 9, 1, 7, 3, 2}) {
+    s.insert(v);
+  }
+  EXPECT_EQ(s.size(), 6);
+  EXPECT_EQ(std::vector<int>(s.begin(), s.end()),
+            (std::vector<int>{1, 2, 3, 5, 7, 9}));
+  EXPECT_EQ(s.count(7), 1);
+  EXPECT_EQ(s.count(4), 0);
+  EXPECT_FALSE(s.insert(9).second);
+
+  auto copy = s;
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  s.insert(4);
+  EXPECT_EQ(std::vector<int>(s.begin(), s.end()), std::vector<int>{4});
+  EXPECT_EQ(copy.size(), 6);
+}
+
+TEST_F(CASCTraversalTest, kNeighborsVector) {
+  std::vector<SurfaceMeshType::SimplexID<1>> ring;
+  for (auto v : mesh.get_level_id<1>()) {
+    for (int k = 0; k < 4; ++k) {
+      std::set<SurfaceMeshType::SimplexID<1>> expected;
+      casc::kneighbors_up(mesh, v, k, expected);
+      casc::kneighbors_up(mesh, v, k, ring);
+      EXPECT_EQ(ring.size(), expected.size());
+      EXPECT_EQ(std::set<SurfaceMeshType::SimplexID<1>>(ring.begin(),
+                                                        ring.end()),
+                expected);
+    }
+  }
+
+  auto e = mesh.get_simplex_up({0, 1});
+  std::set<SurfaceMeshType::SimplexID<2>> expected;
+  std::vector<SurfaceMeshType::SimplexID<2>> edges;
+  casc::kneighbors(mesh, e, 3, expected);
+  casc::kneighbors(mesh, e, 3, edges);
+  EXPECT_EQ(std::set<SurfaceMeshType::SimplexID<2>>(edges.begin(),
+                                                    edges.end()),
+            expected);
+}
+
+TEST_F(CASCTraversalTest, VisitedSet) {
+  casc::visited_set<SurfaceMeshType::SimplexID<1>> seen;
+  auto v = mesh.get_simplex_up({0});
+  auto w = mesh.get_simplex_up({1});
+  EXPECT_EQ(seen.count(v), 0);
+  EXPECT_TRUE(seen.insert(v));
+  EXPECT_FALSE(seen.insert(v));
+  EXPECT_EQ(seen.count(v), 1);
+  EXPECT_EQ(seen.count(w), 0);
+  {
+    // Nested sets are independent
+    casc::visited_set<SurfaceMeshType::SimplexID<1>> inner;
+    EXPECT_TRUE(inner.insert(v));
+    EXPECT_TRUE(inner.insert(w));
+  }
+  EXPECT_EQ(seen.count(w), 0);
+  seen.clear();
+  EXPECT_EQ(seen.count(v), 0);
+  EXPECT_TRUE(seen.insert(w));
+
+  std::size_t n = 0;
+  for (auto s : mesh.get_level_id<1>()) {
+    n += seen.insert(s);
+  }
+  EXPECT_EQ(n, mesh.size<1>() - 1);
+}
+
+/// Stand-in for a SimplexID of a large complex.
+struct SparseID {
+  std::size_t i;
+  std::size_t index() const { return i; }
+};
+
+TEST(VisitedSetTest, SparseToDense) {
+  const std::size_t stride = 1000003;
+  casc::visited_set<SparseID> seen;
+  for (std::size_t k = 0; k < 100; ++k) {
+    EXPECT_TRUE(seen.insert(SparseID{k * stride}));
+  }
+  for (std::size_t k = 0; k < 100; ++k) {
+    EXPECT_EQ(seen.count(SparseID{k * stride}), 1);
+    EXPECT_EQ(seen.count(SparseID{k * stride + 1}), 0);
+    EXPECT_FALSE(seen.insert(SparseID{k * stride}));
+  }
+  seen.clear();
+  EXPECT_EQ(seen.count(SparseID{stride}), 0);
+
+  // Past the sparse limit the set moves its entries to the stamp array
+  const std::size_t n = 3000, base = 1 << 20;
+  for (std::size_t k = 0; k < n; ++k) {
+    EXPECT_TRUE(seen.insert(SparseID{base + 3 * k}));
+  }
+  std::size_t hits = 0;
+  for (std::size_t k = 0; k < 3 * n; ++k) {
+    hits += seen.count(SparseID{base + k});
+  }
+  EXPECT_EQ(hits, n);
+  seen.clear();
+  EXPECT_EQ(seen.count(SparseID{base}), 0);
+  EXPECT_TRUE(seen.insert(SparseID{base}));
+}
+
+TEST(VisitedSetTest, ClearReturnsToSparse) {
+  // An index the stamp array could never hold
+  const std::size_t huge = std::numeric_limits<std::size_t>::max() / 2;
+  {
+    casc::visited_set<SparseID> seen;
+    for (std::size_t k = 0; k < 3000; ++k) {
+      seen.insert(SparseID{k});
+    }
+  }
+  // The dense buffer returned to the pool starts sparse
+  casc::visited_set<SparseID> next;
+  EXPECT_EQ(next.count(SparseID{1}), 0);
+  EXPECT_TRUE(next.insert(SparseID{huge}));
+  EXPECT_FALSE(next.insert(SparseID{huge}));
+
+  // So does a set cleared after going dense
+  next.clear();
+  for (std::size_t k = 0; k < 3000; ++k) {
+    next.insert(SparseID{k});
+  }
+  next.clear();
+  EXPECT_TRUE(next.insert(SparseID{huge}));
+  EXPECT_EQ(next.count(SparseID{huge}), 1);
+  EXPECT_EQ(next.count(SparseID{0}), 0);
+}
+
+/// Record visited simplices of every dimension, safe to call concurrently.
+struct RecordingVisitor {
+  std::mutex lock;
+  std::set<std::vector<int>> seen;
+  std::size_t visits = 0;
+
+  template <std::size_t k>
+  bool visit(SurfaceMeshType &F, SurfaceMeshType::SimplexID<k> s) {
+    auto name = F.get_name(s);
+    std::lock_guard<std::mutex> guard(lock);
+    seen.insert(std::vector<int>(name.begin(), name.end()));
+    ++visits;
+    return true;
+  }
+};
+
+TEST_F(CASCTraversalTest, ParallelTraversals) {
+  casc::parallel::set_num_threads(4);
+  std::atomic<std::size_t> count(0);
+  casc::parallel_for_each<1>(
+      mesh,
+      [&](SurfaceMeshType::SimplexID<1> v) {
+        *v = 2 * mesh.get_name(v)[0];
+        ++count;
+      },
+      7);
+  EXPECT_EQ(count, mesh.size<1>());
+  for (auto v : mesh.get_level_id<1>()) {
+    EXPECT_EQ(*v, 2 * mesh.get_name(v)[0]);
+  }
+
+  // Removed simplices leave slots which are skipped
+  mesh.remove({0, 1, 2});
+  count = 0;
+  casc::parallel_for_each<3>(
+      mesh, [&](SurfaceMeshType::SimplexID<3>) { ++count; }, 1);
+  EXPECT_EQ(count, mesh.size<3>());
+
+  RecordingVisitor sequential, parallel;
+  auto v = mesh.get_simplex_up({0});
+  casc::visit_BFS_up(sequential, mesh, v);
+  casc::parallel_visit_BFS_up(parallel, mesh, v, 2);
+  EXPECT_EQ(parallel.seen, sequential.seen);
+  EXPECT_EQ(parallel.visits, sequential.visits);
+
+  RecordingVisitor sequentialDown, parallelDown;
+  auto f = mesh.get_simplex_up({0, 2, 3});
+  casc::visit_BFS_down(sequentialDown, mesh, f);
+  casc::parallel_visit_BFS_down(parallelDown, mesh, f, 1);
+  EXPECT_EQ(parallelDown.seen, sequentialDown.seen);
+  EXPECT_EQ(parallelDown.visits, 7);
+
+  RecordingVisitor all;
+  casc::parallel_visit_BFS_up(all, mesh, mesh.get_simplex_up());
+  EXPECT_EQ(all.visits, 1 + mesh.size<1>() + mesh.size<2>() + mesh.size<3>());
+  casc::parallel::set_num_threads(0);
+}
+
+TEST_F(CASCTraversalTest, kNeighborsBatch) {
+  std::vector<SurfaceMeshType::SimplexID<1>> verts;
+  for (auto v : mesh.get_level_id<1>()) {
+    verts.push_back(v);
+  }
+  casc::parallel::set_num_threads(3);
+  casc::neighbor_lists<SurfaceMeshType::SimplexID<1>> rings;
+  casc::kneighbors_up_batch(mesh, verts, 2, rings);
+  ASSERT_EQ(rings.size(), verts.size());
+  EXPECT_EQ(rings.offsets.back(), rings.ids.size());
+  std::vector<SurfaceMeshType::SimplexID<1>> expected;
+  for (std::size_t i = 0; i < verts.size(); ++i) {
+    casc::kneighbors_up(mesh, verts[i], 2, expected);
+    std::vector<SurfaceMeshType::SimplexID<1>> got(rings[i].begin(),
+                                                   rings[i].end());
+    EXPECT_EQ(got, expected);
+  }
+
+  std::vector<SurfaceMeshType::SimplexID<2>> edges;
+  for (auto e : mesh.get_level_id<2>()) {
+    edges.push_back(e);
+  }
+  casc::neighbor_lists<SurfaceMeshType::SimplexID<2>> edgeRings;
+  casc::kneighbors_batch(mesh, edges, 3, edgeRings);
+  ASSERT_EQ(edgeRings.size(), edges.size());
+  std::vector<SurfaceMeshType::SimplexID<2>> expectedEdges;
+  for (std::size_t i = 0; i < edges.size(); ++i) {
+    casc::kneighbors(mesh, edges[i], 3, expectedEdges);
+    EXPECT_TRUE(std::equal(edgeRings[i].begin(), edgeRings[i].end(),
+                           expectedEdges.begin(), expectedEdges.end()));
+  }
+
+  // Reusing the output resets it
+  casc::kneighbors_up_batch(mesh, {verts[0]}, 0, rings);
+  EXPECT_EQ(rings.size(), 1);
+  EXPECT_EQ(rings.ids.size(), 0);
+  casc::parallel::set_num_threads(0);
+}